@@ -0,0 +1,13 @@
+dnl Rozszerzenie geoconverter - natywna klasa UtmConverter (src/UtmConverter.php)
+
+PHP_ARG_ENABLE([geoconverter],
+  [whether to enable geoconverter support],
+  [AS_HELP_STRING([--enable-geoconverter], [Enable native UtmConverter class])],
+  [no])
+
+if test "$PHP_GEOCONVERTER" != "no"; then
+  PHP_REQUIRE_CXX()
+  PHP_ADD_LIBRARY(stdc++, 1, GEOCONVERTER_SHARED_LIBADD)
+  PHP_SUBST(GEOCONVERTER_SHARED_LIBADD)
+  PHP_NEW_EXTENSION(geoconverter, geoconverter.cpp, $ext_shared,, [-DZEND_ENABLE_STATIC_TSRMLS_CACHE=1], cxx)
+fi
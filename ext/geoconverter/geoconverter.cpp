@@ -0,0 +1,717 @@
+/*
+Rozszerzenie PHP geoconverter - natywna klasa UtmConverter
+
+Klasa ma te same metody publiczne co UtmConverter z src/UtmConverter.php (parametry, przekazywanie
+przez referencję, wartości zwracane, także liczba całkowita 999999999999999 poza zakresem 1992/2000).
+Rozszerzenie definiuje też stałe DEG2RAD i RAD2DEG o wartościach z UtmConverter.php. Gdy jest
+załadowane, src/UtmConverter.php nie deklaruje klasy, więc dotychczasowy kod korzysta z wersji natywnej
+bez zmian.
+
+Obliczenia wykonuje biblioteka C++ (src/orig-c): konteksty odwzorowań (ProjectionContext) i funkcje
+wsadowe z jądrami wektorowymi AVX2 / AVX-512. Biblioteka jest tu kompilowana ze stałymi przeliczenia
+stopni i radianów klasy PHP (deg2rad = DEG2RAD = 0.01745329, rad2deg = RAD2DEG = 57.29577951), więc
+metody pojedyncze i wsadowe liczą jak UtmConverter.php: różnice zaokrągleń (potęgi, kolejność działań)
+wynoszą ok. 1e-8 m i 1e-13 stopnia (sprawdzenie: verify.php z niezmienioną klasą PHP). Na granicach
+pasów 2000 (długość 25.5, easting dokładnie 5000000 ... 9000000) pas wybierany jest jak w bibliotece
+(klasa PHP nie przypisuje wtedy żadnego pasa).
+
+Metody wsadowe (*Batch) przyjmują tablice współrzędnych i wykonują całą konwersję jednym wywołaniem
+funkcji wsadowej biblioteki:
+  LatLonToUtmBatch ($a, $f, &$utmXZone, &$utmYZone, &$easting, &$northing, array $lat, array $lon)
+  LatLonToPUWGBatch ($a, $f, &$easting, &$northing, array $lat, array $lon, $proj)
+  LatLonToUtmWGS84Batch (&$utmXZone, &$utmYZone, &$easting, &$northing, array $lat, array $lon)
+  LatLonToPUWGWGS84Batch (&$easting, &$northing, array $lat, array $lon, $proj)
+  UtmToLatLonWGS84Batch (array $utmXZone, array $utmYZone, array $easting, array $northing, &$lat, &$lon)
+  PUWGToLatLonWGS84Batch (array $easting, array $northing, $proj, &$lat, &$lon)
+Elementy i-te tablic wejściowych (w kolejności tablic, klucze są pomijane) tworzą i-ty punkt; wyniki są
+listami indeksowanymi od 0 o wartościach takich jak z metody pojedynczej. Wynik metody: liczba punktów,
+false (z ostrzeżeniem), gdy tablice wejściowe mają różną liczbę elementów.
+
+Współrzędne, a, f i numer strefy są konwertowane jak w działaniach arytmetycznych metod klasy PHP
+(PhpDouble): null, bool i ciągi liczbowe bez komunikatu, ciąg nieliczbowy z ostrzeżeniem (PHP 7)
+lub wyjątkiem TypeError (PHP 8); elementy tablic wejściowych - tak samo. Zakres długości 1992/2000
+sprawdzany jest porównaniem PHP na wartości przekazanej do metody, jak w LatLonToPUWG klasy PHP.
+
+Kompilacja (z katalogu ext/geoconverter):
+  phpize && ./configure --enable-geoconverter && make && make install
+*/
+//---------------------------------------------------------------------------
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+extern "C" {
+#include "php.h"
+#include "ext/standard/info.h"
+}
+#include <math.h>
+#include <vector>
+#include "php_geoconverter.h"
+
+//Przeliczenie stopni i radianów w bibliotece - stałe DEG2RAD i RAD2DEG z UtmConverter.php
+static const double deg2rad = 0.01745329;
+static const double rad2deg = 57.29577951;
+#include "../../src/orig-c/UTM_1992_2000_Batch.h"
+
+#ifndef CONST_CS
+#define CONST_CS 0
+#endif
+
+//Wartość zwracana przez LatLonToPUWG dla długości poza zakresem 13.5..25.5 stopnia (w PHP liczba całkowita)
+static const zend_long puwgOutOfRange = 999999999999999LL;
+
+static zend_class_entry* utmConverterCe;
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//Odwzorowanie 1992, gdy $proj == 1 (porównanie luźne jak w UtmConverter.php)
+static bool IsPUWG1992 (zval* proj)
+{
+	zval one;
+	ZVAL_LONG (&one, 1);
+	return fast_equal_check_function (proj, &one);
+}
+
+//Kontekst odwzorowania 1992 lub 2000 dla WGS 84
+static const ProjectionContext& PUWGContextWGS84 (bool puwg1992)
+{
+	return WGS84Context (puwg1992 ? projPUWG1992 : projPUWG2000);
+}
+
+//Porównanie strefy równoleżnikowej z literą jak operator <=> w PHP
+static int CompareBand (zval* band, char letter)
+{
+	ZVAL_DEREF (band);
+	// Litera strefy nie jest liczbą, więc dwa ciągi porównywane są zawsze jako ciągi znaków
+	if(Z_TYPE_P (band) == IS_STRING)
+	  {
+	   int cmp = zend_binary_strcmp (Z_STRVAL_P (band), Z_STRLEN_P (band), &letter, 1);
+	   return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+	  }
+	zval l, result;
+	ZVAL_STRINGL (&l, &letter, 1);
+	compare_function (&result, band, &l);
+	zval_ptr_dtor (&l);
+	return (int)Z_LVAL (result);
+}
+
+//Strefa równoleżnikowa dla biblioteki: 'M' na półkuli południowej (strefa C..M lub c..m, warunek
+//z UtmConverter::UtmToLatLon), 'N' na północnej
+static char LibraryBand (zval* band)
+{
+	bool south = (CompareBand (band, 'M') <= 0 && CompareBand (band, 'C') >= 0)
+		|| (CompareBand (band, 'm') <= 0 && CompareBand (band, 'c') >= 0);
+	return south ? 'M' : 'N';
+}
+
+//Strefa równoleżnikowa jako jednoznakowy ciąg PHP
+static void ZoneLetter (zval* zv, char c)
+{
+#if PHP_VERSION_ID >= 80000
+	ZVAL_CHAR (zv, c);
+#else
+	ZVAL_STRINGL (zv, &c, 1);
+#endif
+}
+
+//Współrzędna 1992/2000 jako wartość PHP - poza zakresem liczba całkowita jak w UtmConverter.php
+static void PUWGValue (zval* zv, bool inRange, double v)
+{
+	if(inRange) ZVAL_DOUBLE (zv, v);
+	else ZVAL_LONG (zv, puwgOutOfRange);
+}
+
+//=======================================================================
+//  Wartość PHP jako liczba rzeczywista, jak w działaniach arytmetycznych UtmConverter.php
+//=======================================================================
+//      Wartość mnożona jest przez 1.0 (mul_function), więc komunikaty są takie jak dla $lat * DEG2RAD
+//      w klasie PHP: ciąg z liczbą na początku - ostrzeżenie, ciąg nieliczbowy - ostrzeżenie i 0
+//      (PHP 7) lub TypeError (PHP 8), tablica - wyjątek. Wynik false, gdy zgłoszono wyjątek.
+//=======================================================================
+static bool PhpDouble (zval* zv, double& d)
+{
+	zval one, result;
+	ZVAL_DOUBLE (&one, 1.0);
+	ZVAL_DEREF (zv);
+	if(mul_function (&result, zv, &one) == FAILURE || EG (exception)) return false;
+	d = zval_get_double (&result);
+	zval_ptr_dtor (&result);
+	return true;
+}
+
+//Porównanie wartości PHP z liczbą jak operator <=> (np. $lon < 13.5 w klasie PHP)
+static int PhpCompare (zval* zv, double v)
+{
+	zval d, result;
+	ZVAL_DOUBLE (&d, v);
+	ZVAL_DEREF (zv);
+	compare_function (&result, zv, &d);
+	return (int)Z_LVAL (result);
+}
+
+//Wartości tablicy PHP jako liczby rzeczywiste (PhpDouble); false po wyjątku
+static bool ArrayDoubles (HashTable* ht, std::vector<double>& out)
+{
+	zval* zv;
+	out.clear ();
+	out.reserve (zend_hash_num_elements (ht));
+	ZEND_HASH_FOREACH_VAL (ht, zv)
+	   double d;
+	   if(!PhpDouble (zv, d)) return false;
+	   out.push_back (d);
+	ZEND_HASH_FOREACH_END ();
+	return true;
+}
+
+//Liczba elementów wspólna dla wszystkich tablic wejściowych; -1 i ostrzeżenie, gdy liczby są różne
+static zend_long BatchCount (HashTable** ht, int n)
+{
+	uint32_t count = zend_hash_num_elements (ht[0]);
+	for(int i = 1; i < n; i++)
+	  {
+	   if(zend_hash_num_elements (ht[i]) != count)
+	     {
+	      php_error_docref (NULL, E_WARNING, "Input arrays must have the same number of elements");
+	      return -1;
+	     }
+	  }
+	return count;
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Konwersje wspólne dla metod dowolnej elipsoidy i WGS 84
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+static void LatLonToUtmZval (const ProjectionContext& ctx, zval* utmXZone, zval* utmYZone, zval* easting, zval* northing, double lat, double lon)
+{
+	int zone;
+	char band;
+	double e, n;
+	LatLonToUtm (ctx, zone, band, e, n, lat, lon);
+	zval letter;
+	ZoneLetter (&letter, band);
+	ZEND_TRY_ASSIGN_REF_LONG (utmXZone, zone);
+	ZEND_TRY_ASSIGN_REF_TMP (utmYZone, &letter);
+	ZEND_TRY_ASSIGN_REF_DOUBLE (easting, e);
+	ZEND_TRY_ASSIGN_REF_DOUBLE (northing, n);
+}
+
+//Poza zakresem długości 13.5..25.5 liczby całkowite bez konwersji współrzędnych, jak w klasie PHP
+static void LatLonToPUWGZval (const ProjectionContext& ctx, zval* easting, zval* northing, zval* lat, zval* lon)
+{
+	zval ze, zn;
+	if(PhpCompare (lon, 13.5) < 0 || PhpCompare (lon, 25.5) > 0)
+	  {
+	   PUWGValue (&ze, false, 0.0);
+	   PUWGValue (&zn, false, 0.0);
+	  }
+	else
+	  {
+	   double la, lo, e, n;
+	   if(!PhpDouble (lat, la) || !PhpDouble (lon, lo)) return;
+	   LatLonToPUWG (ctx, e, n, la, lo);
+	   PUWGValue (&ze, true, e);
+	   PUWGValue (&zn, true, n);
+	  }
+	ZEND_TRY_ASSIGN_REF_TMP (easting, &ze);
+	ZEND_TRY_ASSIGN_REF_TMP (northing, &zn);
+}
+
+//Konwersja tablic lat/lon jednym wywołaniem LatLonToUtmBatch
+static void LatLonToUtmArrays (const ProjectionContext& ctx, zval* utmXZone, zval* utmYZone, zval* easting, zval* northing,
+	const std::vector<double>& lat, const std::vector<double>& lon)
+{
+	size_t count = lat.size ();
+	std::vector<int> zone (count);
+	std::vector<char> band (count);
+	std::vector<double> e (count), n (count);
+	if(count) LatLonToUtmBatch (ctx, &zone[0], &band[0], &e[0], &n[0], &lat[0], &lon[0], count);
+	zval zones, bands, es, ns;
+	array_init_size (&zones, (uint32_t)count);
+	array_init_size (&bands, (uint32_t)count);
+	array_init_size (&es, (uint32_t)count);
+	array_init_size (&ns, (uint32_t)count);
+	for(size_t i = 0; i < count; i++)
+	  {
+	   zval letter;
+	   ZoneLetter (&letter, band[i]);
+	   add_next_index_long (&zones, zone[i]);
+	   add_next_index_zval (&bands, &letter);
+	   add_next_index_double (&es, e[i]);
+	   add_next_index_double (&ns, n[i]);
+	  }
+	ZEND_TRY_ASSIGN_REF_TMP (utmXZone, &zones);
+	ZEND_TRY_ASSIGN_REF_TMP (utmYZone, &bands);
+	ZEND_TRY_ASSIGN_REF_TMP (easting, &es);
+	ZEND_TRY_ASSIGN_REF_TMP (northing, &ns);
+}
+
+//Konwersja tablic lat/lon jednym wywołaniem LatLonToPUWGBatch
+static void LatLonToPUWGArrays (const ProjectionContext& ctx, zval* easting, zval* northing, const std::vector<double>& lat,
+	const std::vector<double>& lon)
+{
+	size_t count = lat.size ();
+	std::vector<double> e (count), n (count);
+	std::vector<unsigned char> status (count);
+	if(count) LatLonToPUWGBatch (ctx, &e[0], &n[0], &lat[0], &lon[0], count, &status[0]);
+	zval es, ns;
+	array_init_size (&es, (uint32_t)count);
+	array_init_size (&ns, (uint32_t)count);
+	for(size_t i = 0; i < count; i++)
+	  {
+	   zval ze, zn;
+	   PUWGValue (&ze, status[i] == statusOK, e[i]);
+	   PUWGValue (&zn, status[i] == statusOK, n[i]);
+	   add_next_index_zval (&es, &ze);
+	   add_next_index_zval (&ns, &zn);
+	  }
+	ZEND_TRY_ASSIGN_REF_TMP (easting, &es);
+	ZEND_TRY_ASSIGN_REF_TMP (northing, &ns);
+}
+
+//Tablice lat/lon wyniku konwersji odwrotnej
+static void LatLonArrays (zval* lat, zval* lon, const std::vector<double>& la, const std::vector<double>& lo)
+{
+	zval las, los;
+	array_init_size (&las, (uint32_t)la.size ());
+	array_init_size (&los, (uint32_t)lo.size ());
+	for(size_t i = 0; i < la.size (); i++)
+	  {
+	   add_next_index_double (&las, la[i]);
+	   add_next_index_double (&los, lo[i]);
+	  }
+	ZEND_TRY_ASSIGN_REF_TMP (lat, &las);
+	ZEND_TRY_ASSIGN_REF_TMP (lon, &los);
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Metody klasy UtmConverter
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+PHP_METHOD (UtmConverter, LatLonToUtm)
+{
+	double a, f, lat, lon;
+	zval *za, *zf, *utmXZone, *utmYZone, *easting, *northing, *zlat, *zlon;
+	ZEND_PARSE_PARAMETERS_START (8, 8)
+	   Z_PARAM_ZVAL (za)
+	   Z_PARAM_ZVAL (zf)
+	   Z_PARAM_ZVAL (utmXZone)
+	   Z_PARAM_ZVAL (utmYZone)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ZVAL (zlat)
+	   Z_PARAM_ZVAL (zlon)
+	ZEND_PARSE_PARAMETERS_END ();
+	if(!PhpDouble (za, a) || !PhpDouble (zf, f) || !PhpDouble (zlat, lat) || !PhpDouble (zlon, lon)) return;
+	LatLonToUtmZval (CreateProjectionContext (a, f, projUTM), utmXZone, utmYZone, easting, northing, lat, lon);
+}
+
+PHP_METHOD (UtmConverter, LatLonToPUWG)
+{
+	double a, f;
+	zval *za, *zf, *easting, *northing, *lat, *lon, *proj;
+	ZEND_PARSE_PARAMETERS_START (7, 7)
+	   Z_PARAM_ZVAL (za)
+	   Z_PARAM_ZVAL (zf)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ZVAL (lat)
+	   Z_PARAM_ZVAL (lon)
+	   Z_PARAM_ZVAL (proj)
+	ZEND_PARSE_PARAMETERS_END ();
+	if(!PhpDouble (za, a) || !PhpDouble (zf, f)) return;
+	ProjectionContext ctx = CreateProjectionContext (a, f, IsPUWG1992 (proj) ? projPUWG1992 : projPUWG2000);
+	LatLonToPUWGZval (ctx, easting, northing, lat, lon);
+}
+
+PHP_METHOD (UtmConverter, LatLonToUtmWGS84)
+{
+	double lat, lon;
+	zval *utmXZone, *utmYZone, *easting, *northing, *zlat, *zlon;
+	ZEND_PARSE_PARAMETERS_START (6, 6)
+	   Z_PARAM_ZVAL (utmXZone)
+	   Z_PARAM_ZVAL (utmYZone)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ZVAL (zlat)
+	   Z_PARAM_ZVAL (zlon)
+	ZEND_PARSE_PARAMETERS_END ();
+	if(!PhpDouble (zlat, lat) || !PhpDouble (zlon, lon)) return;
+	LatLonToUtmZval (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon);
+}
+
+PHP_METHOD (UtmConverter, LatLonToPUWGWGS84)
+{
+	zval *easting, *northing, *lat, *lon, *proj;
+	ZEND_PARSE_PARAMETERS_START (5, 5)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ZVAL (lat)
+	   Z_PARAM_ZVAL (lon)
+	   Z_PARAM_ZVAL (proj)
+	ZEND_PARSE_PARAMETERS_END ();
+	LatLonToPUWGZval (PUWGContextWGS84 (IsPUWG1992 (proj)), easting, northing, lat, lon);
+}
+
+PHP_METHOD (UtmConverter, UtmToLatLonWGS84)
+{
+	double zone, easting, northing;
+	zval *zzone, *utmYZone, *zeasting, *znorthing, *lat, *lon;
+	ZEND_PARSE_PARAMETERS_START (6, 6)
+	   Z_PARAM_ZVAL (zzone)
+	   Z_PARAM_ZVAL (utmYZone)
+	   Z_PARAM_ZVAL (zeasting)
+	   Z_PARAM_ZVAL (znorthing)
+	   Z_PARAM_ZVAL (lat)
+	   Z_PARAM_ZVAL (lon)
+	ZEND_PARSE_PARAMETERS_END ();
+	if(!PhpDouble (zzone, zone) || !PhpDouble (zeasting, easting) || !PhpDouble (znorthing, northing)) return;
+	double la, lo;
+	UtmToLatLon (WGS84Context (projUTM), (int)zone, LibraryBand (utmYZone), easting, northing, la, lo);
+	ZEND_TRY_ASSIGN_REF_DOUBLE (lat, la);
+	ZEND_TRY_ASSIGN_REF_DOUBLE (lon, lo);
+}
+
+PHP_METHOD (UtmConverter, PUWGToLatLonWGS84)
+{
+	double easting, northing;
+	zval *zeasting, *znorthing, *proj, *lat, *lon;
+	ZEND_PARSE_PARAMETERS_START (5, 5)
+	   Z_PARAM_ZVAL (zeasting)
+	   Z_PARAM_ZVAL (znorthing)
+	   Z_PARAM_ZVAL (proj)
+	   Z_PARAM_ZVAL (lat)
+	   Z_PARAM_ZVAL (lon)
+	ZEND_PARSE_PARAMETERS_END ();
+	if(!PhpDouble (zeasting, easting) || !PhpDouble (znorthing, northing)) return;
+	double la, lo;
+	PUWGToLatLon (PUWGContextWGS84 (IsPUWG1992 (proj)), easting, northing, la, lo);
+	ZEND_TRY_ASSIGN_REF_DOUBLE (lat, la);
+	ZEND_TRY_ASSIGN_REF_DOUBLE (lon, lo);
+}
+
+PHP_METHOD (UtmConverter, LatLonToUtmBatch)
+{
+	double a, f;
+	zval *za, *zf, *utmXZone, *utmYZone, *easting, *northing;
+	HashTable* in[2];
+	ZEND_PARSE_PARAMETERS_START (8, 8)
+	   Z_PARAM_ZVAL (za)
+	   Z_PARAM_ZVAL (zf)
+	   Z_PARAM_ZVAL (utmXZone)
+	   Z_PARAM_ZVAL (utmYZone)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ARRAY_HT (in[0])
+	   Z_PARAM_ARRAY_HT (in[1])
+	ZEND_PARSE_PARAMETERS_END ();
+	zend_long count = BatchCount (in, 2);
+	if(count < 0) RETURN_FALSE;
+	std::vector<double> lat, lon;
+	if(!PhpDouble (za, a) || !PhpDouble (zf, f) || !ArrayDoubles (in[0], lat) || !ArrayDoubles (in[1], lon)) return;
+	LatLonToUtmArrays (CreateProjectionContext (a, f, projUTM), utmXZone, utmYZone, easting, northing, lat, lon);
+	RETURN_LONG (count);
+}
+
+PHP_METHOD (UtmConverter, LatLonToPUWGBatch)
+{
+	double a, f;
+	zval *za, *zf, *easting, *northing, *proj;
+	HashTable* in[2];
+	ZEND_PARSE_PARAMETERS_START (7, 7)
+	   Z_PARAM_ZVAL (za)
+	   Z_PARAM_ZVAL (zf)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ARRAY_HT (in[0])
+	   Z_PARAM_ARRAY_HT (in[1])
+	   Z_PARAM_ZVAL (proj)
+	ZEND_PARSE_PARAMETERS_END ();
+	zend_long count = BatchCount (in, 2);
+	if(count < 0) RETURN_FALSE;
+	std::vector<double> lat, lon;
+	if(!PhpDouble (za, a) || !PhpDouble (zf, f) || !ArrayDoubles (in[0], lat) || !ArrayDoubles (in[1], lon)) return;
+	ProjectionContext ctx = CreateProjectionContext (a, f, IsPUWG1992 (proj) ? projPUWG1992 : projPUWG2000);
+	LatLonToPUWGArrays (ctx, easting, northing, lat, lon);
+	RETURN_LONG (count);
+}
+
+PHP_METHOD (UtmConverter, LatLonToUtmWGS84Batch)
+{
+	zval *utmXZone, *utmYZone, *easting, *northing;
+	HashTable* in[2];
+	ZEND_PARSE_PARAMETERS_START (6, 6)
+	   Z_PARAM_ZVAL (utmXZone)
+	   Z_PARAM_ZVAL (utmYZone)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ARRAY_HT (in[0])
+	   Z_PARAM_ARRAY_HT (in[1])
+	ZEND_PARSE_PARAMETERS_END ();
+	zend_long count = BatchCount (in, 2);
+	if(count < 0) RETURN_FALSE;
+	std::vector<double> lat, lon;
+	if(!ArrayDoubles (in[0], lat) || !ArrayDoubles (in[1], lon)) return;
+	LatLonToUtmArrays (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon);
+	RETURN_LONG (count);
+}
+
+PHP_METHOD (UtmConverter, LatLonToPUWGWGS84Batch)
+{
+	zval *easting, *northing, *proj;
+	HashTable* in[2];
+	ZEND_PARSE_PARAMETERS_START (5, 5)
+	   Z_PARAM_ZVAL (easting)
+	   Z_PARAM_ZVAL (northing)
+	   Z_PARAM_ARRAY_HT (in[0])
+	   Z_PARAM_ARRAY_HT (in[1])
+	   Z_PARAM_ZVAL (proj)
+	ZEND_PARSE_PARAMETERS_END ();
+	zend_long count = BatchCount (in, 2);
+	if(count < 0) RETURN_FALSE;
+	std::vector<double> lat, lon;
+	if(!ArrayDoubles (in[0], lat) || !ArrayDoubles (in[1], lon)) return;
+	LatLonToPUWGArrays (PUWGContextWGS84 (IsPUWG1992 (proj)), easting, northing, lat, lon);
+	RETURN_LONG (count);
+}
+
+PHP_METHOD (UtmConverter, UtmToLatLonWGS84Batch)
+{
+	zval *lat, *lon;
+	HashTable* in[4];
+	ZEND_PARSE_PARAMETERS_START (6, 6)
+	   Z_PARAM_ARRAY_HT (in[0])
+	   Z_PARAM_ARRAY_HT (in[1])
+	   Z_PARAM_ARRAY_HT (in[2])
+	   Z_PARAM_ARRAY_HT (in[3])
+	   Z_PARAM_ZVAL (lat)
+	   Z_PARAM_ZVAL (lon)
+	ZEND_PARSE_PARAMETERS_END ();
+	zend_long count = BatchCount (in, 4);
+	if(count < 0) RETURN_FALSE;
+	std::vector<double> zones, es, ns;
+	if(!ArrayDoubles (in[0], zones) || !ArrayDoubles (in[2], es) || !ArrayDoubles (in[3], ns)) return;
+	std::vector<int> zone (count);
+	std::vector<char> band;
+	for(zend_long i = 0; i < count; i++) zone[i] = (int)zones[i];
+	band.reserve (count);
+	zval* zv;
+	ZEND_HASH_FOREACH_VAL (in[1], zv)
+	   band.push_back (LibraryBand (zv));
+	ZEND_HASH_FOREACH_END ();
+	std::vector<double> la (count), lo (count);
+	if(count) UtmToLatLonBatch (WGS84Context (projUTM), &zone[0], &band[0], &es[0], &ns[0], &la[0], &lo[0], count);
+	LatLonArrays (lat, lon, la, lo);
+	RETURN_LONG (count);
+}
+
+PHP_METHOD (UtmConverter, PUWGToLatLonWGS84Batch)
+{
+	zval *proj, *lat, *lon;
+	HashTable* in[2];
+	ZEND_PARSE_PARAMETERS_START (5, 5)
+	   Z_PARAM_ARRAY_HT (in[0])
+	   Z_PARAM_ARRAY_HT (in[1])
+	   Z_PARAM_ZVAL (proj)
+	   Z_PARAM_ZVAL (lat)
+	   Z_PARAM_ZVAL (lon)
+	ZEND_PARSE_PARAMETERS_END ();
+	zend_long count = BatchCount (in, 2);
+	if(count < 0) RETURN_FALSE;
+	std::vector<double> es, ns;
+	if(!ArrayDoubles (in[0], es) || !ArrayDoubles (in[1], ns)) return;
+	std::vector<double> la (count), lo (count);
+	if(count) PUWGToLatLonBatch (PUWGContextWGS84 (IsPUWG1992 (proj)), &es[0], &ns[0], &la[0], &lo[0], count);
+	LatLonArrays (lat, lon, la, lo);
+	RETURN_LONG (count);
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Opis parametrów metod
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToUtm, 0, 0, 8)
+	ZEND_ARG_INFO (0, a)
+	ZEND_ARG_INFO (0, f)
+	ZEND_ARG_INFO (1, utmXZone)
+	ZEND_ARG_INFO (1, utmYZone)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_INFO (0, lat)
+	ZEND_ARG_INFO (0, lon)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToPUWG, 0, 0, 7)
+	ZEND_ARG_INFO (0, a)
+	ZEND_ARG_INFO (0, f)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_INFO (0, lat)
+	ZEND_ARG_INFO (0, lon)
+	ZEND_ARG_INFO (0, proj)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToUtmWGS84, 0, 0, 6)
+	ZEND_ARG_INFO (1, utmXZone)
+	ZEND_ARG_INFO (1, utmYZone)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_INFO (0, lat)
+	ZEND_ARG_INFO (0, lon)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToPUWGWGS84, 0, 0, 5)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_INFO (0, lat)
+	ZEND_ARG_INFO (0, lon)
+	ZEND_ARG_INFO (0, proj)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_UtmToLatLonWGS84, 0, 0, 6)
+	ZEND_ARG_INFO (0, utmXZone)
+	ZEND_ARG_INFO (0, utmYZone)
+	ZEND_ARG_INFO (0, easting)
+	ZEND_ARG_INFO (0, northing)
+	ZEND_ARG_INFO (1, lat)
+	ZEND_ARG_INFO (1, lon)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_PUWGToLatLonWGS84, 0, 0, 5)
+	ZEND_ARG_INFO (0, easting)
+	ZEND_ARG_INFO (0, northing)
+	ZEND_ARG_INFO (0, proj)
+	ZEND_ARG_INFO (1, lat)
+	ZEND_ARG_INFO (1, lon)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToUtmBatch, 0, 0, 8)
+	ZEND_ARG_INFO (0, a)
+	ZEND_ARG_INFO (0, f)
+	ZEND_ARG_INFO (1, utmXZone)
+	ZEND_ARG_INFO (1, utmYZone)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_TYPE_INFO (0, lat, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, lon, IS_ARRAY, 0)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToPUWGBatch, 0, 0, 7)
+	ZEND_ARG_INFO (0, a)
+	ZEND_ARG_INFO (0, f)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_TYPE_INFO (0, lat, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, lon, IS_ARRAY, 0)
+	ZEND_ARG_INFO (0, proj)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToUtmWGS84Batch, 0, 0, 6)
+	ZEND_ARG_INFO (1, utmXZone)
+	ZEND_ARG_INFO (1, utmYZone)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_TYPE_INFO (0, lat, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, lon, IS_ARRAY, 0)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_LatLonToPUWGWGS84Batch, 0, 0, 5)
+	ZEND_ARG_INFO (1, easting)
+	ZEND_ARG_INFO (1, northing)
+	ZEND_ARG_TYPE_INFO (0, lat, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, lon, IS_ARRAY, 0)
+	ZEND_ARG_INFO (0, proj)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_UtmToLatLonWGS84Batch, 0, 0, 6)
+	ZEND_ARG_TYPE_INFO (0, utmXZone, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, utmYZone, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, easting, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, northing, IS_ARRAY, 0)
+	ZEND_ARG_INFO (1, lat)
+	ZEND_ARG_INFO (1, lon)
+ZEND_END_ARG_INFO ()
+
+ZEND_BEGIN_ARG_INFO_EX (arginfo_PUWGToLatLonWGS84Batch, 0, 0, 5)
+	ZEND_ARG_TYPE_INFO (0, easting, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO (0, northing, IS_ARRAY, 0)
+	ZEND_ARG_INFO (0, proj)
+	ZEND_ARG_INFO (1, lat)
+	ZEND_ARG_INFO (1, lon)
+ZEND_END_ARG_INFO ()
+
+static const zend_function_entry utmConverterMethods[] =
+{
+	PHP_ME (UtmConverter, LatLonToUtm, arginfo_LatLonToUtm, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, LatLonToPUWG, arginfo_LatLonToPUWG, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, LatLonToUtmWGS84, arginfo_LatLonToUtmWGS84, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, LatLonToPUWGWGS84, arginfo_LatLonToPUWGWGS84, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, UtmToLatLonWGS84, arginfo_UtmToLatLonWGS84, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, PUWGToLatLonWGS84, arginfo_PUWGToLatLonWGS84, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, LatLonToUtmBatch, arginfo_LatLonToUtmBatch, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, LatLonToPUWGBatch, arginfo_LatLonToPUWGBatch, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, LatLonToUtmWGS84Batch, arginfo_LatLonToUtmWGS84Batch, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, LatLonToPUWGWGS84Batch, arginfo_LatLonToPUWGWGS84Batch, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, UtmToLatLonWGS84Batch, arginfo_UtmToLatLonWGS84Batch, ZEND_ACC_PUBLIC)
+	PHP_ME (UtmConverter, PUWGToLatLonWGS84Batch, arginfo_PUWGToLatLonWGS84Batch, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Moduł
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+PHP_MINIT_FUNCTION (geoconverter)
+{
+	zend_class_entry ce;
+	INIT_CLASS_ENTRY (ce, "UtmConverter", utmConverterMethods);
+#if defined(ZTS) && defined(COMPILE_DL_GEOCONVERTER)
+	ZEND_TSRMLS_CACHE_UPDATE ();
+#endif
+	utmConverterCe = zend_register_internal_class (&ce);
+	REGISTER_DOUBLE_CONSTANT ("DEG2RAD", deg2rad, CONST_CS | CONST_PERSISTENT);
+	REGISTER_DOUBLE_CONSTANT ("RAD2DEG", rad2deg, CONST_CS | CONST_PERSISTENT);
+	return SUCCESS;
+}
+
+PHP_MINFO_FUNCTION (geoconverter)
+{
+	php_info_print_table_start ();
+	php_info_print_table_header (2, "geoconverter support", "enabled");
+	php_info_print_table_row (2, "Version", PHP_GEOCONVERTER_VERSION);
+	php_info_print_table_end ();
+}
+
+zend_module_entry geoconverter_module_entry =
+{
+	STANDARD_MODULE_HEADER,
+	"geoconverter",
+	NULL,
+	PHP_MINIT (geoconverter),
+	NULL,
+	NULL,
+	NULL,
+	PHP_MINFO (geoconverter),
+	PHP_GEOCONVERTER_VERSION,
+	STANDARD_MODULE_PROPERTIES
+};
+
+#ifdef COMPILE_DL_GEOCONVERTER
+#ifdef ZTS
+ZEND_TSRMLS_CACHE_DEFINE()
+#endif
+ZEND_GET_MODULE (geoconverter)
+#endif
@@ -0,0 +1,18 @@
+/*
+Rozszerzenie PHP geoconverter - natywna klasa UtmConverter
+*/
+//---------------------------------------------------------------------------
+#ifndef PHP_GEOCONVERTER_H
+#define PHP_GEOCONVERTER_H
+
+extern zend_module_entry geoconverter_module_entry;
+#define phpext_geoconverter_ptr &geoconverter_module_entry
+
+#define PHP_GEOCONVERTER_VERSION "1.0.0"
+
+#if defined(ZTS) && defined(COMPILE_DL_GEOCONVERTER)
+ZEND_TSRMLS_CACHE_EXTERN()
+#endif
+
+//---------------------------------------------------------------------------
+#endif
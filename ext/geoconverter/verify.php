@@ -0,0 +1,274 @@
+<?php
+
+/**
+ * Sprawdzenie rozszerzenia geoconverter: wyniki natywnej klasy UtmConverter (metody pojedyncze i wsadowe)
+ * porównywane są z wynikami klasy PHP z niezmienionego src/UtmConverter.php dla losowych punktów (cały
+ * świat, Polska, granice stref, wartości spoza zakresu, liczby całkowite, ciągi znaków i inne wartości
+ * nieliczbowe).
+ *
+ * Klasa PHP wykonywana jest w osobnym procesie (php -n, bez rozszerzenia), który zapisuje wyniki przez
+ * serialize. Rozszerzenie liczy z tymi samymi stałymi DEG2RAD i RAD2DEG co klasa PHP; pozostają różnice
+ * zaokrągleń (potęgi, kolejność działań): strefy, typy wartości, wartości całkowite i wyjątki muszą być
+ * identyczne, współrzędne - zgodne z tolerancją $tolMetres / $tolDegrees. Pomijane są granice pasów 2000
+ * (długość 25.5), na których klasa PHP nie wybiera żadnego pasa.
+ *
+ * Użycie (z katalogu ext/geoconverter, po make):
+ *   php -d extension=modules/geoconverter.so verify.php [liczba punktów]
+ * Wynik: liczba niezgodności dla każdej metody, kod wyjścia 0 gdy wszystkie wyniki są zgodne.
+ */
+
+$referenceRun = $argc > 1 && $argv[1] === '--reference';
+$count = $referenceRun ? (int)$argv[2] : ($argc > 1 ? (int)$argv[1] : 100000);
+$tolMetres = 1e-6;
+$tolDegrees = 1e-11;
+
+if (extension_loaded('geoconverter') === $referenceRun) {
+    fwrite(STDERR, $referenceRun ? "reference run must not load the geoconverter extension\n" : "geoconverter extension is not loaded\n");
+    exit(2);
+}
+
+// Przy załadowanym rozszerzeniu plik nie deklaruje klasy (UtmConverter jest klasą natywną)
+require __DIR__ . '/../../src/UtmConverter.php';
+
+/**
+ * @param double $min
+ * @param double $max
+ * @return double
+ */
+function randomValue($min, $max)
+{
+    return $min + ($max - $min) * mt_rand() / mt_getrandmax();
+}
+
+/**
+ * Punkty testowe - ten sam ciąg w obu procesach (stałe ziarno)
+ *
+ * @param int $count
+ * @return array
+ */
+function testPoints($count)
+{
+    mt_srand(2014);
+    $points = [];
+    for ($i = 0; $i < $count; $i++) {
+        switch ($i % 8) {
+            case 0:
+            case 1:
+                $lat = randomValue(-89.0, 89.0);
+                $lon = randomValue(-180.0, 180.0);
+                break;
+            case 2:
+                // Granice stref UTM i pasów 2000
+                $lat = randomValue(49.0, 55.0);
+                $lon = [6.0 * mt_rand(-30, 30), 13.5, 16.5, 19.5, 22.5, 25.5][mt_rand(0, 5)];
+                break;
+            case 3:
+                // Granice stref równoleżnikowych, poza zakresem UTM i 1992/2000
+                $lat = [-80.0, 72.0, 84.0, 84.5, -80.5, 0.0][mt_rand(0, 5)];
+                $lon = randomValue(12.0, 27.0);
+                break;
+            case 4:
+                // Liczby całkowite i ciągi znaków (konwersja jak w arytmetyce PHP)
+                $lat = mt_rand(49, 54);
+                $lon = (string)randomValue(14.0, 24.0);
+                break;
+            default:
+                $lat = randomValue(49.0, 55.0);
+                $lon = randomValue(14.0, 24.2);
+        }
+        $points[] = [$lat, $lon];
+    }
+    return $points;
+}
+
+/**
+ * Wynik wywołania: wartości parametrów przekazanych przez referencję lub klasa zgłoszonego wyjątku
+ *
+ * @param callable $call
+ * @return array
+ */
+function outcome($call)
+{
+    try {
+        return ['values', @$call()];
+    } catch (Throwable $e) {
+        return ['throws', get_class($e)];
+    }
+}
+
+/**
+ * Wyniki metod pojedynczych klasy UtmConverter (PHP lub natywnej) dla punktów testowych
+ *
+ * @param UtmConverter $converter
+ * @param array $points
+ * @return array
+ */
+function singlePointResults($converter, $points)
+{
+    $ellipsoids = [[6378137.0, 1 / 298.257223563], [6378245.0, 1 / 298.3]];
+    $r = ['constants' => [DEG2RAD, RAD2DEG]];
+    foreach ($points as $i => $p) {
+        list($lat, $lon) = $p;
+
+        // UTM, dowolna elipsoida i WGS 84
+        foreach ($ellipsoids as $k => $el) {
+            $converter->LatLonToUtm($el[0], $el[1], $z, $b, $e, $n, $lat, $lon);
+            $r['LatLonToUtm'][$k][$i] = [$z, $b, $e, $n];
+        }
+        $converter->LatLonToUtmWGS84($z, $b, $e, $n, $lat, $lon);
+        $r['LatLonToUtmWGS84'][$i] = [$z, $b, $e, $n];
+        $converter->UtmToLatLonWGS84($z, $b, $e, $n, $la, $lo);
+        $r['UtmToLatLonWGS84'][$i] = [$la, $lo];
+
+        // 1992 i 2000 (bez granicy pasów 2000 na długości 25.5)
+        foreach ([1, 2] as $proj) {
+            if ($proj == 2 && (float)$lon == 25.5) {
+                continue;
+            }
+            foreach ($ellipsoids as $k => $el) {
+                $converter->LatLonToPUWG($el[0], $el[1], $e, $n, $lat, $lon, $proj);
+                $r['LatLonToPUWG'][$proj][$k][$i] = [$e, $n];
+            }
+            $converter->LatLonToPUWGWGS84($e, $n, $lat, $lon, $proj);
+            $r['LatLonToPUWGWGS84'][$proj][$i] = [$e, $n];
+            if (is_int($e)) {
+                continue;
+            }
+            $converter->PUWGToLatLonWGS84($e, $n, $proj, $la, $lo);
+            $r['PUWGToLatLonWGS84'][$proj][$i] = [$la, $lo];
+        }
+    }
+
+    // Wartości nieliczbowe i nietypowe: ostrzeżenia, wyjątki i wyniki jak w arytmetyce PHP
+    foreach ([null, true, '52.5', ' 52.5', '5.25e1', 'abc', [52.0]] as $v) {
+        $r['Coercion'][] = outcome(function () use ($converter, $v) {
+            $converter->LatLonToUtmWGS84($z, $b, $e, $n, $v, 20.0);
+            return [$z, $b, $e, $n];
+        });
+        $r['Coercion'][] = outcome(function () use ($converter, $v) {
+            $converter->LatLonToPUWGWGS84($e, $n, $v, 20.0, 2);
+            return [$e, $n];
+        });
+    }
+    foreach ([null, false, '20.5', 'abc', [20.0]] as $v) {
+        $r['Coercion'][] = outcome(function () use ($converter, $v) {
+            $converter->LatLonToUtmWGS84($z, $b, $e, $n, 52.0, $v);
+            return [$z, $b, $e, $n];
+        });
+        foreach ([1, 2] as $proj) {
+            $r['Coercion'][] = outcome(function () use ($converter, $v, $proj) {
+                $converter->LatLonToPUWG(6378137.0, 1 / 298.257223563, $e, $n, 52.0, $v, $proj);
+                return [$e, $n];
+            });
+        }
+    }
+    $r['Coercion'][] = outcome(function () use ($converter) {
+        $converter->UtmToLatLonWGS84('34', 'U', '500000', 5800000, $la, $lo);
+        return [$la, $lo];
+    });
+    $r['Coercion'][] = outcome(function () use ($converter) {
+        $converter->PUWGToLatLonWGS84('abc', 500000.0, 1, $la, $lo);
+        return [$la, $lo];
+    });
+    return $r;
+}
+
+$points = testPoints($count);
+
+// Proces odniesienia: klasa PHP z src/UtmConverter.php
+if ($referenceRun) {
+    echo serialize(singlePointResults(new UtmConverter(), $points));
+    exit(0);
+}
+
+$command = escapeshellarg(PHP_BINARY) . ' -n ' . escapeshellarg(__FILE__) . ' --reference ' . $count;
+$reference = @unserialize((string)shell_exec($command));
+if (!is_array($reference)) {
+    fwrite(STDERR, "reference run failed: $command\n");
+    exit(2);
+}
+
+/**
+ * Wartości zgodne: ten sam typ, liczby rzeczywiste różniące się nie więcej niż $tol, tablice - element
+ * po elemencie, pozostałe identyczne
+ *
+ * @param mixed $x
+ * @param mixed $y
+ * @param double $tol
+ * @return bool
+ */
+function same($x, $y, $tol = 0.0)
+{
+    if (gettype($x) !== gettype($y)) {
+        return false;
+    }
+    if (is_float($x)) {
+        return $x === $y || abs($x - $y) <= $tol || (is_nan($x) && is_nan($y));
+    }
+    if (is_array($x)) {
+        if (count($x) !== count($y)) {
+            return false;
+        }
+        foreach ($x as $i => $v) {
+            if (!array_key_exists($i, $y) || !same($v, $y[$i], $tol)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return $x === $y;
+}
+
+$native = new UtmConverter();
+$errors = [];
+$report = function ($name, $ok) use (&$errors) {
+    if (!isset($errors[$name])) {
+        $errors[$name] = 0;
+    }
+    if (!$ok) {
+        $errors[$name]++;
+    }
+};
+$report('NativeClass', (new ReflectionClass('UtmConverter'))->isInternal());
+
+// Metody pojedyncze - wynik po wyniku
+$results = singlePointResults($native, $points);
+foreach ($reference as $name => $expected) {
+    $tol = in_array($name, ['UtmToLatLonWGS84', 'PUWGToLatLonWGS84']) ? $tolDegrees : $tolMetres;
+    $report($name, isset($results[$name]) && same($expected, $results[$name], $tol));
+}
+
+// Metody wsadowe - wyniki takie jak z metod pojedynczych klasy PHP
+$lats = array_column($points, 0);
+$lons = array_column($points, 1);
+$utm = $reference['LatLonToUtmWGS84'];
+$native->LatLonToUtmWGS84Batch($zs, $bs, $es, $ns, $lats, $lons);
+$report('LatLonToUtmWGS84Batch', same($utm, array_map(null, $zs, $bs, $es, $ns), $tolMetres));
+$native->LatLonToUtmBatch(6378245.0, 1 / 298.3, $zs, $bs, $es, $ns, $lats, $lons);
+$report('LatLonToUtmBatch', same($reference['LatLonToUtm'][1], array_map(null, $zs, $bs, $es, $ns), $tolMetres));
+$native->UtmToLatLonWGS84Batch(array_column($utm, 0), array_column($utm, 1), array_column($utm, 2), array_column($utm, 3), $las, $los);
+foreach ($reference['UtmToLatLonWGS84'] as $i => $r) {
+    $native->UtmToLatLonWGS84($utm[$i][0], $utm[$i][1], $utm[$i][2], $utm[$i][3], $la, $lo);
+    $report('UtmToLatLonWGS84Batch', same([$la, $lo], [$las[$i], $los[$i]], $tolDegrees) && same($r, [$la, $lo], $tolDegrees));
+}
+foreach ([1, 2] as $proj) {
+    $native->LatLonToPUWGWGS84Batch($es, $ns, $lats, $lons, $proj);
+    $native->LatLonToPUWGBatch(6378137.0, 1 / 298.257223563, $es2, $ns2, $lats, $lons, $proj);
+    foreach ($reference['LatLonToPUWGWGS84'][$proj] as $i => $r) {
+        $report('LatLonToPUWGWGS84Batch', same($r, [$es[$i], $ns[$i]], $tolMetres));
+        $report('LatLonToPUWGBatch', same($r, [$es2[$i], $ns2[$i]], $tolMetres));
+    }
+    $inverse = $reference['PUWGToLatLonWGS84'][$proj];
+    $puwg = array_intersect_key($reference['LatLonToPUWGWGS84'][$proj], $inverse);
+    $native->PUWGToLatLonWGS84Batch(array_column($puwg, 0), array_column($puwg, 1), $proj, $las, $los);
+    $report('PUWGToLatLonWGS84Batch', same(array_values($inverse), array_map(null, $las, $los), $tolDegrees));
+}
+$report('BatchCountMismatch', @$native->LatLonToUtmWGS84Batch($zs, $bs, $es, $ns, [1.0, 2.0], [3.0]) === false);
+
+$total = 0;
+foreach ($errors as $name => $n) {
+    printf("%-24s %d\n", $name, $n);
+    $total += $n;
+}
+printf("points: %d, mismatches: %d\n", $count, $total);
+exit($total == 0 ? 0 : 1);
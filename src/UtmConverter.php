@@ -8,6 +8,13 @@
  * @author Piotr Knapik (porting to PHP), 2016
  */
 
+// Rozszerzenie geoconverter (ext/geoconverter) definiuje natywną klasę UtmConverter o tym samym API
+// (obliczenia biblioteki C++ z tymi samymi stałymi DEG2RAD i RAD2DEG - wyniki zgodne do ok. 1e-8 m)
+// oraz stałe DEG2RAD i RAD2DEG
+if (extension_loaded('geoconverter')) {
+    return;
+}
+
 define('DEG2RAD', 0.01745329);
 define('RAD2DEG', 57.29577951);
 
@@ -8,6 +8,7 @@ Krzysztof Naus, Gdynia 2014
 
 
 #include <math.h>
+#include "UTM_1992_2000_Stats.h"
 ////////////////////////////////////////////////////////////////////////////////
 //Deklaracja staych
 ////////////////////////////////////////////////////////////////////////////////
@@ -18,6 +19,39 @@ static const double fe = 500000.0;
 //Deklaracja tablicy stref rownolenikowych
 static char cArray[] = "CDEFGHJKLMNPQRSTUVWX";
 
+//Deklaracja odwzorowa kartograficznych obsugiwanych przez kontekst odwzorowania
+enum ProjectionType { projUTM, projPUWG1992, projPUWG2000 };
+
+//Deklaracja metod wyznaczania dugoci uku poudnika i szerokoci punktu podnkowego
+//  engineClassic - szereg sphtmd (4 x sin) i 5 iteracji Newtona w konwersji odwrotnej (jak w kodzie pierwotnym)
+//  engineKruger  - sumowanie Clenshawa z jednej pary sin/cos i jawny szereg Krgera dla szerokoci punktu podnkowego
+enum ProjectionEngine { engineClassic, engineKruger };
+
+//Deklaracja poziomw dokadnoci oblicze (maksymalny bd kadego poziomu zmierzony programem bench/UTM_1992_2000_Accuracy.cpp)
+//  precFull      - peny szereg w liczbach double (wyniki identyczne jak bez wyboru poziomu)
+//  precTruncated - wyrazy szeregu pomijane, gdy ich warto dla danego |dlam| (|de|) nie przekracza truncTolerance;
+//                  bd wzgldem precFull nie wikszy ni 3 x truncTolerance (0.3 mm); w jdrach wektorowych grupa
+//                  jest pomijana tylko wtedy, gdy dotyczy to wszystkich punktw wektora - zysk dla punktw
+//                  pooonych blisko poudnika osiowego (np. posortowanych), dla danych rozproszonych brak
+//  precFloat     - szereg w liczbach float (w jdrach wektorowych dwa razy wicej punktw w wektorze), dugo uku
+//                  poudnika, faszywa pnoc i wschd w double; bd pojedynczej konwersji i konwersji tam
+//                  i z powrotem nie wikszy ni floatTolerance
+enum ProjectionPrecision { precFull, precTruncated, precFloat };
+
+//Dopuszczalna warto pominitej grupy wyrazw szeregu dla precTruncated [metry]
+static const double truncTolerance = 0.0001;
+
+//Maksymalny bd poziomu precFloat dla projUTM, projPUWG1992, projPUWG2000 [metry]
+//  (zmierzone na 2 mln punktw kadego zbioru: pojedyncza konwersja 0.08, 0.13 i 0.03 m, tam i z powrotem 0.12, 0.17
+//  i 0.04 m - gwnie bd zaokrglenia float skadowej Y, rosncy z odlegoci od poudnika osiowego)
+static const double floatTolerance[3] = { 0.15, 0.20, 0.05 };
+
+//Grne ograniczenia wspczynnikw grup wyrazw szeregu (jednostka: dua po a, szeroko -84..84 stopnie, e^2 <= 0.0068, zapas 5%)
+//  truncForwardBound[g] = { X, Y }: grupy (t3, t7), (t4, t8), (t5, t9), wyraz rzdu dlam^(2g+4) i dlam^(2g+3)
+//  truncInverseBound[g] = { lat, lon }: grupy (t11, t15), (t12, t16), (t13, t17) wyraone w metrach na elipsoidzie
+static const double truncForwardBound[3][2] = { { 0.068, 0.177 }, { 0.020, 0.045 }, { 0.0062, 0.0128 } };
+static const double truncInverseBound[3][2] = { { 0.091, 0.192 }, { 0.037, 0.090 }, { 0.018, 0.056 } };
+
 //------------------------------------------------------------------------------
 ////////////////////////////////////////////////////////////////////////////////
 //Funkcje pomocnicze
@@ -64,42 +98,188 @@ double sphtmd (double ap, double bp, double cp, double dp, double ep, double sph
 }
 
 //=======================================================================
-//  Funkcja suy do konwersji wsprzednych elipsoidalnych B, L (lat/lon) na paskie X-northing, Y-easting odwzorowania kartograficznego UTM (dla dowolnej elipsoidy)
+//  Suma szeregu c1 sin (2x) + c2 sin (4x) + ... + cn sin (2nx) metod Clenshawa
 //=======================================================================
-//      Argumenty wejciowe i wyjciowe:
-//      --------------------------------
-//       double a: dugo duej posi elipsoidy odniesienia, w metrach (np. dla elipsoidy WGS 84, 6378137.0)
-//       double f: spaszczenie elipsoidalne (np. dla elipsoidy WGS 84, 1 / 298.257223563)
-//       int& utmXZone: nr strefy UTM wg. podziau poudnikowego (zwracane numery od 1 do 60, kada strefa ma sze stopni)
-//       char& utmYZone: nr strefy wg. podziau rwnolenikowego (zwracane wartoci: CDEFGHJKLMNPQRSTUVWX)
-//       double& easting: wsprzdna Y UTM, w metrach po konwersji [metry]
-//       double& northing: wsprzdna X UTM, w metrach po konwersji [metry]
-//       double lat, double lon: wsprzdne lat/lon do konwersji [stopnie]
+//       const double* cf: wspczynniki c1..cn
+//       int n: liczba wspczynnikw
+//       double s2, double c2: sin (2x) i cos (2x)
 //=======================================================================
-void LatLonToUtm (double a, double f, int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon)
+double ClenshawSin (const double* cf, int n, double s2, double c2)
+{
+	double x = 2.0 * c2;
+	double b1 = 0.0;
+	double b2 = 0.0;
+	for(int k = n - 1; k >= 0; k--)
+	  {
+	   double b0 = cf[k] + x * b1 - b2;
+	   b2 = b1;
+	   b1 = b0;
+	  }
+	return b1 * s2;
+}
+
+//=======================================================================
+//  Kontekst odwzorowania: stae elipsoidy i odwzorowania wyznaczane jednorazowo
+//=======================================================================
+//      Kontekst tworzy funkcja CreateProjectionContext, a nastpnie jest przekazywany
+//      (tylko do odczytu) do funkcji konwersji. Jeden kontekst moe by wspdzielony
+//      przez dowoln liczb wtkw.
+//=======================================================================
+struct ProjectionContext
 {
-        // Wspczynnik znieksztacenia skali w poudniku osiowym
-        static const double ok = 0.9996;
-	double recf;
+	ProjectionType proj;
+	ProjectionEngine engine;
+	// Parametry elipsoidy
+	double a;
+	double f;
 	double b;
 	double eSquared;
 	double e2Squared;
 	double tn;
+	// Wspczynniki szeregu dugoci uku poudnika
 	double ap;
 	double bp;
 	double cp;
 	double dp;
 	double ep;
-	double olam;
-	double dlam;
-	double s;
-	double c;
-	double t;
-	double eta;
-	double sn;
-	double tmd;
-	double t1, t2, t3, t4, t5,  t6, t7, t8, t9;
+	// Te same wspczynniki jako szereg sinusw wielokrotnoci 2 sphi: -bp, cp, -dp, ep (engineKruger)
+	double arc[4];
+	// Wspczynniki szeregu Krgera szerokoci punktu podnkowego wzgldem szerokoci prostujcej mu = tmd / ap (engineKruger)
+	double fpb[5];
+	// Promie krzywizny poudnika na rwniku (sphsr dla sphi = 0)
+	double sr0;
+	// Wspczynnik znieksztacenia skali w poudniku osiowym i jego potgi (okPow[n] = ok^n)
+	double ok;
+	double okPow[9];
+	// Faszywy wschd i faszywa pnoc (dla UTM: pnoc stosowana na pkuli poudniowej)
+	double fe;
 	double nfn;
+	// Pasy odwzorowania: poudniki osiowe [radiany] i przesunicia pasw (1992 - jeden pas, 2000 - cztery pasy, UTM - brak)
+	int strips;
+	double olam[4];
+	double strf[4];
+	// Poziom dokadnoci i progi |dlam| (konwersja lat/lon -> X/Y) oraz |de| / (sn ok) (konwersja odwrotna) [radiany],
+	// powyej ktrych liczone s kolejne grupy wyrazw szeregu (precTruncated; dla pozostaych poziomw -1)
+	ProjectionPrecision precision;
+	double truncFwd[3];
+	double truncInv[3];
+};
+
+//=======================================================================
+//  Funkcja wyznacza kontekst odwzorowania dla dowolnej elipsoidy
+//=======================================================================
+//       double a: dugo duej posi elipsoidy odniesienia, w metrach (np. dla elipsoidy WGS 84, 6378137.0)
+//       double f: spaszczenie elipsoidalne (np. dla elipsoidy WGS 84, 1 / 298.257223563)
+//       ProjectionType proj: odwzorowanie kartograficzne (projUTM, projPUWG1992, projPUWG2000)
+//       ProjectionEngine engine: metoda oblicze (engineClassic - wyniki identyczne z kodem pierwotnym, engineKruger - szybsza konwersja odwrotna)
+//       ProjectionPrecision precision: poziom dokadnoci (precFull, precTruncated, precFloat)
+//=======================================================================
+ProjectionContext CreateProjectionContext (double a, double f, ProjectionType proj, ProjectionEngine engine = engineClassic, ProjectionPrecision precision = precFull)
+{
+	ProjectionContext ctx;
+	double recf = 1.0 / f;
+	double b = a * (recf - 1.0) / recf;
+	double tn = (a - b) / (a + b);
+	ctx.proj = proj;
+	ctx.engine = engine;
+	ctx.a = a;
+	ctx.f = f;
+	ctx.b = b;
+	ctx.eSquared = CalculateESquared (a, b);
+	ctx.e2Squared = CalculateE2Squared (a, b);
+	ctx.tn = tn;
+	ctx.ap = a * (1.0 - tn + 5.0 * ((tn * tn) - (tn * tn * tn)) / 4.0 + 81.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 64.0);
+	ctx.bp = 3.0 * a * (tn - (tn * tn) + 7.0 * ((tn * tn * tn) - (tn * tn * tn * tn)) / 8.0 + 55.0 * (tn * tn * tn * tn * tn) / 64.0) / 2.0;
+	ctx.cp = 15.0 * a * ((tn * tn) - (tn * tn * tn) + 3.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 4.0) / 16.0;
+	ctx.dp = 35.0 * a * ((tn * tn * tn) - (tn * tn * tn * tn) + 11.0 * (tn * tn * tn * tn * tn) / 16.0) / 48.0;
+	ctx.ep = 315.0 * a * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 512.0;
+	ctx.arc[0] = -ctx.bp;
+	ctx.arc[1] = ctx.cp;
+	ctx.arc[2] = -ctx.dp;
+	ctx.arc[3] = ctx.ep;
+	ctx.fpb[0] = 3.0 * tn / 2.0 - 27.0 * (tn * tn * tn) / 32.0 + 269.0 * (tn * tn * tn * tn * tn) / 512.0;
+	ctx.fpb[1] = 21.0 * (tn * tn) / 16.0 - 55.0 * (tn * tn * tn * tn) / 32.0;
+	ctx.fpb[2] = 151.0 * (tn * tn * tn) / 96.0 - 417.0 * (tn * tn * tn * tn * tn) / 128.0;
+	ctx.fpb[3] = 1097.0 * (tn * tn * tn * tn) / 512.0;
+	ctx.fpb[4] = 8011.0 * (tn * tn * tn * tn * tn) / 2560.0;
+	ctx.sr0 = sphsr (a, ctx.eSquared, 0.0);
+	ctx.fe = fe;
+	for(int i = 0; i < 4; i++)
+	  {
+	   ctx.olam[i] = 0.0;
+	   ctx.strf[i] = 0.0;
+	  }
+	if(proj == projUTM)
+	  {
+	   ctx.ok = 0.9996;
+	   ctx.nfn = 10000000.0;
+	   ctx.strips = 0;
+	  }
+	  else if(proj == projPUWG1992)
+	  {
+	   ctx.ok = 0.9993;
+	   ctx.nfn = -5300000.0;
+	   ctx.strips = 1;
+	   ctx.olam[0] = 19.0 * deg2rad;
+	   ctx.strf[0] = 0.0;
+	  }
+	  else
+	  {
+	   ctx.ok = 0.999923;
+	   ctx.nfn = 0;
+	   ctx.strips = 4;
+	   for(int i = 0; i < 4; i++)
+	     {
+	      ctx.olam[i] = (15.0 + 3.0 * i) * deg2rad;
+	      ctx.strf[i] = 5000000.0 + 1000000.0 * i;
+	     }
+	  }
+	ctx.okPow[0] = 1.0;
+	for(int i = 1; i < 9; i++)
+	  {
+	   ctx.okPow[i] = ctx.okPow[i - 1] * ctx.ok;
+	  }
+	ctx.precision = precision;
+	for(int g = 0; g < 3; g++)
+	  {
+	   ctx.truncFwd[g] = -1.0;
+	   ctx.truncInv[g] = -1.0;
+	   if(precision != precTruncated) continue;
+	   // Grupa g pomijana, gdy a * bound * |dlam|^p <= truncTolerance / 2 dla X (p = 2g + 4) i Y (p = 2g + 3)
+	   double tol = truncTolerance / (2.0 * a);
+	   ctx.truncFwd[g] = fmin (pow (tol / truncForwardBound[g][0], 1.0 / (2 * g + 4)), pow (tol / truncForwardBound[g][1], 1.0 / (2 * g + 3)));
+	   ctx.truncInv[g] = fmin (pow (tol / truncInverseBound[g][0], 1.0 / (2 * g + 4)), pow (tol / truncInverseBound[g][1], 1.0 / (2 * g + 3)));
+	  }
+	return ctx;
+}
+
+//Poudnik osiowy strefy UTM [radiany]
+double UtmCentralMeridian (int utmXZone)
+{
+	return (utmXZone * 6 - 183) * deg2rad;
+}
+
+//Nr pasa odwzorowania 2000 (0..3) dla dugoci geograficznej z zakresu 13.5 - 25.5 [stopnie]
+int PUWGStripFromLon (double lon)
+{
+	if(lon < 16.5) return 0;
+	if(lon < 19.5) return 1;
+	if(lon < 22.5) return 2;
+	return 3;
+}
+
+//Nr pasa odwzorowania 2000 (0..3) dla wsprzdnej easting [metry]
+int PUWGStripFromEasting (double easting)
+{
+	if(easting < 6000000.0) return 0;
+	if(easting < 7000000.0) return 1;
+	if(easting < 8000000.0) return 2;
+	return 3;
+}
+
+//Strefa UTM wg. podziau poudnikowego i rwnolenikowego dla lat/lon [stopnie] (dla bdnej szerokoci utmYZone = '*')
+void UtmZone (double lat, double lon, int& utmXZone, char& utmYZone)
+{
 	if(lon <= 0.0)
           {
            utmXZone = 30 + (int)(lon / 6.0);
@@ -108,7 +288,12 @@ void LatLonToUtm (double a, double f, int& utmXZone, char& utmYZone, double& eas
           {
           utmXZone = 31 + (int)(lon / 6.0);
           }
-        if(lat < 84.0 && lat >= 72.0)
+	if(!(lat >= -80.0 && lat < 84.0))
+          {
+          // Bdna warto szerokoci geograficznej (zwracany znak gwiazdki)
+           utmYZone = '*';
+          }
+          else if(lat >= 72.0)
           {
           // Specjalne zatrzymanie: strefa X ma 12 stopni od pnocy do poudnia, nie 8
           utmYZone = cArray[19];
@@ -117,44 +302,454 @@ void LatLonToUtm (double a, double f, int& utmXZone, char& utmYZone, double& eas
           {
           utmYZone = cArray[(int)((lat + 80.0) / 8.0)];
           }
-	if(lat >= 84.0 || lat < -80.0)
-          {
-          // Bdna warto szerokoci geograficznej (zwracany znak gwiazdki)
-           utmYZone = '*';
-          }
-	double latRad = lat * deg2rad;
-	double lonRad = lon * deg2rad;
-	recf = 1.0 / f;
-	b = a * (recf - 1.0) / recf;
-	eSquared = CalculateESquared (a, b);
-	e2Squared = CalculateE2Squared (a, b);
-	tn = (a - b) / (a + b);
-	ap = a * (1.0 - tn + 5.0 * ((tn * tn) - (tn * tn * tn)) / 4.0 + 81.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 64.0);
-	bp = 3.0 * a * (tn - (tn * tn) + 7.0 * ((tn * tn * tn) - (tn * tn * tn * tn)) / 8.0 + 55.0 * (tn * tn * tn * tn * tn) / 64.0) / 2.0;
-	cp = 15.0 * a * ((tn * tn) - (tn * tn * tn) + 3.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 4.0) / 16.0;
-	dp = 35.0 * a * ((tn * tn * tn) - (tn * tn * tn * tn) + 11.0 * (tn * tn * tn * tn * tn) / 16.0) / 48.0;
-	ep = 315.0 * a * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 512.0;
-	olam = (utmXZone * 6 - 183) * deg2rad;
-	dlam = lonRad - olam;
-	s = sin (latRad);
-	c = cos (latRad);
-	t = s / c;
-	eta = e2Squared * (c * c);
-	sn = sphsn (a, eSquared, latRad);
-	tmd = sphtmd (ap, bp, cp, dp, ep, latRad);
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: zbieno poudnikw i skala w punkcie z wielkoci wyznaczonych w szeregu odwzorowania
+//=======================================================================
+//       double ok: wspczynnik znieksztacenia skali w poudniku osiowym
+//       double s, double c: sin i cos szerokoci geograficznej punktu
+//       double eta: e'^2 cos^2 szerokoci
+//       double dlam: rnica dugoci geograficznej wzgldem poudnika osiowego [radiany]
+//       double& convergence: zbieno poudnikw (kt od pnocy geograficznej do osi X ukadu,
+//                            dodatni na wschd od poudnika osiowego na pkuli pnocnej) [radiany]
+//       double& scale: skala w punkcie (wspczynnik znieksztacenia dugoci)
+//      Wyrazy do (dlam cos)^4 dla zbienoci i (dlam cos)^6 dla skali; tg szerokoci wystpuje tylko
+//      jako (dlam sin)^2, wic wzory s poprawne take na biegunach.
+//=======================================================================
+void GridFactors (double ok, double s, double c, double eta, double dlam, double& convergence, double& scale)
+{
+	double l = dlam * c;
+	double l2 = l * l;
+	double m2 = (dlam * s) * (dlam * s);
+	double e2 = eta * eta;
+	double e3 = e2 * eta;
+	convergence = dlam * s * (1.0 + l2 * (1.0 + 3.0 * eta + 2.0 * e2) / 3.0 + (2.0 * l2 - m2) * l2 / 15.0);
+	scale = ok * (1.0 + l2 * (1.0 + eta) / 2.0
+		+ (l2 * (5.0 + 14.0 * eta + 13.0 * e2 + 4.0 * e3) - m2 * (4.0 + 28.0 * eta + 48.0 * e2 + 24.0 * e3)) * l2 / 24.0
+		+ (61.0 * l2 * l2 - 148.0 * l2 * m2 + 16.0 * m2 * m2) * l2 / 720.0);
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: zbieno poudnikw i skala dla wyniku konwersji odwrotnej
+//=======================================================================
+//      sin i cos szerokoci wynikowej latRad z sin/cos szerokoci punktu podnkowego ftphi
+//      (szeregi sin i cos poprawki ftphi - latRad, bez dodatkowych funkcji trygonometrycznych)
+//=======================================================================
+void GridFactorsInverse (double ok, double e2Squared, double ftphi, double s1, double c1, double latRad, double dlam, double& convergence, double& scale)
+{
+	double d = ftphi - latRad;
+	double dd = d * d;
+	double sd = d * (1.0 - dd / 6.0 * (1.0 - dd / 20.0));
+	double cd = 1.0 - dd / 2.0 * (1.0 - dd / 12.0 * (1.0 - dd / 30.0));
+	double s = s1 * cd - c1 * sd;
+	double c = c1 * cd + s1 * sd;
+	GridFactors (ok, s, c, e2Squared * (c * c), dlam, convergence, scale);
+}
+
+//=======================================================================
+//  Suma szeregu sinusw metod Clenshawa w liczbach float (poziom precFloat)
+//=======================================================================
+float ClenshawSinFloat (const double* cf, int n, float s2, float c2)
+{
+	float x = 2.0f * c2;
+	float b1 = 0.0f;
+	float b2 = 0.0f;
+	for(int k = n - 1; k >= 0; k--)
+	  {
+	   float b0 = (float)cf[k] + x * b1 - b2;
+	   b2 = b1;
+	   b1 = b0;
+	  }
+	return b1 * s2;
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: szereg odwzorowania Gaussa-Krgera w liczbach float (poziom precFloat)
+//=======================================================================
+//      W double liczone s tylko wyrazy o duej wartoci: ap * latRad, faszywa pnoc i wschd;
+//      sin/cos szerokoci, suma Clenshawa dugoci uku i wyrazy zalene od dlam - w float.
+//=======================================================================
+template <class Context>
+void TMForwardFloat (const Context& ctx, double latRad, double dlam, double nfn, double efe, double& easting, double& northing, double* convergence = 0, double* scale = 0)
+{
+	float phi = (float)latRad;
+	float s = sinf (phi);
+	float c = cosf (phi);
+	float t = s / c;
+	float tt = t * t;
+	float cc = c * c;
+	float eta = (float)ctx.e2Squared * cc;
+	float snc = (float)(ctx.a * ctx.ok) * c / sqrtf (1.0f - (float)ctx.eSquared * (s * s));
+	float snc3 = snc * cc;
+	float snc5 = snc3 * cc;
+	float snc7 = snc5 * cc;
+	float dl = (float)dlam;
+	float l = dl * dl;
+	float t2 = snc * s / 2.0f;
+	float e2 = eta * eta;
+	float t3 = snc3 * s * (5.0f - tt + 9.0f * eta + 4.0f * e2) / 24.0f;
+	float t4 = snc5 * s * (61.0f - 58.0f * tt + tt * tt + 270.0f * eta - 330.0f * tt * eta + 445.0f * e2 + 324.0f * (e2 * eta) - 680.0f * tt * e2 + 88.0f * (e2 * e2) - 600.0f * tt * (e2 * eta) - 192.0f * tt * (e2 * e2)) / 720.0f;
+	float t5 = snc7 * s * (1385.0f - 3111.0f * tt + 543.0f * (tt * tt) - (tt * tt * tt)) / 40320.0f;
+	float arc = (float)ctx.ok * ClenshawSinFloat (ctx.arc, 4, 2.0f * s * c, (c - s) * (c + s));
+	northing = nfn + ctx.ok * ctx.ap * latRad + (double)(arc + l * (t2 + l * (t3 + l * (t4 + l * t5))));
+	float t7 = snc3 * (1.0f - tt + eta) / 6.0f;
+	float t8 = snc5 * (5.0f - 18.0f * tt + tt * tt + 14.0f * eta - 58.0f * tt * eta + 13.0f * e2 + 4.0f * (e2 * eta) - 64.0f * tt * e2 - 24.0f * tt * (e2 * eta)) / 120.0f;
+	float t9 = snc7 * (61.0f - 479.0f * tt + 179.0f * (tt * tt) - (tt * tt * tt)) / 5040.0f;
+	easting = efe + dlam * (double)(snc + l * (t7 + l * (t8 + l * t9)));
+	if(convergence) GridFactors (ctx.ok, s, c, eta, dlam, *convergence, *scale);
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: szereg odwrotny odwzorowania Gaussa-Krgera w liczbach float (poziom precFloat)
+//=======================================================================
+//      Szeroko prostujca mu i szeroko punktu podnkowego w double (szereg Krgera niezalenie od metody);
+//      wyrazy szeregu jako potgi x = de / (sn ok), aby unikn przekroczenia zakresu float przez sn^7.
+//=======================================================================
+template <class Context>
+void TMInverseFloat (const Context& ctx, double de, double dn, double& latRad, double& dlam, double* convergence = 0, double* scale = 0)
+{
+	double mu = dn / ctx.ok / ctx.ap;
+	float mu2 = (float)(2.0 * mu);
+	double ftphi = mu + (double)ClenshawSinFloat (ctx.fpb, 5, sinf (mu2), cosf (mu2));
+	float phi = (float)ftphi;
+	float s = sinf (phi);
+	float c = cosf (phi);
+	float t = s / c;
+	float tt = t * t;
+	float eta = (float)ctx.e2Squared * (c * c);
+	float dnm2 = 1.0f - (float)ctx.eSquared * (s * s);
+	float rsnok = sqrtf (dnm2) / (float)(ctx.a * ctx.ok);
+	float x = (float)de * rsnok;
+	float xx = x * x;
+	float snr = dnm2 / (float)(1.0 - ctx.eSquared);
+	float e2 = eta * eta;
+	float p11 = 5.0f + 3.0f * tt + eta - 4.0f * e2 - 9.0f * tt * eta;
+	float p12 = 61.0f + 90.0f * tt + 46.0f * eta + 45.0f * (tt * tt) - 252.0f * tt * eta - 3.0f * e2 + 100.0f * (e2 * eta) - 66.0f * tt * e2 - 90.0f * (tt * tt) * eta + 88.0f * (e2 * e2) + 225.0f * (tt * tt) * e2 + 84.0f * tt * (e2 * eta) - 192.0f * tt * (e2 * e2);
+	float p13 = 1385.0f + 3633.0f * tt + 4095.0f * (tt * tt) + 1575.0f * (tt * tt * tt);
+	latRad = ftphi - (double)(t * snr * xx * (0.5f - xx * (p11 / 24.0f - xx * (p12 / 720.0f - xx * p13 / 40320.0f))));
+	float q15 = 1.0f + 2.0f * tt + eta;
+	float q16 = 5.0f + 6.0f * eta + 28.0f * tt - 3.0f * e2 + 8.0f * tt * eta + 24.0f * (tt * tt) - 4.0f * (e2 * eta) + 4.0f * tt * e2 + 24.0f * tt * (e2 * eta);
+	float q17 = 61.0f + 662.0f * tt + 1320.0f * (tt * tt) + 720.0f * (tt * tt * tt);
+	dlam = de * (double)(rsnok / c * (1.0f - xx * (q15 / 6.0f - xx * (q16 / 120.0f - xx * q17 / 5040.0f))));
+	if(convergence) GridFactorsInverse (ctx.ok, ctx.e2Squared, phi, s, c, latRad, dlam, *convergence, *scale);
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: szereg odwzorowania Gaussa-Krgera (lat/lon -> X/Y) dla danego kontekstu
+//=======================================================================
+//       const Context& ctx: ProjectionContext albo StaticContext (UTM_1992_2000_Static.h)
+//       double latRad: szeroko geograficzna [radiany]
+//       double dlam: rnica dugoci geograficznej wzgldem poudnika osiowego [radiany]
+//       double nfn: faszywa pnoc [metry]
+//       double efe: faszywy wschd cznie z przesuniciem pasa [metry]
+//       double* convergence, double* scale: zbieno poudnikw [radiany] i skala w punkcie (GridFactors) lub 0
+//=======================================================================
+template <class Context>
+void TMForward (const Context& ctx, double latRad, double dlam, double nfn, double efe, double& easting, double& northing, double* convergence = 0, double* scale = 0)
+{
+	if(ctx.precision == precFloat)
+	  {
+	   TMForwardFloat (ctx, latRad, dlam, nfn, efe, easting, northing, convergence, scale);
+	   return;
+	  }
+	double ok = ctx.ok;
+	double s = sin (latRad);
+	double c = cos (latRad);
+	double t = s / c;
+	double eta = ctx.e2Squared * (c * c);
+	double sn = ctx.a / sqrt (1.0 - ctx.eSquared * (s * s));
+	double tmd;
+	if(ctx.engine == engineKruger)
+	  {
+	   // sin 2sphi i cos 2sphi z sin/cos szerokoci - bez dodatkowych funkcji trygonometrycznych
+	   tmd = ctx.ap * latRad + ClenshawSin (ctx.arc, 4, 2.0 * s * c, (c - s) * (c + s));
+	  }
+	  else
+	  {
+	   tmd = sphtmd (ctx.ap, ctx.bp, ctx.cp, ctx.dp, ctx.ep, latRad);
+	  }
+	double t1, t2, t3, t4, t5,  t6, t7, t8, t9;
+	// precTruncated: grupy wyrazw pomijalnych dla danego |dlam| rwne zeru (dla pozostaych poziomw progi ujemne)
+	double adl = fabs (dlam);
+	t3 = t4 = t5 = t7 = t8 = t9 = 0.0;
 	t1 = tmd * ok;
 	t2 = sn * s * c * ok / 2.0;
-	t3 = sn * s * (c * c * c) * ok * (5.0 - (t * t) + 9.0 * eta + 4.0 * (eta * eta)) / 24.0;
-        t4 = sn * s * (c * c * c * c * c) * ok * (61.0 - 58.0 * (t * t) + (t * t * t * t) + 270.0 * eta - 330.0 * (t * t) * eta + 445.0 * (eta * eta) + 324.0 * (eta * eta * eta) - 680.0 * (t * t) * (eta * eta) + 88.0 * (eta * eta * eta * eta) - 600.0 * (t * t) * (eta * eta * eta) - 192.0 * (t * t) * (eta * eta * eta * eta)) / 720.0;
-        t5 = sn * s * (c * c * c * c * c * c * c) * ok * (1385.0 - 3111.0 * (t * t) + 543.0 * (t * t * t * t) - (t * t * t * t * t * t)) / 40320.0;
-	if (latRad < 0.0) nfn = 10000000.0; else nfn = 0;
+	if(adl > ctx.truncFwd[0]) t3 = sn * s * (c * c * c) * ok * (5.0 - (t * t) + 9.0 * eta + 4.0 * (eta * eta)) / 24.0;
+	if(adl > ctx.truncFwd[1]) t4 = sn * s * (c * c * c * c * c) * ok * (61.0 - 58.0 * (t * t) + (t * t * t * t) + 270.0 * eta - 330.0 * (t * t) * eta + 445.0 * (eta * eta) + 324.0 * (eta * eta * eta) - 680.0 * (t * t) * (eta * eta) + 88.0 * (eta * eta * eta * eta) - 600.0 * (t * t) * (eta * eta * eta) - 192.0 * (t * t) * (eta * eta * eta * eta)) / 720.0;
+	if(adl > ctx.truncFwd[2]) t5 = sn * s * (c * c * c * c * c * c * c) * ok * (1385.0 - 3111.0 * (t * t) + 543.0 * (t * t * t * t) - (t * t * t * t * t * t)) / 40320.0;
 	northing = nfn + t1 + (dlam * dlam) * t2 + (dlam * dlam * dlam * dlam) * t3 + (dlam * dlam * dlam * dlam * dlam * dlam) * t4 + (dlam * dlam * dlam * dlam * dlam * dlam * dlam * dlam) * t5;
 	t6 = sn * c * ok;
-	t7 = sn * (c * c * c) * ok * (1.0 - (t * t) + eta) / 6.0;
-        t8 = sn * (c * c * c * c * c) * ok * (5.0 - 18.0 * (t * t) + (t * t * t * t) + 14.0 * eta - 58.0 * (t * t) * eta + 13.0 * (eta * eta) + 4.0 * (eta * eta * eta) - 64.0 * (t * t) * (eta * eta) - 24.0 * (t * t) * (eta * eta * eta)) / 120.0;
-        t9 = sn * (c * c * c * c * c * c * c) * ok * (61.0 - 479.0 * (t * t) + 179.0 *  (t * t * t * t) - (t * t * t * t * t * t)) / 5040.0;
-	easting = fe + dlam * t6 + (dlam * dlam * dlam) * t7  + (dlam * dlam * dlam * dlam * dlam) * t8 + (dlam * dlam * dlam * dlam * dlam * dlam * dlam) * t9;
+	if(adl > ctx.truncFwd[0]) t7 = sn * (c * c * c) * ok * (1.0 - (t * t) + eta) / 6.0;
+	if(adl > ctx.truncFwd[1]) t8 = sn * (c * c * c * c * c) * ok * (5.0 - 18.0 * (t * t) + (t * t * t * t) + 14.0 * eta - 58.0 * (t * t) * eta + 13.0 * (eta * eta) + 4.0 * (eta * eta * eta) - 64.0 * (t * t) * (eta * eta) - 24.0 * (t * t) * (eta * eta * eta)) / 120.0;
+	if(adl > ctx.truncFwd[2]) t9 = sn * (c * c * c * c * c * c * c) * ok * (61.0 - 479.0 * (t * t) + 179.0 *  (t * t * t * t) - (t * t * t * t * t * t)) / 5040.0;
+	easting = efe + dlam * t6 + (dlam * dlam * dlam) * t7  + (dlam * dlam * dlam * dlam * dlam) * t8 + (dlam * dlam * dlam * dlam * dlam * dlam * dlam) * t9;
+	if(convergence) GridFactors (ok, s, c, eta, dlam, *convergence, *scale);
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: szereg odwrotny odwzorowania Gaussa-Krgera (X/Y -> lat/lon) dla danego kontekstu
+//=======================================================================
+//       const Context& ctx: ProjectionContext albo StaticContext (UTM_1992_2000_Static.h)
+//       double de: odlego od poudnika osiowego (easting pomniejszony o faszywy wschd) [metry]
+//       double dn: northing pomniejszony o faszyw pnoc [metry]
+//       double& latRad: szeroko geograficzna po konwersji [radiany]
+//       double& dlam: rnica dugoci geograficznej wzgldem poudnika osiowego [radiany]
+//       double* convergence, double* scale: zbieno poudnikw [radiany] i skala w punkcie (GridFactors) lub 0
+//=======================================================================
+template <class Context>
+void TMInverse (const Context& ctx, double de, double dn, double& latRad, double& dlam, double* convergence = 0, double* scale = 0)
+{
+	if(ctx.precision == precFloat)
+	  {
+	   TMInverseFloat (ctx, de, dn, latRad, dlam, convergence, scale);
+	   return;
+	  }
+	double ok = ctx.ok;
+	const double* okPow = ctx.okPow;
+	double tmd = dn / ok;
+	double sr = ctx.sr0;
+	double ftphi = tmd / sr;
+	double t10, t11, t12, t13, t14, t15, t16, t17;
+	if(ctx.engine == engineKruger)
+	  {
+	   // Szeroko punktu podnkowego z szerokoci prostujcej mu - jedna para sin/cos zamiast iteracji
+	   double mu = tmd / ctx.ap;
+	   ftphi = mu + ClenshawSin (ctx.fpb, 5, sin (2.0 * mu), cos (2.0 * mu));
+	  }
+	  else
+	  {
+	   for(int i = 0; i < 5; i++)
+	     {
+	      t10 = sphtmd (ctx.ap, ctx.bp, ctx.cp, ctx.dp, ctx.ep, ftphi);
+	      sr = sphsr (ctx.a, ctx.eSquared, ftphi);
+	      ftphi = ftphi + (tmd - t10) / sr;
+	     }
+	  }
+	double s = sin (ftphi);
+	double c = cos (ftphi);
+	double dnm = sqrt (1.0 - ctx.eSquared * (s * s));
+	double sn = ctx.a / dnm;
+	double t = s / c;
+	double eta = ctx.e2Squared * (c * c);
+	sr = ctx.a * (1.0 - ctx.eSquared) / (dnm * dnm * dnm);
+	// precTruncated: |de| / (sn ok) - przyblienie |dlam| na szerokoci punktu podnkowego
+	double adl = ctx.precision == precTruncated ? fabs (de) / (sn * c * ok) : HUGE_VAL;
+	t11 = t12 = t13 = t15 = t16 = t17 = 0.0;
+	t10 = t / (2.0 * sr * sn * okPow[2]);
+	if(adl > ctx.truncInv[0]) t11 = t * (5.0 + 3.0 * (t * t) + eta - 4.0 * (eta * eta) - 9.0 * (t * t) * eta) / (24.0 * sr * (sn * sn * sn) * okPow[4]);
+	if(adl > ctx.truncInv[1]) t12 = t *  (61.0 + 90.0 * (t*t) + 46.0 * eta + 45.0 * (t* t * t * t) - 252.0 * (t * t) * eta - 3.0 * (eta * eta) + 100.0 * (eta * eta * eta) - 66.0 * (t * t) * (eta * eta) - 90.0 * (t * t * t * t) * eta + 88.0 * (eta * eta * eta * eta) + 225.0 * (t * t * t * t) * (eta * eta) + 84.0 * (t * t) * (eta * eta * eta) - 192.0 * (t * t) * (eta * eta * eta * eta)) / (720.0 * sr * (sn * sn * sn* sn * sn ) * okPow[6]);
+	if(adl > ctx.truncInv[2]) t13 = t * (1385.0 + 3633 * (t * t) + 4095.0 * (t * t * t * t) + 1575.0  * (t * t * t * t * t *t)) / (40320 * sr * (sn * sn * sn* sn * sn * sn * sn ) * okPow[8]);
+	latRad = ftphi - (de * de) * t10 + (de * de * de * de) * t11 - (de * de * de * de * de * de) * t12 + (de * de * de * de * de * de * de * de) * t13;
+	t14 = 1.0 / (sn * c * ok);
+	if(adl > ctx.truncInv[0]) t15 = (1.0 + 2.0 * (t * t) + eta) / (6.0 * (sn * sn * sn) * c * okPow[3]);
+	if(adl > ctx.truncInv[1]) t16 = 1.0 * (5.0 + 6.0 * eta + 28.0 * (t * t) - 3.0 * (eta * eta) + 8.0 * (t * t) * eta + 24.0 * (t * t * t * t) - 4.0 * (eta * eta * eta) + 4.0 *(t * t) * (eta * eta) + 24.0 * (t * t) * (eta * eta * eta)) / (120.0 * (sn * sn * sn * sn * sn) * c * okPow[5]);
+	if(adl > ctx.truncInv[2]) t17 = 1.0 * (61.0 + 662.0 * (t * t) + 1320.0 * (t * t * t * t) + 720.0 * (t * t * t * t * t * t)) / (5040.0 * (sn * sn * sn * sn * sn * sn * sn) * c * okPow[7]);
+	dlam = de * t14 - (de * de * de) * t15 + (de * de * de * de * de) * t16 - (de * de * de * de * de * de * de) * t17;
+	if(convergence) GridFactorsInverse (ok, ctx.e2Squared, ftphi, s, c, latRad, dlam, *convergence, *scale);
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje konwersji korzystajce z kontekstu odwzorowania
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja suy do konwersji wsprzednych elipsoidalnych B, L (lat/lon) na paskie X-northing, Y-easting odwzorowania kartograficznego UTM
+//  (stae elipsoidy pobierane z kontekstu utworzonego dla projUTM)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       pozostae argumenty jak w LatLonToUtm (double a, double f, ...)
+//=======================================================================
+void LatLonToUtm (const ProjectionContext& ctx, int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon)
+{
+	UTM_STATS_CALL (statsLatLonToUtm, 1);
+	double nfn;
+	UtmZone (lat, lon, utmXZone, utmYZone);
+	UTM_STATS_UTM_ZONES (&utmXZone, &utmYZone, 1, true);
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	if (latRad < 0.0) nfn = ctx.nfn; else nfn = 0;
+	TMForward (ctx, latRad, lonRad - UtmCentralMeridian (utmXZone), nfn, ctx.fe, easting, northing);
+	if (northing >= 9999999.0) northing = 9999999.0;
+}
+
+//=======================================================================
+//  Funkcja suy do konwersji wsprzednych elipsoidalnych B, L (lat/lon) na paskie X-northing, Y-easting odwzorowania kartograficznego 1992 lub 2000
+//  (odwzorowanie i stae elipsoidy pobierane z kontekstu utworzonego dla projPUWG1992 lub projPUWG2000)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000
+//       pozostae argumenty jak w LatLonToPUWG (double a, double f, ...)
+//=======================================================================
+void LatLonToPUWG (const ProjectionContext& ctx, double& easting, double& northing, double lat, double lon)
+{
+	UTM_STATS_CALL (statsLatLonToPUWG, 1);
+	UTM_STATS_PUWG_LON (ctx.proj == projPUWG2000, &lon, 1);
+        if(lon < 13.5 || lon > 25.5)
+         {
+		//Bdna warto dugoci geograficznej (zwracana warto 99999999999999)
+                easting=999999999999999;
+                northing=999999999999999;
+                return;
+	 }
+	int strip = 0;
+	if(ctx.proj == projPUWG2000) strip = PUWGStripFromLon (lon);
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	TMForward (ctx, latRad, lonRad - ctx.olam[strip], ctx.nfn, ctx.fe + ctx.strf[strip], easting, northing);
+}
+
+//=======================================================================
+//  Funkcja do konwersji wsprzdnych paskich X/Y UTM na elipsoidalne lat/lon
+//  (stae elipsoidy pobierane z kontekstu utworzonego dla projUTM)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       pozostae argumenty jak w UtmToLatLon (double a, double f, ...)
+//=======================================================================
+void UtmToLatLon (const ProjectionContext& ctx, int utmXZone, char utmYZone, double easting, double northing, double& lat, double& lon)
+{
+	UTM_STATS_CALL (statsUtmToLatLon, 1);
+	UTM_STATS_UTM_ZONES (&utmXZone, &utmYZone, 1, false);
+	double nfn;
+	double dlam;
+	if((utmYZone <= 'M' && utmYZone >= 'C') || (utmYZone <= 'm' && utmYZone >= 'c'))
+        {
+         nfn = ctx.nfn;
+	}
+        else
+        {
+         nfn = 0;
+	}
+	TMInverse (ctx, easting - ctx.fe, northing - nfn, lat, dlam);
+	lon = UtmCentralMeridian (utmXZone) + dlam;
+	lon *= rad2deg;
+	lat *= rad2deg;
+}
+
+//=======================================================================
+//  Funkcja do konwersji wsprzdnych paskich X/Y odwzorowania kartograficznego 1992 i 2000 na elipsoidalne lat/lon
+//  (odwzorowanie i stae elipsoidy pobierane z kontekstu utworzonego dla projPUWG1992 lub projPUWG2000)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000
+//       pozostae argumenty jak w PUWGToLatLon (double a, double f, ...)
+//=======================================================================
+void PUWGToLatLon (const ProjectionContext& ctx, double easting, double northing, double& lat, double& lon)
+{
+	UTM_STATS_CALL (statsPUWGToLatLon, 1);
+	UTM_STATS_PUWG_EASTING (ctx.proj == projPUWG2000, &easting, 1);
+	double dlam;
+	int strip = 0;
+	if(ctx.proj == projPUWG2000) strip = PUWGStripFromEasting (easting);
+	TMInverse (ctx, easting - ctx.fe - ctx.strf[strip], northing - ctx.nfn, lat, dlam);
+	lon = ctx.olam[strip] + dlam;
+	lon *= rad2deg;
+	lat *= rad2deg;
+}
+
+//------------------------------------------------------------------------------
+//  Konwersje ze zbienoci poudnikw i skal w punkcie, liczonymi w tym samym przebiegu
+//  z wielkoci porednich szeregu (sin, cos, eta, dlam). Argumenty jak w funkcjach bez
+//  zbienoci i skali (te same wyniki X/Y lub lat/lon), dodatkowo:
+//       double& convergence: zbieno poudnikw - kt od pnocy geograficznej do osi X
+//                            (dodatni na wschd od poudnika osiowego na pkuli pnocnej) [stopnie]
+//       double& scale: skala w punkcie
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y UTM ze zbienoci poudnikw i skal
+//=======================================================================
+void LatLonToUtmFactors (const ProjectionContext& ctx, int& utmXZone, char& utmYZone, double& easting, double& northing, double& convergence, double& scale, double lat, double lon)
+{
+	UTM_STATS_CALL (statsLatLonToUtm, 1);
+	double nfn;
+	UtmZone (lat, lon, utmXZone, utmYZone);
+	UTM_STATS_UTM_ZONES (&utmXZone, &utmYZone, 1, true);
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	if (latRad < 0.0) nfn = ctx.nfn; else nfn = 0;
+	TMForward (ctx, latRad, lonRad - UtmCentralMeridian (utmXZone), nfn, ctx.fe, easting, northing, &convergence, &scale);
 	if (northing >= 9999999.0) northing = 9999999.0;
+	convergence *= rad2deg;
+}
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y 1992 lub 2000 ze zbienoci poudnikw i skal
+//  (dla dugoci spoza zakresu 13.5 - 25.5 wszystkie wyniki rwne 999999999999999)
+//=======================================================================
+void LatLonToPUWGFactors (const ProjectionContext& ctx, double& easting, double& northing, double& convergence, double& scale, double lat, double lon)
+{
+	UTM_STATS_CALL (statsLatLonToPUWG, 1);
+	UTM_STATS_PUWG_LON (ctx.proj == projPUWG2000, &lon, 1);
+	if(lon < 13.5 || lon > 25.5)
+	  {
+	   easting = northing = convergence = scale = 999999999999999;
+	   return;
+	  }
+	int strip = 0;
+	if(ctx.proj == projPUWG2000) strip = PUWGStripFromLon (lon);
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	TMForward (ctx, latRad, lonRad - ctx.olam[strip], ctx.nfn, ctx.fe + ctx.strf[strip], easting, northing, &convergence, &scale);
+	convergence *= rad2deg;
+}
+
+//=======================================================================
+//  Konwersja X/Y UTM -> lat/lon ze zbienoci poudnikw i skal
+//=======================================================================
+void UtmToLatLonFactors (const ProjectionContext& ctx, int utmXZone, char utmYZone, double easting, double northing, double& lat, double& lon, double& convergence, double& scale)
+{
+	UTM_STATS_CALL (statsUtmToLatLon, 1);
+	UTM_STATS_UTM_ZONES (&utmXZone, &utmYZone, 1, false);
+	double nfn = ((utmYZone <= 'M' && utmYZone >= 'C') || (utmYZone <= 'm' && utmYZone >= 'c')) ? ctx.nfn : 0;
+	double dlam;
+	TMInverse (ctx, easting - ctx.fe, northing - nfn, lat, dlam, &convergence, &scale);
+	lon = UtmCentralMeridian (utmXZone) + dlam;
+	lon *= rad2deg;
+	lat *= rad2deg;
+	convergence *= rad2deg;
+}
+
+//=======================================================================
+//  Konwersja X/Y 1992 lub 2000 -> lat/lon ze zbienoci poudnikw i skal
+//=======================================================================
+void PUWGToLatLonFactors (const ProjectionContext& ctx, double easting, double northing, double& lat, double& lon, double& convergence, double& scale)
+{
+	UTM_STATS_CALL (statsPUWGToLatLon, 1);
+	UTM_STATS_PUWG_EASTING (ctx.proj == projPUWG2000, &easting, 1);
+	double dlam;
+	int strip = 0;
+	if(ctx.proj == projPUWG2000) strip = PUWGStripFromEasting (easting);
+	TMInverse (ctx, easting - ctx.fe - ctx.strf[strip], northing - ctx.nfn, lat, dlam, &convergence, &scale);
+	lon = ctx.olam[strip] + dlam;
+	lon *= rad2deg;
+	lat *= rad2deg;
+	convergence *= rad2deg;
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje konwersji dla dowolnej elipsoidy
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja suy do konwersji wsprzednych elipsoidalnych B, L (lat/lon) na paskie X-northing, Y-easting odwzorowania kartograficznego UTM (dla dowolnej elipsoidy)
+//=======================================================================
+//      Argumenty wejciowe i wyjciowe:
+//      --------------------------------
+//       double a: dugo duej posi elipsoidy odniesienia, w metrach (np. dla elipsoidy WGS 84, 6378137.0)
+//       double f: spaszczenie elipsoidalne (np. dla elipsoidy WGS 84, 1 / 298.257223563)
+//       int& utmXZone: nr strefy UTM wg. podziau poudnikowego (zwracane numery od 1 do 60, kada strefa ma sze stopni)
+//       char& utmYZone: nr strefy wg. podziau rwnolenikowego (zwracane wartoci: CDEFGHJKLMNPQRSTUVWX)
+//       double& easting: wsprzdna Y UTM, w metrach po konwersji [metry]
+//       double& northing: wsprzdna X UTM, w metrach po konwersji [metry]
+//       double lat, double lon: wsprzdne lat/lon do konwersji [stopnie]
+//=======================================================================
+void LatLonToUtm (double a, double f, int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon)
+{
+	ProjectionContext ctx = CreateProjectionContext (a, f, projUTM);
+	LatLonToUtm (ctx, utmXZone, utmYZone, easting, northing, lat, lon);
 }
 
 //=======================================================================
@@ -173,104 +768,8 @@ void LatLonToUtm (double a, double f, int& utmXZone, char& utmYZone, double& eas
 //=======================================================================
 void LatLonToPUWG (double a, double f, double& easting, double& northing, double lat, double lon, int proj)
 {
-        // Wspczynnik znieksztacenia skli mapy w poudniku osiowym dla odwzorowania kartograficznego 2000
-        double ok =  0.999923;
-        //Wspczynnik znieksztacenia skli mapy w poudniku osiowym dla odwzorowania kartograficznego 1992
-        if(proj==1) ok =  0.9993;
-	double recf;
-	double b;
-	double eSquared;
-	double e2Squared;
-	double tn;
-	double ap;
-	double bp;
-	double cp;
-	double dp;
-	double ep;
-	double olam;
-	double dlam;
-	double s;
-	double c;
-	double t;
-	double eta;
-	double sn;
-	double tmd;
-	double t1, t2, t3, t4, t5,  t6, t7, t8, t9;
-	double nfn;
-        double strf;
-        if(lon < 13.5 || lon > 25.5)
-         {
-		//Bdna warto dugoci geograficznej (zwracana warto 99999999999999)
-                easting=999999999999999;
-                northing=999999999999999;
-                return;
-	 }
-         else
-         {
-           if(proj==1)
-             {
-              olam = 19.0 * deg2rad;
-              strf = 0.0;
-              nfn = -5300000.0;
-             }
-             else
-             {
-              nfn = 0;
-              if(lon >= 13.5 && lon < 16.5)
-               {
-                olam = 15.0 * deg2rad;
-                strf = 5000000.0;
-               }
-
-              if(lon >= 16.5 && lon < 19.5)
-               {
-                olam = 18.0 * deg2rad;
-                strf = 6000000.0;
-               }
-
-              if(lon >= 19.5 && lon < 22.5)
-               {
-                olam = 21.0 * deg2rad;
-                strf = 7000000.0;
-               }
-
-              if(lon >= 22.5 && lon < 25.5)
-               {
-                olam = 24.0 * deg2rad;
-                strf = 8000000.0;
-               }
-             }
-         }
-	double latRad = lat * deg2rad;
-	double lonRad = lon * deg2rad;
-	recf = 1.0 / f;
-	b = a * (recf - 1.0) / recf;
-	eSquared = CalculateESquared (a, b);
-	e2Squared = CalculateE2Squared (a, b);
-	tn = (a - b) / (a + b);
-	ap = a * (1.0 - tn + 5.0 * ((tn * tn) - (tn * tn * tn)) / 4.0 + 81.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 64.0);
-	bp = 3.0 * a * (tn - (tn * tn) + 7.0 * ((tn * tn * tn) - (tn * tn * tn * tn)) / 8.0 + 55.0 * (tn * tn * tn * tn * tn) / 64.0) / 2.0;
-	cp = 15.0 * a * ((tn * tn) - (tn * tn * tn) + 3.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 4.0) / 16.0;
-	dp = 35.0 * a * ((tn * tn * tn) - (tn * tn * tn * tn) + 11.0 * (tn * tn * tn * tn * tn) / 16.0) / 48.0;
-	ep = 315.0 * a * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 512.0;
-	dlam = lonRad - olam;
-	s = sin (latRad);
-	c = cos (latRad);
-	t = s / c;
-	eta = e2Squared * (c * c);
-	sn = sphsn (a, eSquared, latRad);
-	tmd = sphtmd (ap, bp, cp, dp, ep, latRad);
-	t1 = tmd * ok;
-	t2 = sn * s * c * ok / 2.0;
-	t3 = sn * s * (c * c * c) * ok * (5.0 - (t * t) + 9.0 * eta + 4.0 * (eta * eta)) / 24.0;
-        t4 = sn * s * (c * c * c * c * c) * ok * (61.0 - 58.0 * (t * t) + (t * t * t * t) + 270.0 * eta - 330.0 * (t * t) * eta + 445.0 * (eta * eta) + 324.0 * (eta * eta * eta) - 680.0 * (t * t) * (eta * eta) + 88.0 * (eta * eta * eta * eta) - 600.0 * (t * t) * (eta * eta * eta) - 192.0 * (t * t) * (eta * eta * eta * eta)) / 720.0;
-        t5 = sn * s * (c * c * c * c * c * c * c) * ok * (1385.0 - 3111.0 * (t * t) + 543.0 * (t * t * t * t) - (t * t * t * t * t * t)) / 40320.0;
-	northing = nfn + t1 + (dlam * dlam) * t2 + (dlam * dlam * dlam * dlam) * t3 + (dlam * dlam * dlam * dlam * dlam * dlam) * t4 + (dlam * dlam * dlam * dlam * dlam * dlam * dlam * dlam) * t5;
-	t6 = sn * c * ok;
-	t7 = sn * (c * c * c) * ok * (1.0 - (t * t) + eta) / 6.0;
-        t8 = sn * (c * c * c * c * c) * ok * (5.0 - 18.0 * (t * t) + (t * t * t * t) + 14.0 * eta - 58.0 * (t * t) * eta + 13.0 * (eta * eta) + 4.0 * (eta * eta * eta) - 64.0 * (t * t) * (eta * eta) - 24.0 * (t * t) * (eta * eta * eta)) / 120.0;
-        t9 = sn * (c * c * c * c * c * c * c) * ok * (61.0 - 479.0 * (t * t) + 179.0 *  (t * t * t * t) - (t * t * t * t * t * t)) / 5040.0;
-	easting = fe + strf + dlam * t6 + (dlam * dlam * dlam) * t7  + (dlam * dlam * dlam * dlam * dlam) * t8 + (dlam * dlam * dlam * dlam * dlam * dlam * dlam) * t9;// + 0.5;
+	ProjectionContext ctx = CreateProjectionContext (a, f, proj == 1 ? projPUWG1992 : projPUWG2000);
+	LatLonToPUWG (ctx, easting, northing, lat, lon);
 }
 
 
@@ -292,79 +791,8 @@ void LatLonToPUWG (double a, double f, double& easting, double& northing, double
 //=======================================================================
 void UtmToLatLon (double a, double f, int utmXZone, char utmYZone, double easting, double northing, double& lat, double& lon)
 {
-        // Wspczynnik znieksztacenia skli mapy w poudniku osiowym dla odwzorowania kartograficznego UTM
-        static const double ok = 0.9996;
-	double recf;
-	double b;
-	double eSquared;
-	double e2Squared;
-	double tn;
-	double ap;
-	double bp;
-	double cp;
-	double dp;
-	double ep;
-	double nfn;
-	double tmd;
-	double sr;
-	double sn;
-	double ftphi;
-	double s;
-	double c;
-	double t;
-	double eta;
-	double de;
-	double dlam;
-	double olam;
-	recf = 1.0 / f;
-	b = a * (recf - 1) / recf;
-	eSquared = CalculateESquared (a, b);
-	e2Squared = CalculateE2Squared (a, b);
-	tn = (a - b) / (a + b);
-	ap = a * (1.0 - tn + 5.0 * ((tn * tn) - (tn * tn * tn)) / 4.0 + 81.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 64.0);
-	bp = 3.0 * a * (tn - (tn * tn) + 7.0 * ((tn * tn * tn) - (tn * tn * tn * tn)) / 8.0 + 55.0 * (tn * tn * tn * tn * tn) / 64.0) / 2.0;
-	cp = 15.0 * a * ((tn * tn) - (tn * tn * tn) + 3.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 4.0) / 16.0;
-	dp = 35.0 * a * ((tn * tn * tn) - (tn * tn * tn * tn) + 11.0 * (tn * tn * tn * tn * tn) / 16.0) / 48.0;
-	ep = 315.0 * a * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 512.0;
-	if((utmYZone <= 'M' && utmYZone >= 'C') || (utmYZone <= 'm' && utmYZone >= 'c'))
-        {
-         nfn = 10000000.0;
-	}
-        else
-        {
-         nfn = 0;
-	}
-	tmd = (northing - nfn) / ok;
-	sr = sphsr (a, eSquared, 0.0);
-	ftphi = tmd / sr;
-	double t10, t11, t12, t13, t14, t15, t16, t17;
-	for(int i = 0; i < 5; i++)
-        {
-         t10 = sphtmd (ap, bp, cp, dp, ep, ftphi);
-         sr = sphsr (a, eSquared, ftphi);
-         ftphi = ftphi + (tmd - t10) / sr;
-	}
-	sr = sphsr (a, eSquared, ftphi);
-	sn = sphsn (a, eSquared, ftphi);
-	s = sin (ftphi);
-	c = cos (ftphi);
-	t = s / c;
-	eta = e2Squared * (c * c);
-	de = easting - fe;
-	t10 = t / (2.0 * sr * sn * (ok * ok));
-	t11 = t * (5.0 + 3.0 * (t * t) + eta - 4.0 * (eta * eta) - 9.0 * (t * t) * eta) / (24.0 * sr * (sn * sn * sn) * (ok * ok * ok * ok));
-        t12 = t *  (61.0 + 90.0 * (t*t) + 46.0 * eta + 45.0 * (t* t * t * t) - 252.0 * (t * t) * eta - 3.0 * (eta * eta) + 100.0 * (eta * eta * eta) - 66.0 * (t * t) * (eta * eta) - 90.0 * (t * t * t * t) * eta + 88.0 * (eta * eta * eta * eta) + 225.0 * (t * t * t * t) * (eta * eta) + 84.0 * (t * t) * (eta * eta * eta) - 192.0 * (t * t) * (eta * eta * eta * eta)) / (720.0 * sr * (sn * sn * sn* sn * sn ) * (ok * ok * ok * ok * ok * ok));
-        t13 = t * (1385.0 + 3633 * (t * t) + 4095.0 * (t * t * t * t) + 1575.0  * (t * t * t * t * t *t)) / (40320 * sr * (sn * sn * sn* sn * sn * sn * sn ) * (ok * ok * ok * ok * ok * ok * ok * ok));
-	lat = ftphi - (de * de) * t10 + (de * de * de * de) * t11 - (de * de * de * de * de * de) * t12 + (de * de * de * de * de * de * de * de) * t13;
-	t14 = 1.0 / (sn * c * ok);
-	t15 = (1.0 + 2.0 * (t * t) + eta) / (6.0 * (sn * sn * sn) * c * (ok * ok * ok));
-        t16 = 1.0 * (5.0 + 6.0 * eta + 28.0 * (t * t) - 3.0 * (eta * eta) + 8.0 * (t * t) * eta + 24.0 * (t * t * t * t) - 4.0 * (eta * eta * eta) + 4.0 *(t * t) * (eta * eta) + 24.0 * (t * t) * (eta * eta * eta)) / (120.0 * (sn * sn * sn * sn * sn) * c * (ok * ok * ok * ok * ok));
-        t17 = 1.0 * (61.0 + 662.0 * (t * t) + 1320.0 * (t * t * t * t) + 720.0 * (t * t * t * t * t * t)) / (5040.0 * (sn * sn * sn * sn * sn * sn * sn) * c * (ok * ok * ok * ok * ok * ok * ok));
-	dlam = de * t14 - (de * de * de) * t15 + (de * de * de * de * de) * t16 - (de * de * de * de * de * de * de) * t17;
-	olam = (utmXZone * 6 - 183.0) * deg2rad;
-	lon = olam + dlam;
-	lon *= rad2deg;
-	lat *= rad2deg;
+	ProjectionContext ctx = CreateProjectionContext (a, f, projUTM);
+	UtmToLatLon (ctx, utmXZone, utmYZone, easting, northing, lat, lon);
 }
 
 //=======================================================================
@@ -378,106 +806,8 @@ void UtmToLatLon (double a, double f, int utmXZone, char utmYZone, double eastin
 //=======================================================================
 void PUWGToLatLon (double a, double f, double easting, double northing, int proj, double& lat, double& lon)
 {
-
-//uklad 2000
-double ok =  0.999923;
-//uklad 1992 dla skal mniejszych 1:10000
-if(proj==1)
- ok =  0.9993;
-
-	double recf;
-	double b;
-	double eSquared;
-	double e2Squared;
-	double tn;
-	double ap;
-	double bp;
-	double cp;
-	double dp;
-	double ep;
-	double nfn;
-	double tmd;
-	double sr;
-	double sn;
-	double ftphi;
-	double s;
-	double c;
-	double t;
-	double eta;
-	double de;
-	double dlam;
-	double olam;
-        double strf;
-	recf = 1.0 / f;
-	b = a * (recf - 1) / recf;
-	eSquared = CalculateESquared (a, b);
-	e2Squared = CalculateE2Squared (a, b);
-	tn = (a - b) / (a + b);
-	ap = a * (1.0 - tn + 5.0 * ((tn * tn) - (tn * tn * tn)) / 4.0 + 81.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 64.0);
-	bp = 3.0 * a * (tn - (tn * tn) + 7.0 * ((tn * tn * tn) - (tn * tn * tn * tn)) / 8.0 + 55.0 * (tn * tn * tn * tn * tn) / 64.0) / 2.0;
-	cp = 15.0 * a * ((tn * tn) - (tn * tn * tn) + 3.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 4.0) / 16.0;
-	dp = 35.0 * a * ((tn * tn * tn) - (tn * tn * tn * tn) + 11.0 * (tn * tn * tn * tn * tn) / 16.0) / 48.0;
-	ep = 315.0 * a * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 512.0;
-        if(proj==1)
-          {
-           olam = 19.0 * deg2rad;
-           strf = 0.0;
-           nfn = -5300000.0;
-          }
-          else
-          {
-           nfn = 0;
-              if(easting<6000000.0 && easting>5000000.0)
-               {
-               strf = 5000000.0;
-               olam = 15.0 * deg2rad;
-               }
-              if(easting<7000000.0 && easting>6000000.0)
-               {
-                strf = 6000000.0;
-                olam = 18.0 * deg2rad;
-               }
-              if(easting<8000000.0 && easting>7000000.0)
-               {
-                strf = 7000000.0;
-                olam = 21.0 * deg2rad;
-               }
-              if(easting<9000000.0 && easting>8000000.0)
-               {
-                strf = 8000000.0;
-                olam = 24.0 * deg2rad;
-               }
-             }
-	tmd = (northing - nfn) / ok;
-	sr = sphsr (a, eSquared, 0.0);
-	ftphi = tmd / sr;
-	double t10, t11, t12, t13, t14, t15, t16, t17;
-	for (int i = 0; i < 5; i++)
-        {
-         t10 = sphtmd (ap, bp, cp, dp, ep, ftphi);
-         sr = sphsr (a, eSquared, ftphi);
-         ftphi = ftphi + (tmd - t10) / sr;
-	}
-	sr = sphsr (a, eSquared, ftphi);
-	sn = sphsn (a, eSquared, ftphi);
-	s = sin (ftphi);
-	c = cos (ftphi);
-	t = s / c;
-	eta = e2Squared * (c * c);
-	de = easting - fe - strf;
-	t10 = t / (2.0 * sr * sn * (ok * ok));
-	t11 = t * (5.0 + 3.0 * (t * t) + eta - 4.0 * (eta * eta) - 9.0 * (t * t) * eta) / (24.0 * sr * (sn * sn * sn) * (ok * ok * ok * ok));
-        t12 = t *  (61.0 + 90.0 * (t*t) + 46.0 * eta + 45.0 * (t* t * t * t) - 252.0 * (t * t) * eta - 3.0 * (eta * eta) + 100.0 * (eta * eta * eta) - 66.0 * (t * t) * (eta * eta) - 90.0 * (t * t * t * t) * eta + 88.0 * (eta * eta * eta * eta) + 225.0 * (t * t * t * t) * (eta * eta) + 84.0 * (t * t) * (eta * eta * eta) - 192.0 * (t * t) * (eta * eta * eta * eta)) / (720.0 * sr * (sn * sn * sn* sn * sn ) * (ok * ok * ok * ok * ok * ok));
-        t13 = t * (1385.0 + 3633 * (t * t) + 4095.0 * (t * t * t * t) + 1575.0  * (t * t * t * t * t *t)) / (40320 * sr * (sn * sn * sn* sn * sn * sn * sn ) * (ok * ok * ok * ok * ok * ok * ok * ok));
-	lat = ftphi - (de * de) * t10 + (de * de * de * de) * t11 - (de * de * de * de * de * de) * t12 + (de * de * de * de * de * de * de * de) * t13;
-	t14 = 1.0 / (sn * c * ok);
-	t15 = (1.0 + 2.0 * (t * t) + eta) / (6.0 * (sn * sn * sn) * c * (ok * ok * ok));
-        t16 = 1.0 * (5.0 + 6.0 * eta + 28.0 * (t * t) - 3.0 * (eta * eta) + 8.0 * (t * t) * eta + 24.0 * (t * t * t * t) - 4.0 * (eta * eta * eta) + 4.0 *(t * t) * (eta * eta) + 24.0 * (t * t) * (eta * eta * eta)) / (120.0 * (sn * sn * sn * sn * sn) * c * (ok * ok * ok * ok * ok));
-        t17 = 1.0 * (61.0 + 662.0 * (t * t) + 1320.0 * (t * t * t * t) + 720.0 * (t * t * t * t * t * t)) / (5040.0 * (sn * sn * sn * sn * sn * sn * sn) * c * (ok * ok * ok * ok * ok * ok * ok));
-	dlam = de * t14 - (de * de * de) * t15 + (de * de * de * de * de) * t16 - (de * de * de * de * de * de * de) * t17;
-	lon = olam + dlam;
-	lon *= rad2deg;
-	lat *= rad2deg;
+	ProjectionContext ctx = CreateProjectionContext (a, f, proj == 1 ? projPUWG1992 : projPUWG2000);
+	PUWGToLatLon (ctx, easting, northing, lat, lon);
 }
 
 
@@ -492,12 +822,26 @@ if(proj==1)
 ////////////////////////////////////////////////////////////////////////////////
 //------------------------------------------------------------------------------
 
+//Konteksty WGS 84 dla wszystkich odwzorowa, metod i poziomw dokadnoci
+struct WGS84Contexts
+{
+	ProjectionContext ctx[3][2][3];
+	WGS84Contexts ()
+	{
+		for(int p = 0; p < 3; p++)
+		  for(int e = 0; e < 2; e++)
+		    for(int r = 0; r < 3; r++)
+		      ctx[r][e][p] = CreateProjectionContext (6378137.0, 1 / 298.257223563, (ProjectionType)p, (ProjectionEngine)e, (ProjectionPrecision)r);
+	}
+};
+
 //==============================================================================
-// Funkcja do konwersji wsprzdnych X/Y 1992 lub 2000 na lat/lon elipsoide WGS 84
+// Funkcja zwraca kontekst odwzorowania dla elipsoidy WGS 84 (wyznaczany jednorazowo, przy pierwszym wywoaniu)
 //==============================================================================
-void PUWGToLatLonWGS84(double easting, double northing, int proj, double& lat, double& lon)
+const ProjectionContext& WGS84Context (ProjectionType proj, ProjectionEngine engine = engineClassic, ProjectionPrecision precision = precFull)
     {
-    PUWGToLatLon (6378137.0, 1 / 298.257223563, easting, northing, proj, lat, lon);
+    static const WGS84Contexts all;
+    return all.ctx[precision][engine][proj];
     }
 
 //==============================================================================
@@ -505,7 +849,7 @@ void PUWGToLatLonWGS84(double easting, double northing, int proj, double& lat, d
 //==============================================================================
 void LatLonToUtmWGS84(int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon)
    {
-   LatLonToUtm (6378137.0, 1 / 298.257223563, utmXZone, utmYZone, easting, northing, lat, lon);
+   LatLonToUtm (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon);
    }
 
 //==============================================================================
@@ -514,7 +858,7 @@ void LatLonToUtmWGS84(int& utmXZone, char& utmYZone, double& easting, double& no
 void LatLonToPUWGWGS84(double& easting, double& northing, double lat, double lon, int proj)
    {
    //proj = 1 - dla odwzorowania kartograficznego 1992, kada inna warto dla 2000
-   LatLonToPUWG (6378137.0, 1 / 298.257223563, easting, northing, lat, lon, proj);
+   LatLonToPUWG (WGS84Context (proj == 1 ? projPUWG1992 : projPUWG2000), easting, northing, lat, lon);
    }
 
 //==============================================================================
@@ -522,7 +866,7 @@ void LatLonToPUWGWGS84(double& easting, double& northing, double lat, double lon
 //==============================================================================
 void UtmToLatLonWGS84(int utmXZone, char utmYZone, double easting, double northing, double& lat, double& lon)
    {
-   UtmToLatLon (6378137.0, 1 / 298.257223563, utmXZone, utmYZone, easting, northing, lat, lon);
+   UtmToLatLon (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon);
    }
 
 //==============================================================================
@@ -530,7 +874,30 @@ void UtmToLatLonWGS84(int utmXZone, char utmYZone, double easting, double northi
 //==============================================================================
 void PUWGToLatLonWGS84 (double easting, double northing, int proj, double& lat, double& lon)
    {
-   PUWGToLatLon(6378137.0, 1 / 298.257223563, easting, northing, proj, lat, lon);
+   PUWGToLatLon (WGS84Context (proj == 1 ? projPUWG1992 : projPUWG2000), easting, northing, lat, lon);
+   }
+
+//==============================================================================
+// Funkcje do konwersji WGS 84 ze zbienoci poudnikw [stopnie] i skal w punkcie
+//==============================================================================
+void LatLonToUtmFactorsWGS84(int& utmXZone, char& utmYZone, double& easting, double& northing, double& convergence, double& scale, double lat, double lon)
+   {
+   LatLonToUtmFactors (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, convergence, scale, lat, lon);
+   }
+
+void LatLonToPUWGFactorsWGS84(double& easting, double& northing, double& convergence, double& scale, double lat, double lon, int proj)
+   {
+   LatLonToPUWGFactors (WGS84Context (proj == 1 ? projPUWG1992 : projPUWG2000), easting, northing, convergence, scale, lat, lon);
+   }
+
+void UtmToLatLonFactorsWGS84(int utmXZone, char utmYZone, double easting, double northing, double& lat, double& lon, double& convergence, double& scale)
+   {
+   UtmToLatLonFactors (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon, convergence, scale);
+   }
+
+void PUWGToLatLonFactorsWGS84 (double easting, double northing, int proj, double& lat, double& lon, double& convergence, double& scale)
+   {
+   PUWGToLatLonFactors (WGS84Context (proj == 1 ? projPUWG1992 : projPUWG2000), easting, northing, lat, lon, convergence, scale);
    }
 
 #endif
@@ -0,0 +1,331 @@
+/*
+Konwersje wsadowe (tablice lat/lon lub easting/northing) dla odwzorowa UTM, 1992, 2000
+Wersje wektorowe AVX2 / AVX-512 wybierane w czasie dziaania, z wersj skalarn jako rezerwow.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Batch_H
+#define Unit_UTM_1992_2000_Batch_H
+
+#include <stddef.h>
+#include "UTM_1992_2000.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Status konwersji pojedynczego punktu (tablica status, jeden bajt na punkt)
+enum ConversionStatus
+{
+	statusOK = 0,
+	statusLonOutOfRange = 1,   // dugo geograficzna poza zakresem 13.5 - 25.5 (1992, 2000), wynik 999999999999999
+	statusLatOutOfRange = 2,   // szeroko geograficzna poza zakresem -80 - 84 (UTM), strefa '*'
+	statusFormatError = 3      // bdny zapis wsprzdnych (np. MGRS), wynik 999999999999999
+};
+
+//Wersja jdra obliczeniowego konwersji wsadowych
+enum BatchKernel
+{
+	kernelAuto,      // najszybsza wersja dostpna na danym procesorze
+	kernelScalar,    // ptla po funkcjach skalarnych (wyniki identyczne z LatLonToPUWG, UtmToLatLon itd.)
+	kernelAvx2,
+	kernelAvx512
+};
+
+#include "UTM_1992_2000_Simd.h"
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//==============================================================================
+// Funkcja zwraca wersj jdra, ktra zostanie uyta dla danej wersji kernel
+// (kernelAuto lub wersja niedostpna na danym procesorze - najszybsza dostpna)
+//==============================================================================
+BatchKernel ResolveBatchKernel (BatchKernel kernel)
+{
+	if(kernel == kernelScalar) return kernelScalar;
+#ifdef UTM_1992_2000_SIMD
+	static const bool avx512 = __builtin_cpu_supports ("avx512f");
+	static const bool avx2 = __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+	if(avx512 && (kernel == kernelAuto || kernel == kernelAvx512)) return kernelAvx512;
+	if(avx2) return kernelAvx2;
+#endif
+	return kernelScalar;
+}
+
+//Wersje skalarne (rezerwowe) konwersji wsadowych
+void LatLonToUtmScalar (const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status)
+{
+	for(size_t i = 0; i < count; i++)
+	  {
+	   LatLonToUtm (ctx, utmXZone[i], utmYZone[i], easting[i], northing[i], lat[i], lon[i]);
+	   if(status) status[i] = utmYZone[i] != '*' ? statusOK : statusLatOutOfRange;
+	  }
+}
+
+void LatLonToPUWGScalar (const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status)
+{
+	for(size_t i = 0; i < count; i++)
+	  {
+	   bool valid = lon[i] >= 13.5 && lon[i] <= 25.5;
+	   if(valid)
+	     {
+	      LatLonToPUWG (ctx, easting[i], northing[i], lat[i], lon[i]);
+	     }
+	     else
+	     {
+	      easting[i] = 999999999999999;
+	      northing[i] = 999999999999999;
+	     }
+	   if(status) status[i] = valid ? statusOK : statusLonOutOfRange;
+	  }
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon -> X/Y UTM (odpowiednik LatLonToUtm dla count punktw)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       int* utmXZone, char* utmYZone: strefy UTM po konwersji (count elementw)
+//       double* easting, double* northing: wsprzdne Y, X UTM po konwersji [metry]
+//       const double* lat, const double* lon: wsprzdne lat/lon do konwersji [stopnie]
+//       size_t count: liczba punktw
+//       unsigned char* status: status konwersji kadego punktu (ConversionStatus) lub 0
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+void LatLonToUtmBatch (const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsLatLonToUtmBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::LatLonToUtmKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count, status); break;
+	   case kernelAvx2: SimdAvx2::LatLonToUtmKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count, status); break;
+#endif
+	   default: LatLonToUtmScalar (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count, status); break;
+	  }
+	UTM_STATS_UTM_ZONES (utmXZone, utmYZone, count, true);
+}
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon -> X/Y 1992 lub 2000 (odpowiednik LatLonToPUWG dla count punktw)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000
+//       double* easting, double* northing: wsprzdne Y, X po konwersji [metry]
+//       const double* lat, const double* lon: wsprzdne lat/lon do konwersji [stopnie]
+//       size_t count: liczba punktw
+//       unsigned char* status: status konwersji kadego punktu (ConversionStatus) lub 0
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+void LatLonToPUWGBatch (const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsLatLonToPUWGBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::LatLonToPUWGKernel (ctx, easting, northing, lat, lon, count, status); break;
+	   case kernelAvx2: SimdAvx2::LatLonToPUWGKernel (ctx, easting, northing, lat, lon, count, status); break;
+#endif
+	   default: LatLonToPUWGScalar (ctx, easting, northing, lat, lon, count, status); break;
+	  }
+	UTM_STATS_PUWG_LON (ctx.proj == projPUWG2000, lon, count);
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y UTM -> lat/lon (odpowiednik UtmToLatLon dla count punktw)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       const int* utmXZone, const char* utmYZone: strefy UTM punktw
+//       const double* easting, const double* northing: wsprzdne Y, X UTM do konwersji [metry]
+//       double* lat, double* lon: wsprzdne lat/lon po konwersji [stopnie]
+//       size_t count: liczba punktw
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+void UtmToLatLonBatch (const ProjectionContext& ctx, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, size_t count, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsUtmToLatLonBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::UtmToLatLonKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count); break;
+	   case kernelAvx2: SimdAvx2::UtmToLatLonKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        UtmToLatLon (ctx, utmXZone[i], utmYZone[i], easting[i], northing[i], lat[i], lon[i]);
+	       }
+	     break;
+	  }
+	UTM_STATS_UTM_ZONES (utmXZone, utmYZone, count, false);
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y 1992 lub 2000 -> lat/lon (odpowiednik PUWGToLatLon dla count punktw)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000
+//       const double* easting, const double* northing: wsprzdne Y, X do konwersji [metry]
+//       double* lat, double* lon: wsprzdne lat/lon po konwersji [stopnie]
+//       size_t count: liczba punktw
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+void PUWGToLatLonBatch (const ProjectionContext& ctx, const double* easting, const double* northing, double* lat, double* lon, size_t count, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsPUWGToLatLonBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::PUWGToLatLonKernel (ctx, easting, northing, lat, lon, count); break;
+	   case kernelAvx2: SimdAvx2::PUWGToLatLonKernel (ctx, easting, northing, lat, lon, count); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        PUWGToLatLon (ctx, easting[i], northing[i], lat[i], lon[i]);
+	       }
+	     break;
+	  }
+	UTM_STATS_PUWG_EASTING (ctx.proj == projPUWG2000, easting, count);
+}
+
+//------------------------------------------------------------------------------
+//  Konwersje wsadowe ze zbienoci poudnikw i skal w punkcie (odpowiedniki LatLonToUtmFactors itd.),
+//  liczonymi w tym samym przebiegu co wsprzdne. Argumenty jak w konwersjach wsadowych bez
+//  zbienoci i skali (te same wyniki X/Y lub lat/lon), dodatkowo:
+//       double* convergence: zbieno poudnikw po konwersji [stopnie] (count elementw)
+//       double* scale: skala w punkcie po konwersji (count elementw)
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon -> X/Y UTM ze zbienoci poudnikw i skal
+//=======================================================================
+void LatLonToUtmFactorsBatch (const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, double* convergence, double* scale, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsLatLonToUtmBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::LatLonToUtmKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count, status, convergence, scale); break;
+	   case kernelAvx2: SimdAvx2::LatLonToUtmKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count, status, convergence, scale); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        LatLonToUtmFactors (ctx, utmXZone[i], utmYZone[i], easting[i], northing[i], convergence[i], scale[i], lat[i], lon[i]);
+	        if(status) status[i] = utmYZone[i] != '*' ? statusOK : statusLatOutOfRange;
+	       }
+	     break;
+	  }
+	UTM_STATS_UTM_ZONES (utmXZone, utmYZone, count, true);
+}
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon -> X/Y 1992 lub 2000 ze zbienoci poudnikw i skal
+//  (dla dugoci spoza zakresu 13.5 - 25.5 wszystkie wyniki rwne 999999999999999)
+//=======================================================================
+void LatLonToPUWGFactorsBatch (const ProjectionContext& ctx, double* easting, double* northing, double* convergence, double* scale, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsLatLonToPUWGBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::LatLonToPUWGKernel (ctx, easting, northing, lat, lon, count, status, convergence, scale); break;
+	   case kernelAvx2: SimdAvx2::LatLonToPUWGKernel (ctx, easting, northing, lat, lon, count, status, convergence, scale); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        // LatLonToPUWGFactors wypenia wyniki wartoci 999999999999999 dla dugoci spoza zakresu
+	        LatLonToPUWGFactors (ctx, easting[i], northing[i], convergence[i], scale[i], lat[i], lon[i]);
+	        if(status) status[i] = lon[i] >= 13.5 && lon[i] <= 25.5 ? statusOK : statusLonOutOfRange;
+	       }
+	     break;
+	  }
+	UTM_STATS_PUWG_LON (ctx.proj == projPUWG2000, lon, count);
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y UTM -> lat/lon ze zbienoci poudnikw i skal
+//=======================================================================
+void UtmToLatLonFactorsBatch (const ProjectionContext& ctx, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, double* convergence, double* scale, size_t count, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsUtmToLatLonBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::UtmToLatLonKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count, convergence, scale); break;
+	   case kernelAvx2: SimdAvx2::UtmToLatLonKernel (ctx, utmXZone, utmYZone, easting, northing, lat, lon, count, convergence, scale); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        UtmToLatLonFactors (ctx, utmXZone[i], utmYZone[i], easting[i], northing[i], lat[i], lon[i], convergence[i], scale[i]);
+	       }
+	     break;
+	  }
+	UTM_STATS_UTM_ZONES (utmXZone, utmYZone, count, false);
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y 1992 lub 2000 -> lat/lon ze zbienoci poudnikw i skal
+//=======================================================================
+void PUWGToLatLonFactorsBatch (const ProjectionContext& ctx, const double* easting, const double* northing, double* lat, double* lon, double* convergence, double* scale, size_t count, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsPUWGToLatLonBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::PUWGToLatLonKernel (ctx, easting, northing, lat, lon, count, convergence, scale); break;
+	   case kernelAvx2: SimdAvx2::PUWGToLatLonKernel (ctx, easting, northing, lat, lon, count, convergence, scale); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        PUWGToLatLonFactors (ctx, easting[i], northing[i], lat[i], lon[i], convergence[i], scale[i]);
+	       }
+	     break;
+	  }
+	UTM_STATS_PUWG_EASTING (ctx.proj == projPUWG2000, easting, count);
+}
+
+//==============================================================================
+// Funkcja do wsadowej konwersji wsprzdnych lat/lon WGS 84 na X/Y UTM
+//==============================================================================
+void LatLonToUtmWGS84Batch(int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0)
+   {
+   LatLonToUtmBatch (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon, count, status);
+   }
+
+//==============================================================================
+// Funkcja do wsadowej konwersji wsprzdnych lat/lon WGS 84 na X/Y 1992 lub 2000
+//==============================================================================
+void LatLonToPUWGWGS84Batch(double* easting, double* northing, const double* lat, const double* lon, size_t count, int proj, unsigned char* status = 0)
+   {
+   //proj = 1 - dla odwzorowania kartograficznego 1992, kada inna warto dla 2000
+   LatLonToPUWGBatch (WGS84Context (proj == 1 ? projPUWG1992 : projPUWG2000), easting, northing, lat, lon, count, status);
+   }
+
+//==============================================================================
+//  Funkcja do wsadowej konwersji wsprzdnych X/Y UTM na lat/lon elipsoidalne WGS 84
+//==============================================================================
+void UtmToLatLonWGS84Batch(const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, size_t count)
+   {
+   UtmToLatLonBatch (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon, count);
+   }
+
+//==============================================================================
+//  Funkcja do wsadowej konwersji wsprzdnych X/Y 1992 lub 2000 na lat/lon elipsoidalne WGS 84
+//==============================================================================
+void PUWGToLatLonWGS84Batch(const double* easting, const double* northing, int proj, double* lat, double* lon, size_t count)
+   {
+   PUWGToLatLonBatch (WGS84Context (proj == 1 ? projPUWG1992 : projPUWG2000), easting, northing, lat, lon, count);
+   }
+
+#endif
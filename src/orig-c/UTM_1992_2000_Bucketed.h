@@ -0,0 +1,386 @@
+/*
+Konwersje wsadowe z podziaem punktw na strefy UTM / pasy odwzorowania 2000
+Punkty s najpierw grupowane (sortowanie przez zliczanie) wedug strefy lub pasu, kada grupa
+jest liczona ze staym poudnikiem osiowym i faszywym wschodem, a wyniki wracaj na miejsca
+odpowiadajce kolejnoci danych wejciowych. Przeznaczone dla duych zbiorw punktw z wielu stref.
+Blok punktw z jednej strefy (np. kolejne punkty trasy) jest liczony bez przestawiania danych.
+
+Jdra wektorowe zwykych funkcji wsadowych wybieraj poudnik osiowy dla kadego elementu wektora
+bez rozgazie, wic dla danych losowo wymieszanych midzy strefami grupowanie (numer grupy,
+przestawienie danych i wynikw) kosztuje wicej, ni oszczdza; najwikszy zysk daje ono dla
+jdra skalarnego i danych zoonych z dugich cigw punktw z tej samej strefy.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Bucketed_H
+#define Unit_UTM_1992_2000_Bucketed_H
+
+#include <stddef.h>
+#include <vector>
+#include "UTM_1992_2000_Batch.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Liczba punktw grupowanych jednorazowo (dane wejciowe, wyniki i indeksy mieszcz si w L2)
+static const size_t bucketBlockSize = 4096;
+
+//Liczba grup: strefy UTM 1 - 60 (w konwersji odwrotnej osobno pkula pnocna i poudniowa), pasy 2000;
+//ostatnia grupa zawiera punkty spoza zakresu, liczone zwyk funkcj wsadow
+static const int utmForwardBuckets = 61;
+static const int utmInverseBuckets = 121;
+static const int puwgBuckets = 5;
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y punktw o wsplnym poudniku osiowym olam [radiany] i faszywym wschodzie efe
+//  (utm = true: faszywa pnoc tylko na pkuli poudniowej, northing ograniczony do 9999999)
+//=======================================================================
+void ForwardUniform (BatchKernel kernel, const ProjectionContext& ctx, bool utm, double olam, double efe, const double* lat, const double* lon, double* easting, double* northing, size_t count)
+{
+	switch(kernel)
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::ForwardUniformKernel (ctx, utm, olam, efe, lat, lon, easting, northing, count); break;
+	   case kernelAvx2: SimdAvx2::ForwardUniformKernel (ctx, utm, olam, efe, lat, lon, easting, northing, count); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        double latRad = lat[i] * deg2rad;
+	        double lonRad = lon[i] * deg2rad;
+	        double nfn = utm ? (latRad < 0.0 ? ctx.nfn : 0) : ctx.nfn;
+	        TMForward (ctx, latRad, lonRad - olam, nfn, efe, easting[i], northing[i]);
+	        if (utm && northing[i] >= 9999999.0) northing[i] = 9999999.0;
+	       }
+	     break;
+	  }
+}
+
+//=======================================================================
+//  Konwersja X/Y -> lat/lon punktw o wsplnym poudniku osiowym olam [radiany], przesuniciu pasa strf i faszywej pnocy nfn
+//=======================================================================
+void InverseUniform (BatchKernel kernel, const ProjectionContext& ctx, double olam, double strf, double nfn, const double* easting, const double* northing, double* lat, double* lon, size_t count)
+{
+	switch(kernel)
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::InverseUniformKernel (ctx, olam, strf, nfn, easting, northing, lat, lon, count); break;
+	   case kernelAvx2: SimdAvx2::InverseUniformKernel (ctx, olam, strf, nfn, easting, northing, lat, lon, count); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        double dlam;
+	        TMInverse (ctx, easting[i] - ctx.fe - strf, northing[i] - nfn, lat[i], dlam);
+	        lon[i] = olam + dlam;
+	        lon[i] *= rad2deg;
+	        lat[i] *= rad2deg;
+	       }
+	     break;
+	  }
+}
+
+//Bufory jednego bloku: numery grup, permutacja punktw i dane w kolejnoci grup
+struct BucketBuffers
+{
+	std::vector<unsigned char> key;
+	std::vector<unsigned> order;
+	std::vector<double> in0, in1, out0, out1;
+	std::vector<int> zone;
+	std::vector<char> band;
+	std::vector<unsigned char> status;
+	size_t start[utmInverseBuckets + 1];
+
+	explicit BucketBuffers (size_t count)
+	  {
+	   size_t m = count < bucketBlockSize ? count : bucketBlockSize;
+	   key.resize (m);
+	   order.resize (m);
+	   in0.resize (m);
+	   in1.resize (m);
+	   out0.resize (m);
+	   out1.resize (m);
+	   zone.resize (m);
+	   band.resize (m);
+	   status.resize (m);
+	  }
+
+	//Sortowanie przez zliczanie m punktw wg. key (stabilne); start[b] - pocztek grupy b w order.
+	//Zwraca numer grupy, jeli wszystkie punkty nale do jednej grupy (bez wyznaczania order), w przeciwnym razie -1
+	int Sort (size_t m, int buckets)
+	  {
+	   const unsigned char* k = &key[0];
+	   unsigned* o = &order[0];
+	   unsigned char k0 = k[0];
+	   size_t i = 1;
+	   while(i < m && k[i] == k0) i++;
+	   if(i == m) return k0;
+	   size_t counts[utmInverseBuckets];
+	   for(int b = 0; b < buckets; b++) counts[b] = 0;
+	   for(i = 0; i < m; i++) counts[k[i]]++;
+	   start[0] = 0;
+	   for(int b = 0; b < buckets; b++) start[b + 1] = start[b] + counts[b];
+	   for(int b = 0; b < buckets; b++) counts[b] = start[b];
+	   for(i = 0; i < m; i++) o[counts[k[i]]++] = (unsigned)i;
+	   return -1;
+	  }
+
+	//Kopiowanie danych wejciowych bloku w kolejnoci grup
+	void Gather (size_t m, const double* a, const double* b)
+	  {
+	   const unsigned* o = &order[0];
+	   double* p0 = &in0[0];
+	   double* p1 = &in1[0];
+	   for(size_t j = 0; j < m; j++)
+	     {
+	      p0[j] = a[o[j]];
+	      p1[j] = b[o[j]];
+	     }
+	  }
+
+	//Zapis wynikw na miejsca odpowiadajce kolejnoci danych wejciowych
+	void Scatter (size_t m, double* a, double* b)
+	  {
+	   const unsigned* o = &order[0];
+	   const double* p0 = &out0[0];
+	   const double* p1 = &out1[0];
+	   for(size_t j = 0; j < m; j++)
+	     {
+	      a[o[j]] = p0[j];
+	      b[o[j]] = p1[j];
+	     }
+	  }
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+//  Argumenty i wyniki jak w odpowiednich funkcjach wsadowych (UTM_1992_2000_Batch.h).
+//  Wyniki s identyczne z wynikami funkcji wsadowych dla tego samego jdra obliczeniowego
+//  (dla kernelScalar - z funkcjami skalarnymi).
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon -> X/Y UTM z podziaem na strefy
+//=======================================================================
+void LatLonToUtmBucketed (const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsLatLonToUtmBucketed, count);
+	kernel = ResolveBatchKernel (kernel);
+	BucketBuffers buf (count);
+	for(size_t base = 0; base < count; base += bucketBlockSize)
+	  {
+	   size_t m = count - base < bucketBlockSize ? count - base : bucketBlockSize;
+	   const double* la = lat + base;
+	   const double* lo = lon + base;
+	   // Strefy i status punktw, numer grupy = nr strefy - 1
+	   // (zapisy przez lokalne wskaniki - zapis bajtu mgby zmieni dowoln zmienn, np. wskanik w std::vector)
+	   unsigned char* key = &buf.key[0];
+	   int* zone = utmXZone + base;
+	   char* band = utmYZone + base;
+	   unsigned char* st = status ? status + base : 0;
+	   for(size_t i = 0; i < m; i++)
+	     {
+	      int z;
+	      char y;
+	      UtmZone (la[i], lo[i], z, y);
+	      zone[i] = z;
+	      band[i] = y;
+	      key[i] = (unsigned char)(z >= 1 && z <= 60 ? z - 1 : utmForwardBuckets - 1);
+	      if(st) st[i] = y != '*' ? statusOK : statusLatOutOfRange;
+	     }
+	   int single = buf.Sort (m, utmForwardBuckets);
+	   if(single >= 0 && single < utmForwardBuckets - 1)
+	     {
+	      // Wszystkie punkty bloku w jednej strefie - bez przestawiania danych
+	      ForwardUniform (kernel, ctx, true, UtmCentralMeridian (single + 1), ctx.fe, la, lo, easting + base, northing + base, m);
+	      continue;
+	     }
+	   if(single >= 0)
+	     {
+	      LatLonToUtmBatch (ctx, utmXZone + base, utmYZone + base, easting + base, northing + base, la, lo, m, 0, kernel);
+	      continue;
+	     }
+	   buf.Gather (m, la, lo);
+	   for(int b = 0; b < utmForwardBuckets - 1; b++)
+	     {
+	      size_t s = buf.start[b];
+	      size_t n = buf.start[b + 1] - s;
+	      if(n) ForwardUniform (kernel, ctx, true, UtmCentralMeridian (b + 1), ctx.fe, &buf.in0[s], &buf.in1[s], &buf.out0[s], &buf.out1[s], n);
+	     }
+	   // Punkty spoza zakresu stref (np. dugo geograficzna poza -180 - 180)
+	   size_t s = buf.start[utmForwardBuckets - 1];
+	   size_t n = m - s;
+	   if(n)
+	     {
+	      LatLonToUtmBatch (ctx, &buf.zone[s], &buf.band[s], &buf.out0[s], &buf.out1[s], &buf.in0[s], &buf.in1[s], n, 0, kernel);
+	     }
+	   buf.Scatter (m, easting + base, northing + base);
+	  }
+	UTM_STATS_UTM_ZONES (utmXZone, utmYZone, count, true);
+}
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon -> X/Y 1992 lub 2000 z podziaem na pasy
+//=======================================================================
+void LatLonToPUWGBucketed (const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsLatLonToPUWGBucketed, count);
+	kernel = ResolveBatchKernel (kernel);
+	bool is2000 = ctx.proj == projPUWG2000;
+	BucketBuffers buf (count);
+	for(size_t base = 0; base < count; base += bucketBlockSize)
+	  {
+	   size_t m = count - base < bucketBlockSize ? count - base : bucketBlockSize;
+	   const double* la = lat + base;
+	   const double* lo = lon + base;
+	   // Numer grupy = nr pasa (jak PUWGStripFromLon); dugo geograficzna poza zakresem (take NaN) - ostatnia grupa
+	   unsigned char* key = &buf.key[0];
+	   unsigned char* st = status ? status + base : 0;
+	   for(size_t i = 0; i < m; i++)
+	     {
+	      double l = lo[i];
+	      bool valid = l >= 13.5 && l <= 25.5;
+	      int strip = is2000 ? (l >= 16.5) + (l >= 19.5) + (l >= 22.5) : 0;
+	      key[i] = (unsigned char)(valid ? strip : puwgBuckets - 1);
+	      if(st) st[i] = valid ? statusOK : statusLonOutOfRange;
+	     }
+	   int single = buf.Sort (m, puwgBuckets);
+	   if(single >= 0 && single < puwgBuckets - 1)
+	     {
+	      ForwardUniform (kernel, ctx, false, ctx.olam[single], ctx.fe + ctx.strf[single], la, lo, easting + base, northing + base, m);
+	      continue;
+	     }
+	   if(single >= 0)
+	     {
+	      for(size_t i = 0; i < m; i++)
+	        {
+	         easting[base + i] = 999999999999999;
+	         northing[base + i] = 999999999999999;
+	        }
+	      continue;
+	     }
+	   buf.Gather (m, la, lo);
+	   for(int b = 0; b < puwgBuckets - 1; b++)
+	     {
+	      size_t s = buf.start[b];
+	      size_t n = buf.start[b + 1] - s;
+	      if(n) ForwardUniform (kernel, ctx, false, ctx.olam[b], ctx.fe + ctx.strf[b], &buf.in0[s], &buf.in1[s], &buf.out0[s], &buf.out1[s], n);
+	     }
+	   for(size_t j = buf.start[puwgBuckets - 1]; j < m; j++)
+	     {
+	      //Bdna warto dugoci geograficznej (zwracana warto 99999999999999)
+	      buf.out0[j] = 999999999999999;
+	      buf.out1[j] = 999999999999999;
+	     }
+	   buf.Scatter (m, easting + base, northing + base);
+	  }
+	UTM_STATS_PUWG_LON (ctx.proj == projPUWG2000, lon, count);
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y UTM -> lat/lon z podziaem na strefy
+//=======================================================================
+void UtmToLatLonBucketed (const ProjectionContext& ctx, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, size_t count, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsUtmToLatLonBucketed, count);
+	kernel = ResolveBatchKernel (kernel);
+	BucketBuffers buf (count);
+	for(size_t base = 0; base < count; base += bucketBlockSize)
+	  {
+	   size_t m = count - base < bucketBlockSize ? count - base : bucketBlockSize;
+	   // Numer grupy = 2 (nr strefy - 1) + pkula (1 - poudniowa)
+	   unsigned char* key = &buf.key[0];
+	   const int* zone = utmXZone + base;
+	   const char* band = utmYZone + base;
+	   for(size_t i = 0; i < m; i++)
+	     {
+	      int z = zone[i];
+	      char y = band[i];
+	      int south = (y <= 'M' && y >= 'C') || (y <= 'm' && y >= 'c');
+	      key[i] = (unsigned char)(z >= 1 && z <= 60 ? 2 * (z - 1) + south : utmInverseBuckets - 1);
+	     }
+	   int single = buf.Sort (m, utmInverseBuckets);
+	   if(single >= 0 && single < utmInverseBuckets - 1)
+	     {
+	      InverseUniform (kernel, ctx, UtmCentralMeridian (single / 2 + 1), 0.0, (single & 1) ? ctx.nfn : 0, easting + base, northing + base, lat + base, lon + base, m);
+	      continue;
+	     }
+	   if(single >= 0)
+	     {
+	      UtmToLatLonBatch (ctx, utmXZone + base, utmYZone + base, easting + base, northing + base, lat + base, lon + base, m, kernel);
+	      continue;
+	     }
+	   buf.Gather (m, easting + base, northing + base);
+	   for(int b = 0; b < utmInverseBuckets - 1; b++)
+	     {
+	      size_t s = buf.start[b];
+	      size_t n = buf.start[b + 1] - s;
+	      if(n) InverseUniform (kernel, ctx, UtmCentralMeridian (b / 2 + 1), 0.0, (b & 1) ? ctx.nfn : 0, &buf.in0[s], &buf.in1[s], &buf.out0[s], &buf.out1[s], n);
+	     }
+	   size_t s = buf.start[utmInverseBuckets - 1];
+	   size_t n = m - s;
+	   if(n)
+	     {
+	      for(size_t j = s; j < m; j++)
+	        {
+	         buf.zone[j] = utmXZone[base + buf.order[j]];
+	         buf.band[j] = utmYZone[base + buf.order[j]];
+	        }
+	      UtmToLatLonBatch (ctx, &buf.zone[s], &buf.band[s], &buf.in0[s], &buf.in1[s], &buf.out0[s], &buf.out1[s], n, kernel);
+	     }
+	   buf.Scatter (m, lat + base, lon + base);
+	  }
+	UTM_STATS_UTM_ZONES (utmXZone, utmYZone, count, false);
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y 1992 lub 2000 -> lat/lon z podziaem na pasy
+//=======================================================================
+void PUWGToLatLonBucketed (const ProjectionContext& ctx, const double* easting, const double* northing, double* lat, double* lon, size_t count, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsPUWGToLatLonBucketed, count);
+	kernel = ResolveBatchKernel (kernel);
+	if(ctx.proj != projPUWG2000)
+	  {
+	   // Odwzorowanie 1992 ma jeden pas - grupowanie nie jest potrzebne
+	   PUWGToLatLonBatch (ctx, easting, northing, lat, lon, count, kernel);
+	   return;
+	  }
+	BucketBuffers buf (count);
+	for(size_t base = 0; base < count; base += bucketBlockSize)
+	  {
+	   size_t m = count - base < bucketBlockSize ? count - base : bucketBlockSize;
+	   unsigned char* key = &buf.key[0];
+	   const double* e = easting + base;
+	   for(size_t i = 0; i < m; i++)
+	     {
+	      key[i] = (unsigned char)PUWGStripFromEasting (e[i]);
+	     }
+	   int single = buf.Sort (m, puwgBuckets - 1);
+	   if(single >= 0)
+	     {
+	      InverseUniform (kernel, ctx, ctx.olam[single], ctx.strf[single], ctx.nfn, easting + base, northing + base, lat + base, lon + base, m);
+	      continue;
+	     }
+	   buf.Gather (m, easting + base, northing + base);
+	   for(int b = 0; b < puwgBuckets - 1; b++)
+	     {
+	      size_t s = buf.start[b];
+	      size_t n = buf.start[b + 1] - s;
+	      if(n) InverseUniform (kernel, ctx, ctx.olam[b], ctx.strf[b], ctx.nfn, &buf.in0[s], &buf.in1[s], &buf.out0[s], &buf.out1[s], n);
+	     }
+	   buf.Scatter (m, lat + base, lon + base);
+	  }
+	UTM_STATS_PUWG_EASTING (ctx.proj == projPUWG2000, easting, count);
+}
+
+#endif
@@ -0,0 +1,422 @@
+/*
+Pami podrczna (memoizacja) konwersji lat/lon -> X/Y UTM, 1992, 2000 dla czsto powtarzanych punktw
+
+Wyniki s zapamitywane w tablicy o staej wielkoci (cacheWays wpisw w zbiorze, zbiory wybierane
+skrtem klucza), wypierane algorytmem CLOCK (bit odwoania dla kadego wpisu). Odczyt nie blokuje:
+kady zbir jest chroniony licznikiem sekwencji (seqlock), a zapis (po chybieniu) odbywa si pod jedn
+z cacheShards blokad, wybieran wedug zbioru. Zbir zajmuje 4 linie pamici podrcznej procesora
+(256 bajtw, ok. 43 bajty na wpis): w pierwszej s licznik sekwencji, bity odwoania i znaczniki
+wpisw (rodzaj klucza i 32 bity skrtu), wic trafienie odczytuje dwie linie.
+
+Klucz to szeroko i dugo zaokrglone do kwantu (kratki) wyznaczonego z podanej tolerancji oraz
+odwzorowanie, strefa/pas i pkula wyznaczone z dokadnych wsprzdnych - punkty z jednej kratki, ale
+z rnych stref lub pasw, maj rne klucze. Wynik dla kratki liczony jest dla jej rodka, wic nie
+zaley od kolejnoci zapyta. Dla tolerancji 0 kluczem s dokadne wartoci lat/lon, a wyniki s
+identyczne co do bitu z LatLonToUtm i LatLonToPUWG.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Cache_H
+#define Unit_UTM_1992_2000_Cache_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "UTM_1992_2000.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Liczba wpisw w zbiorze i liczba blokad zapisu
+static const size_t cacheWays = 6;
+static const size_t cacheShards = 64;
+
+//Liczba licznikw trafie przydzielanych wtkom na wyczno (kolejne wtki uywaj wsplnego licznika atomowego)
+static const size_t cacheHitSlots = 256;
+
+//Zapas na znieksztacenie skali odwzorowa (najwiksze w 1992 na kracach Polski: ok. 1.002)
+static const double cacheScaleMargin = 1.01;
+
+//=======================================================================
+//  Statystyka pamici podrcznej
+//=======================================================================
+struct ConversionCacheStats
+{
+	uint64_t hits;
+	uint64_t misses;          // w tym punkty liczone bez pamici podrcznej (poza zakresem, NaN)
+	uint64_t evictions;
+	uint64_t entries;         // zajte wpisy
+	uint64_t capacity;        // liczba wpisw
+};
+
+//=======================================================================
+//  Pami podrczna konwersji lat/lon -> X/Y dla jednej elipsoidy
+//=======================================================================
+//      Wszystkie metody (oprcz Clear) mog by wywoywane jednoczenie z wielu wtkw.
+//=======================================================================
+class ConversionCache
+{
+public:
+	//  size_t capacity: najwiksza liczba zapamitanych wynikw (zaokrglana w gr do cacheWays x potga 2, co najmniej cacheShards * cacheWays)
+	//  double tolerance: najwiksza rnica wyniku wzgldem konwersji bez pamici podrcznej [m] (0 - wyniki dokadne)
+	//  double a, double f, ProjectionEngine engine: elipsoida i metoda oblicze (jak w CreateProjectionContext)
+	ConversionCache (size_t capacity, double tolerance = 0.0, double a = 6378137.0, double f = 1 / 298.257223563, ProjectionEngine engine = engineClassic);
+
+	//Odpowiedniki LatLonToUtm i LatLonToPUWG (proj: 1 - 1992, 2 - 2000)
+	void LatLonToUtm (int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon);
+	void LatLonToPUWG (double& easting, double& northing, double lat, double lon, int proj);
+
+	//Tolerancja wynikw [m] i kwant kratki [stopnie] (0 - klucz dokadny)
+	double Tolerance () const { return tolerance; }
+	double Quantum () const { return quantum; }
+
+	ConversionCacheStats Stats () const;
+
+	//Usuwa wszystkie wpisy i zeruje statystyk (nie moe by wywoywana jednoczenie z innymi metodami)
+	void Clear ();
+
+private:
+	// Zbir - 256 bajtw, wyrwnany do linii pamici podrcznej procesora; tags[w] = 0 oznacza wolny wpis
+	struct Entry
+	{
+		std::atomic<uint64_t> klat;
+		std::atomic<uint64_t> klon;
+		std::atomic<uint64_t> easting;
+		std::atomic<uint64_t> northing;
+	};
+	struct Set
+	{
+		std::atomic<uint64_t> seq;
+		std::atomic<uint64_t> referenced;
+		std::atomic<uint64_t> tags[cacheWays];
+		Entry entry[cacheWays];
+	};
+	struct Shard
+	{
+		std::mutex mutex;
+		std::atomic<uint64_t> misses;
+		std::atomic<uint64_t> evictions;
+		std::atomic<uint64_t> entries;
+		char pad[64];
+	};
+	// Licznik trafie jednego wtku - zapis bez instrukcji atomowej odczyt-modyfikacja-zapis
+	struct HitSlot
+	{
+		std::atomic<uint64_t> hits;
+		char pad[64 - sizeof (std::atomic<uint64_t>)];
+	};
+
+	static uint64_t Bits (double x) { uint64_t u; memcpy (&u, &x, sizeof (u)); return u; }
+	static double Double (uint64_t u) { double x; memcpy (&x, &u, sizeof (x)); return x; }
+	static uint64_t Hash (uint64_t klat, uint64_t klon, uint64_t tag);
+
+	bool Key (double lat, double lon, uint64_t& klat, uint64_t& klon, double& qlat, double& qlon) const;
+	bool Find (size_t set, uint64_t tag, uint64_t klat, uint64_t klon, double& easting, double& northing);
+	void Insert (size_t set, uint64_t tag, uint64_t klat, uint64_t klon, double easting, double northing);
+	void CountHit ();
+
+	ConversionCache (const ConversionCache&);
+	ConversionCache& operator= (const ConversionCache&);
+
+	ProjectionContext ctx[3];
+	double tolerance;
+	double quantum;
+	double inverseQuantum;
+	size_t sets;
+	std::vector<unsigned char> memory;
+	Set* table;
+	std::vector<unsigned char> hands;      // wskazwka CLOCK dla kadego zbioru (pod blokad zapisu)
+	Shard shards[cacheShards];
+	HitSlot hitSlots[cacheHitSlots];
+	std::atomic<uint64_t> sharedHits;
+};
+
+//Numer wtku nadawany przy pierwszym uyciu (wsplny dla wszystkich obiektw ConversionCache)
+inline unsigned CacheThreadSlot ()
+{
+	static std::atomic<unsigned> next (0);
+	static thread_local unsigned slot = next.fetch_add (1);
+	return slot;
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+ConversionCache::ConversionCache (size_t capacity, double tolerance, double a, double f, ProjectionEngine engine)
+	: tolerance (tolerance > 0 ? tolerance : 0.0), quantum (0.0), inverseQuantum (0.0), sets (cacheShards), table (0), sharedHits (0)
+{
+	ctx[0] = CreateProjectionContext (a, f, projUTM, engine);
+	ctx[1] = CreateProjectionContext (a, f, projPUWG1992, engine);
+	ctx[2] = CreateProjectionContext (a, f, projPUWG2000, engine);
+	// Przesunicie punktu o p kwantu szerokoci i dugoci to co najwyej
+	// q / 2 * sqrt (2) * (najwikszy promie krzywizny a / sqrt (1 - e^2)) na elipsoidzie
+	if(this->tolerance > 0)
+	  {
+	   double e2 = f * (2.0 - f);
+	   double metresPerQuantum = 0.5 * sqrt (2.0) * deg2rad * a / sqrt (1.0 - e2) * cacheScaleMargin;
+	   quantum = this->tolerance / metresPerQuantum;
+	   // Numery kratek musz by liczbami cakowitymi dokadnymi w double
+	   if(quantum < 180.0 / 4503599627370496.0)
+	     {
+	      quantum = 180.0 / 4503599627370496.0;
+	      this->tolerance = quantum * metresPerQuantum;
+	     }
+	   inverseQuantum = 1.0 / quantum;
+	  }
+	while(sets * cacheWays < capacity) sets *= 2;
+	memory.resize (sets * sizeof (Set) + 64);
+	uintptr_t p = (uintptr_t)&memory[0];
+	table = (Set*)((p + 63) & ~(uintptr_t)63);
+	for(size_t i = 0; i < sets; i++) new (&table[i]) Set ();
+	hands.resize (sets);
+	Clear ();
+}
+
+uint64_t ConversionCache::Hash (uint64_t klat, uint64_t klon, uint64_t tag)
+{
+	uint64_t h = klat * 0x9E3779B97F4A7C15ull ^ (klon + tag * 0xC2B2AE3D27D4EB4Full) * 0xD6E8FEB86659FD93ull;
+	h ^= h >> 32;
+	h *= 0xD6E8FEB86659FD93ull;
+	h ^= h >> 32;
+	return h;
+}
+
+//=======================================================================
+//  Klucz punktu: numery kratki (lub dokadne bity) i wsprzdne rodka kratki
+//=======================================================================
+//      false - punkt liczony bez pamici podrcznej (NaN, poza zakresem lat/lon)
+//=======================================================================
+bool ConversionCache::Key (double lat, double lon, uint64_t& klat, uint64_t& klon, double& qlat, double& qlon) const
+{
+	if(!(fabs (lat) <= 90.0 && fabs (lon) <= 180.0)) return false;
+	if(quantum == 0)
+	  {
+	   klat = Bits (lat);
+	   klon = Bits (lon);
+	   qlat = lat;
+	   qlon = lon;
+	   return true;
+	  }
+	double nlat = floor (lat * inverseQuantum + 0.5);
+	double nlon = floor (lon * inverseQuantum + 0.5);
+	klat = (uint64_t)(int64_t)nlat;
+	klon = (uint64_t)(int64_t)nlon;
+	qlat = nlat * quantum;
+	if(qlat > 90.0) qlat = 90.0;
+	if(qlat < -90.0) qlat = -90.0;
+	qlon = nlon * quantum;
+	return true;
+}
+
+//=======================================================================
+//  Odczyt wpisu bez blokady: zgodny licznik sekwencji zbioru przed i po odczycie
+//=======================================================================
+//       size_t set: numer zbioru
+//       uint64_t tag: znacznik wpisu - 32 starsze bity skrtu i rodzaj klucza (odwzorowanie, strefa, pas)
+//       uint64_t klat, uint64_t klon: numery kratki (lub bity lat/lon)
+//=======================================================================
+bool ConversionCache::Find (size_t set, uint64_t tag, uint64_t klat, uint64_t klon, double& easting, double& northing)
+{
+	Set& t = table[set];
+	uint64_t s = t.seq.load (std::memory_order_acquire);
+	if(s & 1) return false;
+	for(size_t w = 0; w < cacheWays; w++)
+	  {
+	   if(t.tags[w].load (std::memory_order_relaxed) != tag) continue;
+	   Entry& e = t.entry[w];
+	   uint64_t a = e.klat.load (std::memory_order_relaxed);
+	   uint64_t b = e.klon.load (std::memory_order_relaxed);
+	   uint64_t x = e.easting.load (std::memory_order_relaxed);
+	   uint64_t y = e.northing.load (std::memory_order_relaxed);
+	   std::atomic_thread_fence (std::memory_order_acquire);
+	   if(t.seq.load (std::memory_order_relaxed) != s) return false;
+	   if(a != klat || b != klon) continue;
+	   // Bit odwoania zapisywany tylko przy zmianie - trafienia nie uniewaniaj linii w innych rdzeniach
+	   uint64_t bit = 1ull << w;
+	   if(!(t.referenced.load (std::memory_order_relaxed) & bit)) t.referenced.fetch_or (bit, std::memory_order_relaxed);
+	   easting = Double (x);
+	   northing = Double (y);
+	   return true;
+	  }
+	return false;
+}
+
+//=======================================================================
+//  Zapis wyniku pod blokad zbioru: wolny wpis lub ofiara wskazana przez CLOCK
+//=======================================================================
+void ConversionCache::Insert (size_t set, uint64_t tag, uint64_t klat, uint64_t klon, double easting, double northing)
+{
+	Shard& shard = shards[set % cacheShards];
+	std::lock_guard<std::mutex> lock (shard.mutex);
+	Set& t = table[set];
+	int victim = -1;
+	for(size_t w = 0; w < cacheWays; w++)
+	  {
+	   uint64_t g = t.tags[w].load (std::memory_order_relaxed);
+	   // Wynik mg zosta zapisany przez inny wtek
+	   if(g == tag && t.entry[w].klat.load (std::memory_order_relaxed) == klat && t.entry[w].klon.load (std::memory_order_relaxed) == klon) return;
+	   if(g == 0 && victim < 0) victim = (int)w;
+	  }
+	if(victim >= 0) shard.entries.fetch_add (1, std::memory_order_relaxed);
+	else
+	  {
+	   unsigned hand = hands[set];
+	   while(t.referenced.load (std::memory_order_relaxed) & (1ull << hand))
+	     {
+	      t.referenced.fetch_and (~(1ull << hand), std::memory_order_relaxed);
+	      hand = (hand + 1) % cacheWays;
+	     }
+	   victim = (int)hand;
+	   hands[set] = (unsigned char)((hand + 1) % cacheWays);
+	   shard.evictions.fetch_add (1, std::memory_order_relaxed);
+	  }
+	Entry& e = t.entry[victim];
+	uint64_t s = t.seq.load (std::memory_order_relaxed);
+	t.seq.store (s + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+	t.tags[victim].store (tag, std::memory_order_relaxed);
+	e.klat.store (klat, std::memory_order_relaxed);
+	e.klon.store (klon, std::memory_order_relaxed);
+	e.easting.store (Bits (easting), std::memory_order_relaxed);
+	e.northing.store (Bits (northing), std::memory_order_relaxed);
+	t.referenced.fetch_and (~(1ull << victim), std::memory_order_relaxed);
+	t.seq.store (s + 2, std::memory_order_release);
+}
+
+void ConversionCache::CountHit ()
+{
+	unsigned slot = CacheThreadSlot ();
+	if(slot < cacheHitSlots)
+	  {
+	   std::atomic<uint64_t>& h = hitSlots[slot].hits;
+	   h.store (h.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	  }
+	else sharedHits.fetch_add (1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y UTM z pamici podrczn (wyniki jak w LatLonToUtm)
+//=======================================================================
+void ConversionCache::LatLonToUtm (int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon)
+{
+	UTM_STATS_CALL (statsCacheLatLonToUtm, 1);
+	uint64_t klat, klon;
+	double qlat, qlon;
+	UtmZone (lat, lon, utmXZone, utmYZone);
+	UTM_STATS_UTM_ZONES (&utmXZone, &utmYZone, 1, true);
+	Shard* shard = 0;
+	if(Key (lat, lon, klat, klon, qlat, qlon))
+	  {
+	   // Strefa i pkula z dokadnych wsprzdnych
+	   uint64_t south = lat < 0.0;
+	   uint64_t kind = (1u << 31) | (south << 24) | ((uint64_t)(unsigned char)utmYZone << 8) | (uint64_t)(utmXZone & 0xFF);
+	   uint64_t h = Hash (klat, klon, kind);
+	   size_t set = h & (sets - 1);
+	   uint64_t tag = (h & 0xFFFFFFFF00000000ull) | kind;
+	   shard = &shards[set % cacheShards];
+	   if(Find (set, tag, klat, klon, easting, northing))
+	     {
+	      CountHit ();
+	      return;
+	     }
+	   // Klucz dokadny - ta sama funkcja co bez pamici podrcznej (identyczne wyniki take przy czeniu mnoe w FMA przez kompilator)
+	   if(quantum == 0) ::LatLonToUtm (ctx[0], utmXZone, utmYZone, easting, northing, lat, lon);
+	   else
+	     {
+	      TMForward (ctx[0], qlat * deg2rad, qlon * deg2rad - UtmCentralMeridian (utmXZone), south ? ctx[0].nfn : 0, ctx[0].fe, easting, northing);
+	      if (northing >= 9999999.0) northing = 9999999.0;
+	     }
+	   Insert (set, tag, klat, klon, easting, northing);
+	  }
+	else
+	  {
+	   shard = &shards[0];
+	   ::LatLonToUtm (ctx[0], utmXZone, utmYZone, easting, northing, lat, lon);
+	  }
+	shard->misses.fetch_add (1, std::memory_order_relaxed);
+}
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y 1992 lub 2000 z pamici podrczn (wyniki jak w LatLonToPUWG)
+//=======================================================================
+void ConversionCache::LatLonToPUWG (double& easting, double& northing, double lat, double lon, int proj)
+{
+	UTM_STATS_CALL (statsCacheLatLonToPUWG, 1);
+	const ProjectionContext& c = ctx[proj == 1 ? 1 : 2];
+	UTM_STATS_PUWG_LON (c.proj == projPUWG2000, &lon, 1);
+	uint64_t klat, klon;
+	double qlat, qlon;
+	// Zakres dugoci i pas z dokadnych wsprzdnych; punkty poza zakresem nie s zapamitywane
+	if(!(lon >= 13.5 && lon <= 25.5) || !Key (lat, lon, klat, klon, qlat, qlon))
+	  {
+	   ::LatLonToPUWG (c, easting, northing, lat, lon);
+	   shards[0].misses.fetch_add (1, std::memory_order_relaxed);
+	   return;
+	  }
+	int strip = c.proj == projPUWG2000 ? PUWGStripFromLon (lon) : 0;
+	uint64_t kind = (1u << 31) | ((uint64_t)c.proj << 28) | (uint64_t)strip;
+	uint64_t h = Hash (klat, klon, kind);
+	size_t set = h & (sets - 1);
+	uint64_t tag = (h & 0xFFFFFFFF00000000ull) | kind;
+	Shard& shard = shards[set % cacheShards];
+	if(Find (set, tag, klat, klon, easting, northing))
+	  {
+	   CountHit ();
+	   return;
+	  }
+	if(quantum == 0) ::LatLonToPUWG (c, easting, northing, lat, lon);
+	else TMForward (c, qlat * deg2rad, qlon * deg2rad - c.olam[strip], c.nfn, c.fe + c.strf[strip], easting, northing);
+	Insert (set, tag, klat, klon, easting, northing);
+	shard.misses.fetch_add (1, std::memory_order_relaxed);
+}
+
+ConversionCacheStats ConversionCache::Stats () const
+{
+	ConversionCacheStats s;
+	memset (&s, 0, sizeof (s));
+	for(size_t i = 0; i < cacheShards; i++)
+	  {
+	   s.misses += shards[i].misses.load (std::memory_order_relaxed);
+	   s.evictions += shards[i].evictions.load (std::memory_order_relaxed);
+	   s.entries += shards[i].entries.load (std::memory_order_relaxed);
+	  }
+	for(size_t i = 0; i < cacheHitSlots; i++) s.hits += hitSlots[i].hits.load (std::memory_order_relaxed);
+	s.hits += sharedHits.load (std::memory_order_relaxed);
+	s.capacity = sets * cacheWays;
+	return s;
+}
+
+void ConversionCache::Clear ()
+{
+	for(size_t i = 0; i < sets; i++)
+	  {
+	   table[i].seq.store (0, std::memory_order_relaxed);
+	   table[i].referenced.store (0, std::memory_order_relaxed);
+	   for(size_t w = 0; w < cacheWays; w++) table[i].tags[w].store (0, std::memory_order_relaxed);
+	   hands[i] = 0;
+	  }
+	for(size_t i = 0; i < cacheShards; i++)
+	  {
+	   shards[i].misses.store (0);
+	   shards[i].evictions.store (0);
+	   shards[i].entries.store (0);
+	  }
+	for(size_t i = 0; i < cacheHitSlots; i++) hitSlots[i].hits.store (0);
+	sharedHits.store (0);
+}
+
+#endif
@@ -0,0 +1,326 @@
+/*
+Zmiana ukadu odniesienia (datum) przed odwzorowaniem: B, L, h -> X, Y, Z (ECEF) -> transformacja
+Helmerta (7 parametrw) -> B, L, h na elipsoidzie ukadu docelowego
+
+Przeznaczona dla danych w dawnych ukadach (np. Pulkovo 42 na elipsoidzie Krasowskiego, ED50 na
+elipsoidzie midzynarodowej 1924), przeliczanych do 1992, 2000 lub UTM. Funkcje wsadowe cz zmian
+ukadu odniesienia z odwzorowaniem: punkty s liczone blokami po datumBlockSize, a wyniki porednie
+(B, L w ukadzie docelowym) pozostaj w buforach na stosie - jeden przebieg po tablicach wejciowych
+i wynikowych.
+
+Wsprzdne geodezyjne z X, Y, Z wyznaczane s wzorem Bowringa (jedna iteracja - bd poniej 1e-6 m
+dla |h| < 10 km). Jdra wektorowe wyznaczaj B, L jako poprawki do wartoci wejciowych (arcus tangens
+maego kta, bez funkcji atan2), wic s przeznaczone dla przesuni rzdu zmian ukadu odniesienia;
+punkty o poprawce wikszej ni datumSmallAngle (ok. 300 km) i punkty przy biegunach s liczone funkcj
+skalarn.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Datum_H
+#define Unit_UTM_1992_2000_Datum_H
+
+#include <math.h>
+#include <stddef.h>
+#include "UTM_1992_2000_Batch.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Znak ktw obrotu: obrt wektora pooenia (EPSG 9606) lub obrt ukadu wsprzdnych (EPSG 9607)
+enum HelmertConvention { helmertPositionVector, helmertCoordinateFrame };
+
+//Parametry zmiany ukadu odniesienia: elipsoidy obu ukadw i transformacja Helmerta
+//  X' = T + (1 + ds) R X  (dla helmertPositionVector: R = [1 -rz ry; rz 1 -rx; -ry rx 1])
+struct DatumParameters
+{
+	double srcA, srcF;          // elipsoida ukadu rdowego: dua po [m], spaszczenie
+	double dstA, dstF;          // elipsoida ukadu docelowego
+	double tx, ty, tz;          // przesunicie [m]
+	double rx, ry, rz;          // obrt ["]
+	double ds;                  // zmiana skali [ppm]
+	HelmertConvention convention;
+};
+
+//Pulkovo 1942(58) (elipsoida Krasowskiego) -> ETRS89 (GRS 80), parametry dla obszaru Polski
+static const DatumParameters datumPulkovo42ToETRS89 =
+	{ 6378245.0, 1 / 298.3, 6378137.0, 1 / 298.257222101, 33.4, -146.6, -76.3, -0.359, -0.053, 0.844, -0.84, helmertPositionVector };
+
+//ED50 (elipsoida midzynarodowa 1924) -> WGS 84, parametry rednie dla Europy Zachodniej (tylko przesunicie)
+static const DatumParameters datumED50ToWGS84 =
+	{ 6378388.0, 1 / 297.0, 6378137.0, 1 / 298.257223563, -87.0, -98.0, -121.0, 0.0, 0.0, 0.0, 0.0, helmertPositionVector };
+
+//Liczba punktw liczonych jednorazowo w funkcjach wsadowych z odwzorowaniem (bufory porednie na stosie)
+static const size_t datumBlockSize = 512;
+
+//Najwiksza poprawka B, L liczona w jdrach wektorowych [radiany] (szereg arcus tangens do x^9, bd < 1e-16)
+static const double datumSmallAngle = 0.05;
+
+//=======================================================================
+//  Kontekst zmiany ukadu odniesienia (wielkoci stae dla wszystkich punktw)
+//=======================================================================
+struct DatumContext
+{
+	double srcA, srcE2;
+	double dstA, dstB, dstE2, dstEp2;
+	// Macierz obrotu ze skal (wierszami) i przesunicie: X' = t + m X
+	double m[9];
+	double t[3];
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja wyznacza kontekst zmiany ukadu odniesienia
+//=======================================================================
+//       const DatumParameters& p: parametry (np. datumPulkovo42ToETRS89)
+//       bool inverse: zmiana odwrotna (z ukadu docelowego do rdowego - dokadna odwrotno macierzy)
+//=======================================================================
+DatumContext CreateDatumContext (const DatumParameters& p, bool inverse = false)
+{
+	DatumContext dc;
+	const double sec = 3.14159265358979323846 / (180.0 * 3600.0);
+	double s = 1.0 + p.ds * 1e-6;
+	double rx = p.rx * sec, ry = p.ry * sec, rz = p.rz * sec;
+	if(p.convention == helmertCoordinateFrame)
+	  {
+	   rx = -rx;
+	   ry = -ry;
+	   rz = -rz;
+	  }
+	double m[9] = { s, -s * rz, s * ry, s * rz, s, -s * rx, -s * ry, s * rx, s };
+	double t[3] = { p.tx, p.ty, p.tz };
+	double srcA = p.srcA, srcF = p.srcF, dstA = p.dstA, dstF = p.dstF;
+	if(inverse)
+	  {
+	   // m^-1 = macierz dopenie / wyznacznik, t' = -m^-1 t
+	   double c[9] =
+	     {
+	      m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8], m[1] * m[5] - m[2] * m[4],
+	      m[5] * m[6] - m[3] * m[8], m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+	      m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7], m[0] * m[4] - m[1] * m[3]
+	     };
+	   double det = m[0] * c[0] + m[1] * c[3] + m[2] * c[6];
+	   for(int i = 0; i < 9; i++) m[i] = c[i] / det;
+	   double ti[3];
+	   for(int i = 0; i < 3; i++) ti[i] = -(m[3 * i] * t[0] + m[3 * i + 1] * t[1] + m[3 * i + 2] * t[2]);
+	   for(int i = 0; i < 3; i++) t[i] = ti[i];
+	   srcA = p.dstA;
+	   srcF = p.dstF;
+	   dstA = p.srcA;
+	   dstF = p.srcF;
+	  }
+	for(int i = 0; i < 9; i++) dc.m[i] = m[i];
+	for(int i = 0; i < 3; i++) dc.t[i] = t[i];
+	dc.srcA = srcA;
+	dc.srcE2 = srcF * (2.0 - srcF);
+	dc.dstA = dstA;
+	dc.dstB = dstA * (1.0 - dstF);
+	dc.dstE2 = dstF * (2.0 - dstF);
+	dc.dstEp2 = dc.dstE2 / ((1.0 - dstF) * (1.0 - dstF));
+	return dc;
+}
+
+//=======================================================================
+//  Wsprzdne geodezyjne -> X, Y, Z (ECEF)
+//=======================================================================
+//       double a, double e2: dua po [m] i kwadrat mimorodu elipsoidy
+//       double latRad, double lonRad, double h: szeroko, dugo [radiany], wysoko elipsoidalna [m]
+//       double& x, double& y, double& z: wsprzdne ortokartezjaskie [m]
+//=======================================================================
+void GeodeticToEcef (double a, double e2, double latRad, double lonRad, double h, double& x, double& y, double& z)
+{
+	double sp = sin (latRad), cp = cos (latRad);
+	double n = a / sqrt (1.0 - e2 * sp * sp);
+	double r = (n + h) * cp;
+	x = r * cos (lonRad);
+	y = r * sin (lonRad);
+	z = (n * (1.0 - e2) + h) * sp;
+}
+
+//=======================================================================
+//  X, Y, Z (ECEF) -> wsprzdne geodezyjne (wzr Bowringa)
+//=======================================================================
+//       double a, double b, double e2, double ep2: posie [m], kwadrat pierwszego i drugiego mimorodu
+//       double x, double y, double z: wsprzdne ortokartezjaskie [m]
+//       double& latRad, double& lonRad, double& h: szeroko, dugo [radiany], wysoko elipsoidalna [m]
+//=======================================================================
+void EcefToGeodetic (double a, double b, double e2, double ep2, double x, double y, double z, double& latRad, double& lonRad, double& h)
+{
+	double p = sqrt (x * x + y * y);
+	double theta = atan2 (z * a, p * b);
+	double st = sin (theta), ct = cos (theta);
+	latRad = atan2 (z + ep2 * b * st * st * st, p - e2 * a * ct * ct * ct);
+	lonRad = atan2 (y, x);
+	double sp = sin (latRad), cp = cos (latRad);
+	// Wysoko bez dzielenia przez cos (poprawna take przy biegunach)
+	h = p * cp + z * sp - a * sqrt (1.0 - e2 * sp * sp);
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja zmienia ukad odniesienia wsprzdnych jednego punktu
+//=======================================================================
+//       const DatumContext& dc: kontekst zmiany ukadu odniesienia (CreateDatumContext)
+//       double& lat, double& lon: wsprzdne lat/lon [stopnie], zastpowane wynikiem
+//       double& h: wysoko elipsoidalna [m], zastpowana wynikiem (dla danych bez wysokoci 0)
+//=======================================================================
+void DatumShift (const DatumContext& dc, double& lat, double& lon, double& h)
+{
+	double x, y, z;
+	GeodeticToEcef (dc.srcA, dc.srcE2, lat * deg2rad, lon * deg2rad, h, x, y, z);
+	const double* m = dc.m;
+	double x2 = dc.t[0] + m[0] * x + m[1] * y + m[2] * z;
+	double y2 = dc.t[1] + m[3] * x + m[4] * y + m[5] * z;
+	double z2 = dc.t[2] + m[6] * x + m[7] * y + m[8] * z;
+	double latRad, lonRad;
+	EcefToGeodetic (dc.dstA, dc.dstB, dc.dstE2, dc.dstEp2, x2, y2, z2, latRad, lonRad, h);
+	lat = latRad * rad2deg;
+	lon = lonRad * rad2deg;
+}
+
+#ifdef UTM_1992_2000_SIMD
+// Jdra wektorowe - jak w UTM_1992_2000_Simd.h, bez czenia mnoenia i dodawania w FMA przez kompilator
+#pragma GCC push_options
+#pragma GCC optimize ("fp-contract=off")
+
+namespace SimdAvx2
+{
+#define UTM_SIMD_TARGET __attribute__((target("avx2,fma")))
+#include "UTM_1992_2000_DatumKernel.h"
+#undef UTM_SIMD_TARGET
+}
+
+namespace SimdAvx512
+{
+#define UTM_SIMD_TARGET __attribute__((target("avx512f")))
+#include "UTM_1992_2000_DatumKernel.h"
+#undef UTM_SIMD_TARGET
+}
+
+#pragma GCC pop_options
+#endif
+
+//=======================================================================
+//  Wsadowa zmiana ukadu odniesienia (w miejscu, odpowiednik DatumShift dla count punktw)
+//=======================================================================
+//       const DatumContext& dc: kontekst zmiany ukadu odniesienia
+//       double* lat, double* lon: wsprzdne lat/lon [stopnie], zastpowane wynikiem
+//       double* h: wysokoci elipsoidalne [m], zastpowane wynikiem, lub 0 (wysokoci rwne 0, wynik pomijany)
+//       size_t count: liczba punktw
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+void DatumShiftBatch (const DatumContext& dc, double* lat, double* lon, double* h, size_t count, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsDatumShiftBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::DatumShiftKernel (dc, lat, lon, h, count); break;
+	   case kernelAvx2: SimdAvx2::DatumShiftKernel (dc, lat, lon, h, count); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        double hi = h ? h[i] : 0.0;
+	        DatumShift (dc, lat[i], lon[i], hi);
+	        if(h) h[i] = hi;
+	       }
+	     break;
+	  }
+}
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon ukadu rdowego -> X/Y 1992 lub 2000 ukadu docelowego
+//=======================================================================
+//       const DatumContext& dc: kontekst zmiany ukadu odniesienia (np. Pulkovo 42 -> ETRS89)
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000 na elipsoidzie ukadu docelowego
+//       pozostae argumenty jak w LatLonToPUWGBatch (lat, lon w ukadzie rdowym, wysoko 0)
+//=======================================================================
+void LatLonToPUWGDatumBatch (const DatumContext& dc, const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	kernel = ResolveBatchKernel (kernel);
+	double la[datumBlockSize], lo[datumBlockSize];
+	for(size_t i = 0; i < count; i += datumBlockSize)
+	  {
+	   size_t n = count - i < datumBlockSize ? count - i : datumBlockSize;
+	   for(size_t j = 0; j < n; j++)
+	     {
+	      la[j] = lat[i + j];
+	      lo[j] = lon[i + j];
+	     }
+	   DatumShiftBatch (dc, la, lo, 0, n, kernel);
+	   LatLonToPUWGBatch (ctx, easting + i, northing + i, la, lo, n, status ? status + i : 0, kernel);
+	  }
+}
+
+//=======================================================================
+//  Konwersja wsadowa lat/lon ukadu rdowego -> X/Y UTM ukadu docelowego
+//=======================================================================
+//       const DatumContext& dc: kontekst zmiany ukadu odniesienia (np. ED50 -> WGS 84)
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM na elipsoidzie ukadu docelowego
+//       pozostae argumenty jak w LatLonToUtmBatch (lat, lon w ukadzie rdowym, wysoko 0)
+//=======================================================================
+void LatLonToUtmDatumBatch (const DatumContext& dc, const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	kernel = ResolveBatchKernel (kernel);
+	double la[datumBlockSize], lo[datumBlockSize];
+	for(size_t i = 0; i < count; i += datumBlockSize)
+	  {
+	   size_t n = count - i < datumBlockSize ? count - i : datumBlockSize;
+	   for(size_t j = 0; j < n; j++)
+	     {
+	      la[j] = lat[i + j];
+	      lo[j] = lon[i + j];
+	     }
+	   DatumShiftBatch (dc, la, lo, 0, n, kernel);
+	   LatLonToUtmBatch (ctx, utmXZone + i, utmYZone + i, easting + i, northing + i, la, lo, n, status ? status + i : 0, kernel);
+	  }
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y 1992 lub 2000 -> lat/lon innego ukadu odniesienia
+//=======================================================================
+//       const DatumContext& dc: kontekst zmiany ukadu odniesienia z ukadu odwzorowania
+//                               (np. CreateDatumContext (datumPulkovo42ToETRS89, true))
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000
+//       pozostae argumenty jak w PUWGToLatLonBatch (lat, lon w ukadzie docelowym dc)
+//=======================================================================
+void PUWGToLatLonDatumBatch (const DatumContext& dc, const ProjectionContext& ctx, const double* easting, const double* northing, double* lat, double* lon, size_t count, BatchKernel kernel = kernelAuto)
+{
+	kernel = ResolveBatchKernel (kernel);
+	for(size_t i = 0; i < count; i += datumBlockSize)
+	  {
+	   size_t n = count - i < datumBlockSize ? count - i : datumBlockSize;
+	   PUWGToLatLonBatch (ctx, easting + i, northing + i, lat + i, lon + i, n, kernel);
+	   DatumShiftBatch (dc, lat + i, lon + i, 0, n, kernel);
+	  }
+}
+
+//=======================================================================
+//  Konwersja wsadowa X/Y UTM -> lat/lon innego ukadu odniesienia
+//=======================================================================
+//       const DatumContext& dc: kontekst zmiany ukadu odniesienia z ukadu odwzorowania
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       pozostae argumenty jak w UtmToLatLonBatch (lat, lon w ukadzie docelowym dc)
+//=======================================================================
+void UtmToLatLonDatumBatch (const DatumContext& dc, const ProjectionContext& ctx, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, size_t count, BatchKernel kernel = kernelAuto)
+{
+	kernel = ResolveBatchKernel (kernel);
+	for(size_t i = 0; i < count; i += datumBlockSize)
+	  {
+	   size_t n = count - i < datumBlockSize ? count - i : datumBlockSize;
+	   UtmToLatLonBatch (ctx, utmXZone + i, utmYZone + i, easting + i, northing + i, lat + i, lon + i, n, kernel);
+	   DatumShiftBatch (dc, lat + i, lon + i, 0, n, kernel);
+	  }
+}
+
+#endif
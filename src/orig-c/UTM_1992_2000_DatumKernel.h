@@ -0,0 +1,149 @@
+/*
+Wektorowe jdro zmiany ukadu odniesienia (B, L, h -> X, Y, Z -> Helmert -> B, L, h)
+
+Plik doczany wielokrotnie przez UTM_1992_2000_Datum.h - raz dla kadego zestawu instrukcji,
+w przestrzeniach nazw z UTM_1992_2000_Simd.h (korzysta z ich operacji wektorowych i vsincos).
+Nie naley docza go bezporednio.
+*/
+//---------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+
+//=======================================================================
+//  Arcus tangens maego kta (|x| < datumSmallAngle), szereg do x^9
+//=======================================================================
+UTM_SIMD_TARGET static inline vd vatanSmall (vd x)
+{
+	vd x2 = vmul (x, x);
+	vd p = vset (1.0 / 9.0);
+	p = vfma (p, x2, vset (-1.0 / 7.0));
+	p = vfma (p, x2, vset (1.0 / 5.0));
+	p = vfma (p, x2, vset (-1.0 / 3.0));
+	return vfma (vmul (p, x2), x, x);
+}
+
+//=======================================================================
+//  Zmiana ukadu odniesienia W punktw (w miejscu)
+//=======================================================================
+//  B i L w ukadzie docelowym wyznaczane s jako poprawki do B i L w ukadzie
+//  rdowym (sin i cos s ju znane), zamiast atan2. Punkty, dla ktrych poprawka
+//  nie jest maym ktem (bieguny, parametry spoza zakresu), liczone s przez DatumShift.
+//=======================================================================
+UTM_SIMD_TARGET static inline void DatumShiftBlock (const DatumContext& dc, double* lat, double* lon, double* h)
+{
+	vd la = vmul (vload (lat), vset (deg2rad));
+	vd lo = vmul (vload (lon), vset (deg2rad));
+	vd hh = h ? vload (h) : vset (0.0);
+	vd sp, cp, sl, cl;
+	vsincos (la, sp, cp);
+	vsincos (lo, sl, cl);
+
+	// B, L, h -> X, Y, Z
+	vd one = vset (1.0);
+	vd n = vdiv (vset (dc.srcA), vsqrt (vsub (one, vmul (vset (dc.srcE2), vmul (sp, sp)))));
+	vd r = vmul (vadd (n, hh), cp);
+	vd x = vmul (r, cl);
+	vd y = vmul (r, sl);
+	vd z = vmul (vadd (vmul (n, vset (1.0 - dc.srcE2)), hh), sp);
+
+	// Helmert
+	const double* m = dc.m;
+	vd x2 = vfma (vset (m[2]), z, vfma (vset (m[1]), y, vfma (vset (m[0]), x, vset (dc.t[0]))));
+	vd y2 = vfma (vset (m[5]), z, vfma (vset (m[4]), y, vfma (vset (m[3]), x, vset (dc.t[1]))));
+	vd z2 = vfma (vset (m[8]), z, vfma (vset (m[7]), y, vfma (vset (m[6]), x, vset (dc.t[2]))));
+
+	// Dugo: tg(L' - L) = (Y' cos L - X' sin L) / (X' cos L + Y' sin L)
+	vd dl = vsub (vmul (y2, cl), vmul (x2, sl));
+	vd ml = vadd (vmul (x2, cl), vmul (y2, sl));
+	vd ql = vdiv (dl, ml);
+
+	// Szeroko wzorem Bowringa: sin i cos kta pomocniczego z tg = Z a / (p b)
+	vd p = vsqrt (vadd (vmul (x2, x2), vmul (y2, y2)));
+	vd u = vmul (z2, vset (dc.dstA));
+	vd v = vmul (p, vset (dc.dstB));
+	vd w = vsqrt (vadd (vmul (u, u), vmul (v, v)));
+	vd st = vdiv (u, w), ct = vdiv (v, w);
+	vd nb = vadd (z2, vmul (vset (dc.dstEp2 * dc.dstB), vmul (st, vmul (st, st))));
+	vd db = vsub (p, vmul (vset (dc.dstE2 * dc.dstA), vmul (ct, vmul (ct, ct))));
+	vd dp = vsub (vmul (nb, cp), vmul (db, sp));
+	vd mp = vadd (vmul (db, cp), vmul (nb, sp));
+	vd qp = vdiv (dp, mp);
+
+	vd zero = vset (0.0), small = vset (datumSmallAngle), msmall = vset (-datumSmallAngle);
+	vm ok = vand (vand (vgt (ml, zero), vgt (mp, zero)), vand (vand (vlt (ql, small), vgt (ql, msmall)), vand (vlt (qp, small), vgt (qp, msmall))));
+	int bad = vmask (ok) ^ ((1 << W) - 1);
+
+	vd lat2 = vadd (la, vatanSmall (qp));
+	vd lon2 = vadd (lo, vatanSmall (ql));
+	vd pi = vset (3.14159265358979323846);
+	lon2 = vsel (vgt (lon2, pi), vsub (lon2, vset (2.0 * 3.14159265358979323846)), lon2);
+	lon2 = vsel (vle (lon2, vsub (zero, pi)), vadd (lon2, vset (2.0 * 3.14159265358979323846)), lon2);
+
+	// Wysoko: sin i cos B' wprost z licznika i mianownika wzoru Bowringa
+	vd rb = vsqrt (vadd (vmul (nb, nb), vmul (db, db)));
+	vd sp2 = vdiv (nb, rb), cp2 = vdiv (db, rb);
+	vd h2 = vsub (vadd (vmul (p, cp2), vmul (z2, sp2)), vmul (vset (dc.dstA), vsqrt (vsub (one, vmul (vset (dc.dstE2), vmul (sp2, sp2))))));
+
+	double la0[W], lo0[W], h0[W];
+	if(bad)
+	  {
+	   for(int j = 0; j < W; j++)
+	     {
+	      la0[j] = lat[j];
+	      lo0[j] = lon[j];
+	      h0[j] = h ? h[j] : 0.0;
+	     }
+	  }
+	vstore (lat, vmul (lat2, vset (rad2deg)));
+	vstore (lon, vmul (lon2, vset (rad2deg)));
+	if(h) vstore (h, h2);
+	if(bad)
+	  {
+	   for(int j = 0; j < W; j++)
+	     {
+	      if(!(bad & (1 << j))) continue;
+	      DatumShift (dc, la0[j], lo0[j], h0[j]);
+	      lat[j] = la0[j];
+	      lon[j] = lo0[j];
+	      if(h) h[j] = h0[j];
+	     }
+	  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+
+//=======================================================================
+//  Wsadowa zmiana ukadu odniesienia, odpowiednik DatumShift dla count punktw
+//=======================================================================
+//  Ostatnie (count mod W) punkty liczone s w buforze uzupenionym poprawnymi wartociami.
+//=======================================================================
+UTM_SIMD_TARGET void DatumShiftKernel (const DatumContext& dc, double* lat, double* lon, double* h, size_t count)
+{
+	size_t i = 0;
+	for(; i + W <= count; i += W)
+	  {
+	   DatumShiftBlock (dc, lat + i, lon + i, h ? h + i : 0);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double la[W], lo[W], hh[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      la[j] = j < (int)rest ? lat[i + j] : 52.0;
+	      lo[j] = j < (int)rest ? lon[i + j] : 19.0;
+	      hh[j] = j < (int)rest && h ? h[i + j] : 0.0;
+	     }
+	   DatumShiftBlock (dc, la, lo, hh);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      lat[i + j] = la[j];
+	      lon[i + j] = lo[j];
+	      if(h) h[i + j] = hh[j];
+	     }
+	  }
+}
@@ -0,0 +1,901 @@
+/*
+Strumieniowe przeliczanie wsprzdnych geometrii GeoJSON i WKB midzy WGS 84, UTM, 1992 i 2000
+
+Przeksztacenie wsprzdnych (CoordinateTransform) czy dwa etapy konwersji wsadowej: ukad
+rdowy -> lat/lon i lat/lon -> ukad docelowy. Dla UTM strefa jest staa dla caego zbioru danych
+(np. EPSG:32634 - strefa 34, pkula pnocna), tak jak w plikach GIS; punkty spoza strefy s liczone
+w jej odwzorowaniu. Ukad 2000 obejmuje wszystkie cztery pasy (pas rozpoznawany po wsprzdnej
+easting lub dugoci geograficznej punktu). Wsprzdne x, y to zawsze: lon, lat (WGS 84, kolejno
+GeoJSON i WKB) lub easting, northing (Y, X w metrach).
+
+Wierzchoki geometrii s zbierane w bloki po geometryBlockSize punktw (bloki obejmuj wiele
+geometrii i obiektw) i przeliczane funkcjami wsadowymi (jdra wektorowe). Pami zajmowana przez
+przeliczenie nie zaley od wielkoci danych wejciowych:
+  WKB     - wsprzdne zapisywane w miejscu, w buforze lub pliku odwzorowanym w pamici (mmap /
+            MapViewOfFile), bez kopiowania danych; obsugiwane WKB (ISO: Z, M, ZM) i EWKB (SRID),
+            obie kolejnoci bajtw, wszystkie typy geometrii OGC (take krzywe i powierzchnie)
+  GeoJSON - tekst wejciowy przepisywany do wyjcia bez budowy drzewa dokumentu; zmieniane s tylko
+            dwie pierwsze liczby kadej pozycji w tablicach "coordinates" (wysoko i pozostae
+            elementy bez zmian), "bbox" i "crs" s przepisywane bez zmian; "coordinates" jest
+            przeliczane tylko w obiekcie geometrii: wartoci klucza "geometry", elemencie tablicy
+            "geometries", obiekcie z kluczem "type" o wartoci typu geometrii (Point ... MultiPolygon)
+            przed "coordinates" lub obiekcie najwyszego poziomu bez "type" innego typu (Feature...)
+            przed "coordinates"; nigdy wewntrz "properties" i obcych czonkw poza geometri
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Geometry_H
+#define Unit_UTM_1992_2000_Geometry_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "UTM_1992_2000_Bucketed.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Ukad wsprzdnych geometrii
+enum CoordinateSystem { crsWGS84, crsUTM, crsPUWG1992, crsPUWG2000 };
+
+//Liczba wierzchokw przeliczanych jednym wywoaniem funkcji wsadowych (2 x 8 KB bufora lat/lon)
+static const size_t geometryBlockSize = 1024;
+
+//Rozmiar porcji odczytu GeoJSON i grna granica tekstu oczekujcego na zapis (zapis wczeniej, ni blok si
+//zapeni; tekst midzy liczbami x i y jednej pozycji nie moe by duszy)
+static const size_t geoJsonChunkSize = 65536;
+static const size_t geoJsonTextLimit = 1 << 20;
+
+//Najwiksze zagniedenie tablic i obiektw GeoJSON oraz kolekcji WKB
+static const int geoJsonMaxDepth = 64;
+static const int wkbMaxDepth = 32;
+
+//Domylna liczba miejsc po przecinku zapisywanych wsprzdnych GeoJSON (ok. 0.1 mm): stopnie, metry
+static const int geoJsonDecimalsDegrees = 9;
+static const int geoJsonDecimalsMetres = 4;
+
+//Najwiksza dugo zapisu liczby (FormatJsonNumber): do 21 znakw liczby staoprzecinkowej, do 24 - %.17g
+static const int geoJsonNumberSize = 32;
+
+//=======================================================================
+//  Ukad wsprzdnych: rodzaj i (dla UTM) strefa
+//=======================================================================
+//      Dla UTM strefa rwnolenikowa wyznacza tylko pkul (C..M - poudniowa, faszywa pnoc 10000000 m)
+//=======================================================================
+struct CoordinateReference
+{
+	CoordinateSystem system;
+	int utmXZone;
+	char utmYZone;
+};
+
+CoordinateReference MakeCoordinateReference (CoordinateSystem system, int utmXZone = 0, char utmYZone = 'N')
+{
+	CoordinateReference ref;
+	ref.system = system;
+	ref.utmXZone = utmXZone;
+	ref.utmYZone = utmYZone;
+	return ref;
+}
+
+//=======================================================================
+//  Przeksztacenie wsprzdnych midzy dwoma ukadami (ta sama elipsoida)
+//=======================================================================
+struct CoordinateTransform
+{
+	CoordinateReference src;
+	CoordinateReference dst;
+	// Konteksty odwzorowa (dla UTM faszywa pnoc pkuli strefy, dla WGS 84 nieuywane)
+	ProjectionContext srcCtx;
+	ProjectionContext dstCtx;
+	BatchKernel kernel;
+	// Ukady identyczne - wsprzdne bez zmian
+	bool identity;
+};
+
+//Pkula poudniowa strefy UTM (jak w UtmToLatLon)
+inline bool UtmSouthBand (char utmYZone)
+{
+	return (utmYZone <= 'M' && utmYZone >= 'C') || (utmYZone <= 'm' && utmYZone >= 'c');
+}
+
+//Kontekst odwzorowania ukadu wsprzdnych
+ProjectionContext CoordinateContext (double a, double f, const CoordinateReference& ref, ProjectionEngine engine)
+{
+	ProjectionType proj = ref.system == crsPUWG1992 ? projPUWG1992 : (ref.system == crsPUWG2000 ? projPUWG2000 : projUTM);
+	ProjectionContext ctx = CreateProjectionContext (a, f, proj, engine);
+	if(ref.system == crsUTM && !UtmSouthBand (ref.utmYZone)) ctx.nfn = 0.0;
+	return ctx;
+}
+
+//=======================================================================
+//  Funkcja wyznacza przeksztacenie wsprzdnych dla dowolnej elipsoidy
+//=======================================================================
+//       double a: dugo duej posi elipsoidy odniesienia, w metrach (np. dla elipsoidy WGS 84, 6378137.0)
+//       double f: spaszczenie elipsoidalne (np. dla elipsoidy WGS 84, 1 / 298.257223563)
+//       CoordinateReference src, dst: ukad rdowy i docelowy (MakeCoordinateReference)
+//       ProjectionEngine engine: metoda oblicze (engineClassic, engineKruger)
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+CoordinateTransform CreateCoordinateTransform (double a, double f, CoordinateReference src, CoordinateReference dst, ProjectionEngine engine = engineClassic, BatchKernel kernel = kernelAuto)
+{
+	CoordinateTransform ct;
+	ct.src = src;
+	ct.dst = dst;
+	ct.srcCtx = CoordinateContext (a, f, src, engine);
+	ct.dstCtx = CoordinateContext (a, f, dst, engine);
+	ct.kernel = ResolveBatchKernel (kernel);
+	ct.identity = src.system == dst.system
+	              && (src.system != crsUTM || (src.utmXZone == dst.utmXZone && UtmSouthBand (src.utmYZone) == UtmSouthBand (dst.utmYZone)));
+	return ct;
+}
+
+//Przeksztacenie wsprzdnych dla elipsoidy WGS 84
+CoordinateTransform CreateCoordinateTransformWGS84 (CoordinateReference src, CoordinateReference dst, ProjectionEngine engine = engineClassic)
+{
+	return CreateCoordinateTransform (6378137.0, 1 / 298.257223563, src, dst, engine);
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Wsadowe przeksztacenie wsprzdnych x, y (w miejscu)
+//=======================================================================
+//       const CoordinateTransform& ct: przeksztacenie (CreateCoordinateTransform)
+//       double* x, double* y: lon, lat [stopnie] lub easting, northing [metry]; zastpowane wynikiem
+//       size_t count: liczba punktw
+//       unsigned char* status: status kadego punktu (statusOK, statusLonOutOfRange - ukad docelowy 1992
+//                              lub 2000 i dugo poza zakresem 13.5 - 25.5, wynik 999999999999999) lub 0
+//=======================================================================
+void TransformCoordinatesBatch (const CoordinateTransform& ct, double* x, double* y, size_t count, unsigned char* status = 0)
+{
+	UTM_STATS_CALL (statsTransformCoordinatesBatch, count);
+	double lat[geometryBlockSize];
+	double lon[geometryBlockSize];
+	for(size_t i = 0; i < count; i += geometryBlockSize)
+	  {
+	   size_t n = count - i < geometryBlockSize ? count - i : geometryBlockSize;
+	   double* bx = x + i;
+	   double* by = y + i;
+	   unsigned char* bs = status ? status + i : 0;
+	   if(bs) memset (bs, statusOK, n);
+	   if(ct.identity) continue;
+	   // Etap 1: ukad rdowy -> lat/lon [stopnie]
+	   switch(ct.src.system)
+	     {
+	      case crsWGS84:
+	        memcpy (lon, bx, n * sizeof (double));
+	        memcpy (lat, by, n * sizeof (double));
+	        break;
+	      case crsUTM:
+	        InverseUniform (ct.kernel, ct.srcCtx, UtmCentralMeridian (ct.src.utmXZone), 0.0, ct.srcCtx.nfn, bx, by, lat, lon, n);
+	        break;
+	      default:
+	        PUWGToLatLonBatch (ct.srcCtx, bx, by, lat, lon, n, ct.kernel);
+	        break;
+	     }
+	   // Etap 2: lat/lon -> ukad docelowy
+	   switch(ct.dst.system)
+	     {
+	      case crsWGS84:
+	        memcpy (bx, lon, n * sizeof (double));
+	        memcpy (by, lat, n * sizeof (double));
+	        break;
+	      case crsUTM:
+	        ForwardUniform (ct.kernel, ct.dstCtx, false, UtmCentralMeridian (ct.dst.utmXZone), ct.dstCtx.fe, lat, lon, bx, by, n);
+	        break;
+	      default:
+	        LatLonToPUWGBatch (ct.dstCtx, bx, by, lat, lon, n, bs, ct.kernel);
+	        break;
+	     }
+	  }
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// WKB
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//Kolejno bajtw procesora: true dla little endian (NDR)
+inline bool HostLittleEndian ()
+{
+	const uint16_t one = 1;
+	return *(const unsigned char*)&one == 1;
+}
+
+inline uint32_t ByteSwap32 (uint32_t v)
+{
+	return (v >> 24) | ((v >> 8) & 0xFF00u) | ((v << 8) & 0xFF0000u) | (v << 24);
+}
+
+inline uint64_t ByteSwap64 (uint64_t v)
+{
+	return ((uint64_t)ByteSwap32 ((uint32_t)v) << 32) | ByteSwap32 ((uint32_t)(v >> 32));
+}
+
+//Odczyt i zapis liczby double WKB (dowolne wyrwnanie, swap - kolejno bajtw inna ni procesora)
+inline double WkbGetDouble (const unsigned char* p, bool swap)
+{
+	uint64_t u;
+	memcpy (&u, p, 8);
+	if(swap) u = ByteSwap64 (u);
+	double v;
+	memcpy (&v, &u, 8);
+	return v;
+}
+
+inline void WkbPutDouble (unsigned char* p, bool swap, double v)
+{
+	uint64_t u;
+	memcpy (&u, &v, 8);
+	if(swap) u = ByteSwap64 (u);
+	memcpy (p, &u, 8);
+}
+
+inline bool WkbGetUInt32 (unsigned char*& p, const unsigned char* end, bool swap, uint32_t& v)
+{
+	if(end - p < 4) return false;
+	memcpy (&v, p, 4);
+	if(swap) v = ByteSwap32 (v);
+	p += 4;
+	return true;
+}
+
+//=======================================================================
+//  Kolejka wierzchokw WKB: adresy wsprzdnych w buforze, przeliczane blokami
+//=======================================================================
+struct WkbVertexQueue
+{
+	const CoordinateTransform& ct;
+	unsigned char* vertex[geometryBlockSize];
+	bool swap[geometryBlockSize];
+	double x[geometryBlockSize];
+	double y[geometryBlockSize];
+	unsigned char status[geometryBlockSize];
+	size_t count;
+	size_t outOfRange;
+
+	WkbVertexQueue (const CoordinateTransform& t) : ct (t), count (0), outOfRange (0) {}
+
+	void Flush ()
+	{
+		for(size_t i = 0; i < count; i++)
+		  {
+		   x[i] = WkbGetDouble (vertex[i], swap[i]);
+		   y[i] = WkbGetDouble (vertex[i] + 8, swap[i]);
+		  }
+		TransformCoordinatesBatch (ct, x, y, count, status);
+		for(size_t i = 0; i < count; i++)
+		  {
+		   WkbPutDouble (vertex[i], swap[i], x[i]);
+		   WkbPutDouble (vertex[i] + 8, swap[i], y[i]);
+		   if(status[i] != statusOK) outOfRange++;
+		  }
+		count = 0;
+	}
+
+	void Add (unsigned char* p, bool s)
+	{
+		vertex[count] = p;
+		swap[count] = s;
+		if(++count == geometryBlockSize) Flush ();
+	}
+};
+
+//Rodzaj zawartoci geometrii WKB wg. typu OGC: jeden punkt, lista punktw, lista piercieni, kolekcja geometrii
+enum WkbContent { wkbPoint, wkbPointList, wkbRingList, wkbCollection, wkbUnknown };
+
+inline WkbContent WkbContentOf (uint32_t type)
+{
+	switch(type)
+	  {
+	   case 1: return wkbPoint;
+	   case 2: case 8: return wkbPointList;              // LineString, CircularString
+	   case 3: case 17: return wkbRingList;              // Polygon, Triangle
+	   case 4: case 5: case 6: case 7:                    // Multi*, GeometryCollection
+	   case 9: case 10: case 11: case 12:                 // CompoundCurve, CurvePolygon, MultiCurve, MultiSurface
+	   case 15: case 16: return wkbCollection;           // PolyhedralSurface, TIN
+	  }
+	return wkbUnknown;
+}
+
+//=======================================================================
+//  Funkcja przelicza w miejscu wsprzdne geometrii WKB zapisanych kolejno w buforze
+//=======================================================================
+//       const CoordinateTransform& ct: przeksztacenie (CreateCoordinateTransform)
+//       unsigned char* wkb: bufor z jedn lub wieloma geometriami WKB / EWKB zapisanymi jedna za drug
+//       size_t size: rozmiar bufora [bajty]
+//       size_t* outOfRange: liczba punktw spoza zakresu ukadu docelowego (status rny od statusOK) lub 0
+//       wynik: false dla bdnego lub niepenego zapisu WKB; przeliczone s wtedy wierzchoki
+//              geometrii zapisanych przed miejscem bdu
+//=======================================================================
+//      Pusty punkt (wsprzdne NaN) pozostaje bez zmian. Przeliczane s tylko wsprzdne x, y;
+//      z i m pozostaj bez zmian.
+//=======================================================================
+bool ReprojectWkb (const CoordinateTransform& ct, unsigned char* wkb, size_t size, size_t* outOfRange = 0)
+{
+	WkbVertexQueue q (ct);
+	bool host = HostLittleEndian ();
+	unsigned char* p = wkb;
+	const unsigned char* end = wkb + size;
+	uint32_t remaining[wkbMaxDepth];
+	int depth = 0;
+	bool ok = true;
+	while(ok && (depth > 0 || p < end))
+	  {
+	   if(depth > 0 && remaining[depth - 1] == 0)
+	     {
+	      depth--;
+	      continue;
+	     }
+	   if(depth > 0) remaining[depth - 1]--;
+	   // Nagwek geometrii: kolejno bajtw, typ (ISO: + 1000 Z, + 2000 M, + 3000 ZM; EWKB: flagi Z, M, SRID)
+	   if(end - p < 1 || *p > 1)
+	     {
+	      ok = false;
+	      break;
+	     }
+	   bool swap = (*p++ == 1) != host;
+	   uint32_t type;
+	   if(!WkbGetUInt32 (p, end, swap, type))
+	     {
+	      ok = false;
+	      break;
+	     }
+	   bool hasZ = (type & 0x80000000u) != 0;
+	   bool hasM = (type & 0x40000000u) != 0;
+	   bool hasSrid = (type & 0x20000000u) != 0;
+	   type &= 0x0FFFFFFFu;
+	   uint32_t iso = type / 1000;
+	   type %= 1000;
+	   if(iso == 1 || iso == 3) hasZ = true;
+	   if(iso == 2 || iso == 3) hasM = true;
+	   uint32_t srid;
+	   WkbContent content = WkbContentOf (type);
+	   if(iso > 3 || content == wkbUnknown || (hasSrid && !WkbGetUInt32 (p, end, swap, srid)))
+	     {
+	      ok = false;
+	      break;
+	     }
+	   size_t stride = 8 * (2 + (hasZ ? 1 : 0) + (hasM ? 1 : 0));
+	   uint32_t n = 1;
+	   switch(content)
+	     {
+	      case wkbCollection:
+	        if(!WkbGetUInt32 (p, end, swap, n) || depth == wkbMaxDepth) ok = false;
+	        else remaining[depth++] = n;
+	        break;
+	      case wkbPoint:
+	        if((size_t)(end - p) < stride) ok = false;
+	        else
+	          {
+	           if(!isnan (WkbGetDouble (p, swap))) q.Add (p, swap);
+	           p += stride;
+	          }
+	        break;
+	      default:
+	        // Lista punktw lub lista piercieni (kady piercie to lista punktw)
+	        uint32_t rings = 1;
+	        if(content == wkbRingList && !WkbGetUInt32 (p, end, swap, rings)) ok = false;
+	        for(uint32_t r = 0; ok && r < rings; r++)
+	          {
+	           if(!WkbGetUInt32 (p, end, swap, n) || n > (size_t)(end - p) / stride)
+	             {
+	              ok = false;
+	              break;
+	             }
+	           for(uint32_t k = 0; k < n; k++, p += stride) q.Add (p, swap);
+	          }
+	        break;
+	     }
+	  }
+	q.Flush ();
+	if(outOfRange) *outOfRange = q.outOfRange;
+	return ok;
+}
+
+//=======================================================================
+//  Funkcja przelicza w miejscu wsprzdne geometrii WKB zapisanych kolejno w pliku
+//=======================================================================
+//      Plik jest odwzorowany w pamici do zapisu (zmiany trafiaj bezporednio do pliku),
+//      parametry i wynik jak w ReprojectWkb; false rwnie, gdy pliku nie mona otworzy.
+//=======================================================================
+bool ReprojectWkbFile (const CoordinateTransform& ct, const char* path, size_t* outOfRange = 0)
+{
+	unsigned char* view = 0;
+	size_t size = 0;
+	if(outOfRange) *outOfRange = 0;
+#ifdef _WIN32
+	HANDLE file = CreateFileA (path, GENERIC_READ | GENERIC_WRITE, 0, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if(file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER length;
+	if(GetFileSizeEx (file, &length) && length.QuadPart > 0)
+	  {
+	   HANDLE mapping = CreateFileMappingA (file, 0, PAGE_READWRITE, 0, 0, 0);
+	   if(mapping)
+	     {
+	      view = (unsigned char*)MapViewOfFile (mapping, FILE_MAP_WRITE, 0, 0, 0);
+	      size = (size_t)length.QuadPart;
+	      CloseHandle (mapping);
+	     }
+	  }
+	else if(GetFileSizeEx (file, &length))
+	  {
+	   // Pusty plik - brak geometrii
+	   CloseHandle (file);
+	   return true;
+	  }
+	CloseHandle (file);
+#else
+	int file = open (path, O_RDWR);
+	if(file < 0) return false;
+	struct stat st;
+	if(fstat (file, &st) == 0 && st.st_size == 0)
+	  {
+	   // Pusty plik - brak geometrii
+	   close (file);
+	   return true;
+	  }
+	if(fstat (file, &st) == 0 && st.st_size > 0)
+	  {
+	   void* p = mmap (0, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	   if(p != MAP_FAILED)
+	     {
+	      view = (unsigned char*)p;
+	      size = (size_t)st.st_size;
+	     }
+	  }
+	close (file);
+#endif
+	if(!view) return false;
+	bool ok = ReprojectWkb (ct, view, size, outOfRange);
+#ifdef _WIN32
+	FlushViewOfFile (view, 0);
+	UnmapViewOfFile (view);
+#else
+	munmap (view, size);
+#endif
+	return ok;
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// GeoJSON
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//Klucze obiektu GeoJSON rozpoznawane przy przeliczaniu
+enum GeoJsonMember { geoJsonOtherMember, geoJsonCoordinates, geoJsonType, geoJsonGeometry, geoJsonGeometries, geoJsonProperties };
+
+//Rodzaj obiektu lub tablicy na stosie: geometria ("coordinates" przeliczane), tablica "geometries",
+//inny, wntrze "properties" (nic nie jest przeliczane)
+enum GeoJsonContext { geoJsonOtherContext, geoJsonGeometryContext, geoJsonGeometriesContext, geoJsonPropertiesContext };
+
+inline GeoJsonMember GeoJsonMemberOf (const char* key, size_t len)
+{
+	if(len == 11 && memcmp (key, "coordinates", 11) == 0) return geoJsonCoordinates;
+	if(len == 4 && memcmp (key, "type", 4) == 0) return geoJsonType;
+	if(len == 8 && memcmp (key, "geometry", 8) == 0) return geoJsonGeometry;
+	if(len == 10 && memcmp (key, "geometries", 10) == 0) return geoJsonGeometries;
+	if(len == 10 && memcmp (key, "properties", 10) == 0) return geoJsonProperties;
+	return geoJsonOtherMember;
+}
+
+//Typ geometrii z tablic "coordinates"
+inline bool GeoJsonCoordinatesType (const char* type, size_t len)
+{
+	static const char* const types[] = { "Point", "MultiPoint", "LineString", "MultiLineString", "Polygon", "MultiPolygon" };
+	for(size_t i = 0; i < sizeof (types) / sizeof (types[0]); i++)
+	  {
+	   if(strlen (types[i]) == len && memcmp (type, types[i], len) == 0) return true;
+	  }
+	return false;
+}
+
+//=======================================================================
+//  Odczyt liczby JSON (token o dugoci len, bez zera na kocu)
+//=======================================================================
+//      Do 19 cyfr znaczcych i wykadnik dziesitny do 22: wynik dokadny (mantysa i potga 10
+//      dokadne w double, jedno zaokrglenie); pozostae liczby - strtod.
+//=======================================================================
+bool ParseJsonNumber (const char* s, size_t len, double& v)
+{
+	static const double pow10[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	const char* p = s;
+	const char* end = s + len;
+	bool negative = p < end && *p == '-';
+	if(negative) p++;
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exp10 = 0;
+	bool any = false;
+	for(; p < end && *p >= '0' && *p <= '9'; p++, any = true)
+	  {
+	   if(digits < 19) { mantissa = mantissa * 10 + (uint64_t)(*p - '0'); if(mantissa) digits++; }
+	   else exp10++;
+	  }
+	if(p < end && *p == '.')
+	  {
+	   for(p++; p < end && *p >= '0' && *p <= '9'; p++, any = true)
+	     {
+	      if(digits < 19) { mantissa = mantissa * 10 + (uint64_t)(*p - '0'); if(mantissa) digits++; exp10--; }
+	     }
+	  }
+	if(!any) return false;
+	if(p < end && (*p == 'e' || *p == 'E'))
+	  {
+	   p++;
+	   bool expNegative = p < end && *p == '-';
+	   if(p < end && (*p == '-' || *p == '+')) p++;
+	   int e = 0;
+	   bool expAny = false;
+	   for(; p < end && *p >= '0' && *p <= '9'; p++, expAny = true) if(e < 10000) e = e * 10 + (*p - '0');
+	   if(!expAny) return false;
+	   exp10 += expNegative ? -e : e;
+	  }
+	if(p != end) return false;
+	if(mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+	  {
+	   v = exp10 >= 0 ? (double)mantissa * pow10[exp10] : (double)mantissa / pow10[-exp10];
+	   if(negative) v = -v;
+	   return true;
+	  }
+	char buf[80];
+	if(len >= sizeof (buf)) return false;
+	memcpy (buf, s, len);
+	buf[len] = 0;
+	v = strtod (buf, 0);
+	return true;
+}
+
+//=======================================================================
+//  Zapis liczby z decimals miejscami po przecinku, bez kocowych zer (wynik: liczba znakw)
+//=======================================================================
+//      char* buf: bufor wyniku, co najmniej geoJsonNumberSize znakw (bez koczcego zera)
+//      NaN i nieskoczono zapisywane jako null (JSON nie ma ich zapisu), liczby, ktrych
+//      |v| * 10^decimals przekracza zakres liczb 64-bitowych - najkrtszym z zapisw %.15g, %.16g,
+//      %.17g odtwarzajcym liczb (np. 999999999999999 lub 1e+300)
+//=======================================================================
+int FormatJsonNumber (double v, int decimals, char* buf)
+{
+	static const double scale[13] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12 };
+	if(isnan (v) || isinf (v))
+	  {
+	   memcpy (buf, "null", 4);
+	   return 4;
+	  }
+	if(decimals < 0) decimals = 0;
+	if(decimals > 12) decimals = 12;
+	double s = v * scale[decimals];
+	if(!(fabs (s) < 9.0e18))
+	  {
+	   // Poza zakresem liczb 64-bitowych (np. wynik 999999999999999 przy 4 miejscach): najwyej 17 cyfr
+	   // znaczcych, wic nie wicej miejsc po przecinku ni decimals; zapis %.17g ma najwyej 24 znaki
+	   char tmp[geoJsonNumberSize + 1];
+	   int n = 0;
+	   for(int digits = 15; digits <= 17; digits++)
+	     {
+	      n = snprintf (tmp, sizeof (tmp), "%.*g", digits, v);
+	      if(strtod (tmp, 0) == v) break;
+	     }
+	   if(n < 0) n = 0;
+	   if(n > geoJsonNumberSize) n = geoJsonNumberSize;
+	   memcpy (buf, tmp, (size_t)n);
+	   return n;
+	  }
+	long long r = llround (s);
+	char* p = buf;
+	if(r < 0)
+	  {
+	   *p++ = '-';
+	   r = -r;
+	  }
+	uint64_t u = (uint64_t)r;
+	uint64_t unit = (uint64_t)scale[decimals];
+	uint64_t ip = u / unit;
+	uint64_t fp = u % unit;
+	char tmp[24];
+	int n = 0;
+	do
+	  {
+	   tmp[n++] = (char)('0' + ip % 10);
+	   ip /= 10;
+	  }
+	while(ip);
+	while(n) *p++ = tmp[--n];
+	if(fp)
+	  {
+	   int d = decimals;
+	   while(fp % 10 == 0)
+	     {
+	      fp /= 10;
+	      d--;
+	     }
+	   *p++ = '.';
+	   for(int k = d - 1; k >= 0; k--)
+	     {
+	      p[k] = (char)('0' + fp % 10);
+	      fp /= 10;
+	     }
+	   p += d;
+	  }
+	return (int)(p - buf);
+}
+
+//=======================================================================
+//  Strumie GeoJSON: tekst oczekujcy na zapis i wierzchoki bloku
+//=======================================================================
+//      Tekst wejciowy jest przepisywany do bufora text z pominiciem liczb x, y pozycji;
+//      xSlot, ySlot - miejsca tych liczb w buforze, wstawiane przy zapisie po przeliczeniu bloku.
+//      Flush (true) - po liczbie x bez y (pozycja x[count] oczekuje): zapis koczy si na xSlot[count],
+//      dalszy tekst i liczba x pozostaj w buforze.
+//=======================================================================
+struct GeoJsonStream
+{
+	const CoordinateTransform& ct;
+	FILE* out;
+	int decimals;
+	std::vector<char> text;
+	std::vector<char> output;
+	size_t xSlot[geometryBlockSize];
+	size_t ySlot[geometryBlockSize];
+	double x[geometryBlockSize];
+	double y[geometryBlockSize];
+	unsigned char status[geometryBlockSize];
+	size_t count;
+	size_t outOfRange;
+	bool failed;
+
+	GeoJsonStream (const CoordinateTransform& t, FILE* o, int d) : ct (t), out (o), decimals (d), count (0), outOfRange (0), failed (false)
+	{
+		text.reserve (geoJsonChunkSize);
+		output.reserve (geoJsonChunkSize);
+	}
+
+	//Przeliczenie wierzchokw bloku i zapis tekstu
+	void Flush (bool pending = false)
+	{
+		TransformCoordinatesBatch (ct, x, y, count, status);
+		output.clear ();
+		size_t from = 0;
+		char num[geoJsonNumberSize];
+		for(size_t i = 0; i < count; i++)
+		  {
+		   output.insert (output.end (), text.begin () + from, text.begin () + xSlot[i]);
+		   output.insert (output.end (), num, num + FormatJsonNumber (x[i], decimals, num));
+		   output.insert (output.end (), text.begin () + xSlot[i], text.begin () + ySlot[i]);
+		   output.insert (output.end (), num, num + FormatJsonNumber (y[i], decimals, num));
+		   from = ySlot[i];
+		   if(status[i] != statusOK) outOfRange++;
+		  }
+		size_t end = pending ? xSlot[count] : text.size ();
+		output.insert (output.end (), text.begin () + from, text.begin () + end);
+		if(!output.empty () && fwrite (&output[0], 1, output.size (), out) != output.size ()) failed = true;
+		text.erase (text.begin (), text.begin () + end);
+		if(pending)
+		  {
+		   xSlot[0] = 0;
+		   x[0] = x[count];
+		  }
+		count = 0;
+	}
+};
+
+//=======================================================================
+//  Funkcja przelicza wsprzdne geometrii dokumentu GeoJSON
+//=======================================================================
+//       const CoordinateTransform& ct: przeksztacenie (CreateCoordinateTransform)
+//       FILE* in: dokument GeoJSON (FeatureCollection, Feature, geometria lub ich cig, np. GeoJSON Text Sequences)
+//       FILE* out: dokument wynikowy - tekst wejciowy z przeliczonymi wsprzdnymi x, y pozycji
+//       int decimals: liczba miejsc po przecinku wsprzdnych (-1: geoJsonDecimalsDegrees dla WGS 84,
+//                     geoJsonDecimalsMetres dla pozostaych ukadw)
+//       size_t* outOfRange: liczba pozycji spoza zakresu ukadu docelowego lub 0
+//       wynik: false dla bdnej struktury dokumentu (nawiasy, niezakoczony cig, pozycja z jedn
+//              liczb, zbyt gbokie zagniedenie, wicej ni geoJsonTextLimit znakw midzy liczbami
+//              x i y pozycji) lub bdu zapisu
+//=======================================================================
+bool ReprojectGeoJson (const CoordinateTransform& ct, FILE* in, FILE* out, int decimals = -1, size_t* outOfRange = 0)
+{
+	if(decimals < 0) decimals = ct.dst.system == crsWGS84 ? geoJsonDecimalsDegrees : geoJsonDecimalsMetres;
+	GeoJsonStream js (ct, out, decimals);
+	std::vector<char> chunk (geoJsonChunkSize);
+	// Stos tablic i obiektw: '[' lub '{' i rodzaj (GeoJsonContext)
+	char stack[geoJsonMaxDepth];
+	char context[geoJsonMaxDepth];
+	int depth = 0;
+	// Gboko tablicy "coordinates" (-1 poza ni), nr liczby w biecej tablicy
+	int coordDepth = -1;
+	int numberIndex = 0;
+	// Cig znakw: wewntrz, po znaku \, klucz obiektu lub warto "type" i ich pierwsze znaki
+	bool inString = false;
+	bool escape = false;
+	bool expectKey = false;
+	bool isKey = false;
+	bool isType = false;
+	char key[20];
+	size_t keyLen = 0;
+	// Klucz oczekujcy na warto i klucz biecej wartoci
+	GeoJsonMember valueKey = geoJsonOtherMember;
+	bool keyPending = false;
+	GeoJsonMember member = geoJsonOtherMember;
+	// Liczba: wewntrz i jej znaki
+	bool inNumber = false;
+	char number[64];
+	size_t numberLen = 0;
+	bool ok = true;
+	size_t n;
+	bool eof = false;
+	while(ok && !eof)
+	  {
+	   n = fread (&chunk[0], 1, chunk.size (), in);
+	   // Po kocu danych jeden przebieg ze spacj koczy ewentualn liczb
+	   if(n == 0)
+	     {
+	      eof = true;
+	      chunk[0] = ' ';
+	      n = 1;
+	     }
+	   for(size_t i = 0; ok && i < n; i++)
+	     {
+	      // Tekst ograniczony take wewntrz pozycji i dugich cigw znakw
+	      if(js.text.size () > geoJsonTextLimit)
+	        {
+	         js.Flush (coordDepth >= 0 && numberIndex == 1);
+	         if(js.text.size () > geoJsonTextLimit)
+	           {
+	            ok = false;
+	            break;
+	           }
+	        }
+	      char c = chunk[i];
+	      if(inString)
+	        {
+	         if(!eof) js.text.push_back (c);
+	         if(escape) escape = false;
+	         else if(c == '\\') escape = true;
+	         else if(c == '"')
+	           {
+	            inString = false;
+	            if(isKey)
+	              {
+	               valueKey = GeoJsonMemberOf (key, keyLen);
+	               keyPending = true;
+	              }
+	            // "type" ustala rodzaj obiektu (poza "properties")
+	            if(isType && context[depth - 1] != geoJsonPropertiesContext)
+	              {
+	               context[depth - 1] = GeoJsonCoordinatesType (key, keyLen) ? geoJsonGeometryContext : geoJsonOtherContext;
+	              }
+	           }
+	         else if((isKey || isType) && keyLen < sizeof (key)) key[keyLen++] = c;
+	         continue;
+	        }
+	      if(inNumber)
+	        {
+	         if((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E')
+	           {
+	            if(numberLen == sizeof (number)) ok = false;
+	            else number[numberLen++] = c;
+	            continue;
+	           }
+	         inNumber = false;
+	         if(coordDepth >= 0 && numberIndex < 2)
+	           {
+	            double v;
+	            if(!ParseJsonNumber (number, numberLen, v)) ok = false;
+	            else if(numberIndex == 0)
+	              {
+	               js.xSlot[js.count] = js.text.size ();
+	               js.x[js.count] = v;
+	              }
+	            else
+	              {
+	               js.ySlot[js.count] = js.text.size ();
+	               js.y[js.count] = v;
+	               if(++js.count == geometryBlockSize) js.Flush ();
+	              }
+	           }
+	         else js.text.insert (js.text.end (), number, number + numberLen);
+	         numberIndex++;
+	        }
+	      if(eof) break;
+	      // Pocztek wartoci po kluczu; "coordinates" obiektu geometrii: tablica pozycji
+	      bool value = c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != ':' && c != ',';
+	      member = geoJsonOtherMember;
+	      if(value && keyPending && !(c == '"' && expectKey))
+	        {
+	         keyPending = false;
+	         member = valueKey;
+	         if(member == geoJsonCoordinates && c == '[' && coordDepth < 0 && context[depth - 1] == geoJsonGeometryContext) coordDepth = depth + 1;
+	        }
+	      switch(c)
+	        {
+	         case '{':
+	         case '[':
+	           if(depth == geoJsonMaxDepth)
+	             {
+	              ok = false;
+	              break;
+	             }
+	           // Pozycja z jedn liczb i zagniedon tablic
+	           if(coordDepth >= 0 && numberIndex == 1)
+	             {
+	              ok = false;
+	              break;
+	             }
+	           // Rodzaj: obiekt najwyszego poziomu, warto "geometry" i element "geometries" - geometria
+	           if(depth == 0) context[depth] = c == '{' ? geoJsonGeometryContext : geoJsonOtherContext;
+	           else if(context[depth - 1] == geoJsonPropertiesContext || member == geoJsonProperties) context[depth] = geoJsonPropertiesContext;
+	           else if(stack[depth - 1] == '[') context[depth] = c == '{' && context[depth - 1] == geoJsonGeometriesContext ? geoJsonGeometryContext : geoJsonOtherContext;
+	           else if(member == geoJsonGeometry && c == '{') context[depth] = geoJsonGeometryContext;
+	           else if(member == geoJsonGeometries && c == '[') context[depth] = geoJsonGeometriesContext;
+	           else context[depth] = geoJsonOtherContext;
+	           stack[depth++] = c;
+	           expectKey = c == '{';
+	           numberIndex = 0;
+	           break;
+	         case '}':
+	         case ']':
+	           if(depth == 0 || stack[depth - 1] != (c == '}' ? '{' : '['))
+	             {
+	              ok = false;
+	              break;
+	             }
+	           // Pozycja z jedn liczb
+	           if(c == ']' && coordDepth >= 0 && numberIndex == 1) ok = false;
+	           if(depth == coordDepth) coordDepth = -1;
+	           depth--;
+	           expectKey = false;
+	           // Po zamkniciu pozycji kolejne liczby tablicy nadrzdnej nie s jej elementami x, y
+	           numberIndex = 2;
+	           break;
+	         case ',':
+	           expectKey = depth > 0 && stack[depth - 1] == '{';
+	           break;
+	         case '"':
+	           inString = true;
+	           isKey = expectKey;
+	           isType = member == geoJsonType;
+	           expectKey = false;
+	           keyLen = 0;
+	           break;
+	         default:
+	           if(c == '-' || (c >= '0' && c <= '9'))
+	             {
+	              inNumber = true;
+	              number[0] = c;
+	              numberLen = 1;
+	              continue;
+	             }
+	           break;
+	        }
+	      js.text.push_back (c);
+	      // Tekst bez oczekujcych wierzchokw zapisywany po przekroczeniu porcji
+	      if(js.count == 0 && (coordDepth < 0 || numberIndex != 1) && js.text.size () >= geoJsonChunkSize) js.Flush ();
+	     }
+	  }
+	if(inString || depth != 0) ok = false;
+	if(ok) js.Flush ();
+	if(outOfRange) *outOfRange = js.outOfRange;
+	return ok && !js.failed && !ferror (in);
+}
+
+#endif
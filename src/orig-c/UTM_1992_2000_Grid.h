@@ -0,0 +1,546 @@
+/*
+Siatka interpolacyjna dla przyblionych konwersji lat/lon <-> X/Y 1992 i 2000 na obszarze Polski
+Wzy siatki (osobnej dla kadego pasa odwzorowania) s wyznaczane dokadnymi wzorami odwzorowania
+Gaussa-Krgera, a konwersja punktu to interpolacja dwuliniowa (4 wzy) lub dwuszecienna
+(Catmull-Rom, 16 wzw) - kilka odczytw z pamici i mnoe zamiast funkcji trygonometrycznych.
+Najwikszy bd interpolacji jest szacowany podczas budowy siatki (w 15 punktach prbnych kadego
+oczka, nie jest to ograniczenie gwarantowane) i zapisywany razem z ni.
+
+Siatka moe by zapisana do pliku i odwzorowana w pamici (mmap / MapViewOfFile) - bez wczytywania
+i bez ponownej budowy. Format pliku zaley od platformy (kolejno bajtw, sprawdzana przy otwarciu).
+Punkty spoza obszaru siatki s liczone dokadnie (LatLonToPUWG, PUWGToLatLon).
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Grid_H
+#define Unit_UTM_1992_2000_Grid_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "UTM_1992_2000.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Metoda interpolacji
+enum GridInterpolation { gridBilinear, gridBicubic };
+
+//Kierunek konwersji (indeks tablicy bdw)
+enum GridDirection { gridForward, gridInverse };
+
+//Domylny zakres szerokoci geograficznej siatki [stopnie] (obszar Polski z zapasem)
+static const double gridLatMin = 49.0;
+static const double gridLatMax = 55.0;
+
+//Identyfikacja pliku siatki
+static const char gridMagic[8] = { 'P', 'U', 'W', 'G', 'G', 'R', 'I', 'D' };
+static const uint32_t gridVersion = 1;
+static const uint32_t gridByteOrder = 0x01020304;
+
+//Siatka jednego pasa: wzy (x0 + i * step, y0 + j * step), i < nx, j < ny; dwie wartoci double na wze,
+//wiersze kolejno wg. y. Obszar interpolacji [xMin, xMax] x [yMin, yMax] ma z kadej strony jeden wze zapasu.
+//  kierunek prosty: x - dugo, y - szeroko geograficzna [stopnie], wartoci easting, northing [metry]
+//  kierunek odwrotny: x - easting, y - northing [metry], wartoci szeroko, dugo geograficzna [stopnie]
+struct GridStrip
+{
+	double x0, y0;
+	double step, rstep;
+	double xMin, xMax, yMin, yMax;
+	uint32_t nx, ny;
+	uint64_t offset;        // pooenie pierwszego wza w tablicy danych [liczba double]
+};
+
+//Nagwek pliku siatki (dane wzw zaczynaj si od przesunicia dataOffset)
+struct GridHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	int32_t proj;
+	int32_t engine;
+	double a, f;
+	double latMin, latMax, step;
+	uint32_t strips;
+	int32_t precision;      // poziom dokadnoci kontekstu (ProjectionPrecision)
+	GridStrip fwd[4];
+	GridStrip inv[4];
+	double maxError[2][2];  // [GridDirection][GridInterpolation], najwikszy bd na powierzchni ziemi w punktach
+	                        // prbnych (MeasureGridError) [metry] - oszacowanie, nie ograniczenie
+	uint64_t dataOffset;
+	uint64_t dataCount;     // liczba double w tablicy danych
+};
+
+//=======================================================================
+//  Siatka interpolacyjna odwzorowania 1992 lub 2000
+//=======================================================================
+//      Dane wzw s w tablicy storage (siatka zbudowana) albo w pamici odwzorowanej
+//      z pliku (MapInterpolationGrid). Struktury nie naley kopiowa.
+//=======================================================================
+struct InterpolationGrid
+{
+	GridHeader head;
+	ProjectionContext ctx;  // kontekst konwersji dokadnych (budowa siatki, punkty spoza siatki)
+	const double* data;
+	std::vector<double> storage;
+	const void* view;
+	size_t viewSize;
+
+	InterpolationGrid () : data (0), view (0), viewSize (0) { memset (&head, 0, sizeof (head)); }
+	~InterpolationGrid ();
+
+private:
+	InterpolationGrid (const InterpolationGrid&);
+	InterpolationGrid& operator= (const InterpolationGrid&);
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//Zwolnienie pamici odwzorowanej z pliku
+void UnmapGridView (const void* view, size_t size)
+{
+	if(!view) return;
+#ifdef _WIN32
+	(void)size;
+	UnmapViewOfFile (view);
+#else
+	munmap ((void*)view, size);
+#endif
+}
+
+InterpolationGrid::~InterpolationGrid ()
+{
+	UnmapGridView (view, viewSize);
+}
+
+//Wagi interpolacji szeciennej Catmull-Rom dla pooenia t w przedziale [0, 1) midzy wzami 1 i 2
+inline void CubicWeights (double t, double* w)
+{
+	double t2 = t * t;
+	double t3 = t2 * t;
+	w[0] = -0.5 * t3 + t2 - 0.5 * t;
+	w[1] = 1.5 * t3 - 2.5 * t2 + 1.0;
+	w[2] = -1.5 * t3 + 2.0 * t2 + 0.5 * t;
+	w[3] = 0.5 * t3 - 0.5 * t2;
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: interpolacja dwch wartoci w punkcie (x, y) siatki pasa
+//=======================================================================
+//       const GridStrip& s: siatka pasa
+//       const double* data: tablica danych wzw
+//       double x, double y: punkt z obszaru interpolacji [xMin, xMax] x [yMin, yMax]
+//       GridInterpolation interp: metoda interpolacji
+//       double& v0, double& v1: wartoci w punkcie
+//=======================================================================
+inline void GridInterpolate (const GridStrip& s, const double* data, double x, double y, GridInterpolation interp, double& v0, double& v1)
+{
+	double u = (x - s.x0) * s.rstep;
+	double w = (y - s.y0) * s.rstep;
+	int i = (int)u;
+	int j = (int)w;
+	// Wze zapasu po kadej stronie obszaru: 1 <= i <= nx - 3, 1 <= j <= ny - 3
+	if(i < 1) i = 1;
+	if(i > (int)s.nx - 3) i = (int)s.nx - 3;
+	if(j < 1) j = 1;
+	if(j > (int)s.ny - 3) j = (int)s.ny - 3;
+	double fu = u - i;
+	double fw = w - j;
+	size_t row = 2 * (size_t)s.nx;
+	if(interp == gridBilinear)
+	  {
+	   const double* p = data + s.offset + j * row + 2 * (size_t)i;
+	   const double* q = p + row;
+	   double a0 = p[0] + fu * (p[2] - p[0]);
+	   double a1 = p[1] + fu * (p[3] - p[1]);
+	   double b0 = q[0] + fu * (q[2] - q[0]);
+	   double b1 = q[1] + fu * (q[3] - q[1]);
+	   v0 = a0 + fw * (b0 - a0);
+	   v1 = a1 + fw * (b1 - a1);
+	   return;
+	  }
+	double wu[4], ww[4];
+	CubicWeights (fu, wu);
+	CubicWeights (fw, ww);
+	const double* p = data + s.offset + (j - 1) * row + 2 * (size_t)(i - 1);
+	v0 = 0.0;
+	v1 = 0.0;
+	for(int r = 0; r < 4; r++)
+	  {
+	   double r0 = wu[0] * p[0] + wu[1] * p[2] + wu[2] * p[4] + wu[3] * p[6];
+	   double r1 = wu[0] * p[1] + wu[1] * p[3] + wu[2] * p[5] + wu[3] * p[7];
+	   v0 += ww[r] * r0;
+	   v1 += ww[r] * r1;
+	   p += row;
+	  }
+}
+
+//Pas siatki dla punktu lat/lon (dugo z zakresu 13.5 - 25.5) i dla wsprzdnej easting
+int GridStripFromLon (const InterpolationGrid& g, double lon)
+{
+	return g.head.proj == projPUWG2000 ? PUWGStripFromLon (lon) : 0;
+}
+
+int GridStripFromEasting (const InterpolationGrid& g, double easting)
+{
+	return g.head.proj == projPUWG2000 ? PUWGStripFromEasting (easting) : 0;
+}
+
+//Ukad wzw siatki pasa pokrywajcej [xMin, xMax] x [yMin, yMax] z jednym wzem zapasu
+void GridLayout (GridStrip& s, double xMin, double xMax, double yMin, double yMax, double step, uint64_t offset)
+{
+	s.xMin = xMin;
+	s.xMax = xMax;
+	s.yMin = yMin;
+	s.yMax = yMax;
+	s.step = step;
+	s.rstep = 1.0 / step;
+	s.x0 = xMin - step;
+	s.y0 = yMin - step;
+	s.nx = (uint32_t)ceil ((xMax - xMin) / step - 1e-9) + 3;
+	s.ny = (uint32_t)ceil ((yMax - yMin) / step - 1e-9) + 3;
+	s.offset = offset;
+}
+
+//Bd punktu na powierzchni ziemi [metry]: rnica lat/lon [stopnie] zamieniona na dugo uku (przyblienie sferyczne)
+double GridGroundError (double a, double lat, double dlat, double dlon)
+{
+	double dy = dlat * deg2rad * a;
+	double dx = dlon * deg2rad * a * cos (lat * deg2rad);
+	return sqrt (dx * dx + dy * dy);
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: pomiar najwikszego bdu interpolacji siatki
+//=======================================================================
+//      Bd jest liczony wzgldem konwersji dokadnej w 15 punktach kadego oczka: w punktach
+//      siatki 4 x 4 o wsprzdnych wzgldnych 0, 0.5 (ekstremum bdu interpolacji liniowej)
+//      i 0.5 -+ 0.2887 (ekstrema bdu interpolacji Catmull-Rom), bez naronika oczka (wza).
+//      Wynik jest oszacowaniem z prbki: bd w innym punkcie oczka moe by nieco wikszy.
+//=======================================================================
+void MeasureGridError (InterpolationGrid& g)
+{
+	const ProjectionContext& ctx = g.ctx;
+	for(int d = 0; d < 2; d++)
+	  {
+	   g.head.maxError[d][gridBilinear] = 0.0;
+	   g.head.maxError[d][gridBicubic] = 0.0;
+	  }
+	static const double t[4] = { 0.0, 0.5 - 0.28867513459481288, 0.5, 0.5 + 0.28867513459481288 };
+	for(uint32_t k = 0; k < g.head.strips; k++)
+	  {
+	   // Kierunek prosty: punkty lat/lon pasa
+	   const GridStrip& f = g.head.fwd[k];
+	   for(uint32_t j = 1; j + 2 < f.ny; j++)
+	     {
+	      for(uint32_t i = 1; i + 2 < f.nx; i++)
+	        {
+	         double x = f.x0 + i * f.step;
+	         double y = f.y0 + j * f.step;
+	         for(int p = 1; p < 16; p++)
+	           {
+	            double lon = x + t[p & 3] * f.step;
+	            double lat = y + t[p >> 2] * f.step;
+	            if(lon > f.xMax || lat > f.yMax) continue;
+	            double e, n;
+	            TMForward (ctx, lat * deg2rad, lon * deg2rad - ctx.olam[k], ctx.nfn, ctx.fe + ctx.strf[k], e, n);
+	            for(int m = 0; m < 2; m++)
+	              {
+	               double ge, gn;
+	               GridInterpolate (f, g.data, lon, lat, (GridInterpolation)m, ge, gn);
+	               double err = sqrt ((ge - e) * (ge - e) + (gn - n) * (gn - n));
+	               if(err > g.head.maxError[gridForward][m]) g.head.maxError[gridForward][m] = err;
+	              }
+	           }
+	        }
+	     }
+	   // Kierunek odwrotny: punkty X/Y pasa
+	   const GridStrip& v = g.head.inv[k];
+	   for(uint32_t j = 1; j + 2 < v.ny; j++)
+	     {
+	      for(uint32_t i = 1; i + 2 < v.nx; i++)
+	        {
+	         double x = v.x0 + i * v.step;
+	         double y = v.y0 + j * v.step;
+	         for(int p = 1; p < 16; p++)
+	           {
+	            double e = x + t[p & 3] * v.step;
+	            double n = y + t[p >> 2] * v.step;
+	            if(e > v.xMax || n > v.yMax) continue;
+	            double latRad, dlam;
+	            TMInverse (ctx, e - ctx.fe - ctx.strf[k], n - ctx.nfn, latRad, dlam);
+	            double lat = latRad * rad2deg;
+	            double lon = (ctx.olam[k] + dlam) * rad2deg;
+	            for(int m = 0; m < 2; m++)
+	              {
+	               double glat, glon;
+	               GridInterpolate (v, g.data, e, n, (GridInterpolation)m, glat, glon);
+	               double err = GridGroundError (ctx.a, lat, glat - lat, glon - lon);
+	               if(err > g.head.maxError[gridInverse][m]) g.head.maxError[gridInverse][m] = err;
+	              }
+	           }
+	        }
+	     }
+	  }
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja buduje siatk interpolacyjn odwzorowania 1992 lub 2000
+//=======================================================================
+//       InterpolationGrid& g: siatka (poprzednia zawarto jest zastpowana)
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000 (dowolna elipsoida i metoda oblicze)
+//       double step: odstp wzw [stopnie]; siatka odwrotna ma odstp step * deg2rad * a [metry]
+//       double latMin, double latMax: zakres szerokoci geograficznej [stopnie]
+//      Wynik: false dla kontekstu UTM lub bdnych argumentw.
+//      Oszacowanie najwikszych bdw interpolacji (MeasureGridError):
+//      g.head.maxError[gridForward / gridInverse][gridBilinear / gridBicubic] [metry]
+//=======================================================================
+bool BuildInterpolationGrid (InterpolationGrid& g, const ProjectionContext& ctx, double step, double latMin = gridLatMin, double latMax = gridLatMax)
+{
+	if(ctx.proj == projUTM || !(step > 0.0) || !(latMax > latMin)) return false;
+	UnmapGridView (g.view, g.viewSize);
+	g.view = 0;
+	g.viewSize = 0;
+	memset (&g.head, 0, sizeof (g.head));
+	memcpy (g.head.magic, gridMagic, sizeof (gridMagic));
+	g.head.version = gridVersion;
+	g.head.byteOrder = gridByteOrder;
+	g.head.proj = ctx.proj;
+	g.head.engine = ctx.engine;
+	g.head.precision = ctx.precision;
+	g.head.a = ctx.a;
+	g.head.f = ctx.f;
+	g.head.latMin = latMin;
+	g.head.latMax = latMax;
+	g.head.step = step;
+	g.head.strips = ctx.strips;
+	g.head.dataOffset = (sizeof (GridHeader) + 63) / 64 * 64;
+	g.ctx = ctx;
+	// Ukad siatek prostych: 1992 - jeden pas 13.5 - 25.5, 2000 - pasy co 3 stopnie od 13.5
+	uint64_t offset = 0;
+	for(uint32_t k = 0; k < g.head.strips; k++)
+	  {
+	   double lonMin = ctx.proj == projPUWG2000 ? 13.5 + 3.0 * k : 13.5;
+	   double lonMax = ctx.proj == projPUWG2000 ? lonMin + 3.0 : 25.5;
+	   GridLayout (g.head.fwd[k], lonMin, lonMax, latMin, latMax, step, offset);
+	   offset += 2 * (uint64_t)g.head.fwd[k].nx * g.head.fwd[k].ny;
+	  }
+	g.storage.assign ((size_t)offset, 0.0);
+	// Wzy siatek prostych i zakres X/Y obszaru pasa
+	double box[4][4];
+	for(uint32_t k = 0; k < g.head.strips; k++)
+	  {
+	   const GridStrip& s = g.head.fwd[k];
+	   box[k][0] = box[k][2] = 1e300;
+	   box[k][1] = box[k][3] = -1e300;
+	   for(uint32_t j = 0; j < s.ny; j++)
+	     {
+	      for(uint32_t i = 0; i < s.nx; i++)
+	        {
+	         double lon = s.x0 + i * s.step;
+	         double lat = s.y0 + j * s.step;
+	         double* p = &g.storage[(size_t)(s.offset + 2 * ((uint64_t)j * s.nx + i))];
+	         TMForward (ctx, lat * deg2rad, lon * deg2rad - ctx.olam[k], ctx.nfn, ctx.fe + ctx.strf[k], p[0], p[1]);
+	         if(i == 0 || j == 0 || i == s.nx - 1 || j == s.ny - 1) continue;
+	         if(p[0] < box[k][0]) box[k][0] = p[0];
+	         if(p[0] > box[k][1]) box[k][1] = p[0];
+	         if(p[1] < box[k][2]) box[k][2] = p[1];
+	         if(p[1] > box[k][3]) box[k][3] = p[1];
+	        }
+	     }
+	  }
+	// Siatki odwrotne obejmuj prostokt X/Y zawierajcy obszar pasa
+	double stepM = step * deg2rad * ctx.a;
+	for(uint32_t k = 0; k < g.head.strips; k++)
+	  {
+	   GridLayout (g.head.inv[k], box[k][0], box[k][1], box[k][2], box[k][3], stepM, offset);
+	   offset += 2 * (uint64_t)g.head.inv[k].nx * g.head.inv[k].ny;
+	  }
+	g.storage.resize ((size_t)offset);
+	for(uint32_t k = 0; k < g.head.strips; k++)
+	  {
+	   const GridStrip& s = g.head.inv[k];
+	   for(uint32_t j = 0; j < s.ny; j++)
+	     {
+	      for(uint32_t i = 0; i < s.nx; i++)
+	        {
+	         double e = s.x0 + i * s.step;
+	         double n = s.y0 + j * s.step;
+	         double* p = &g.storage[(size_t)(s.offset + 2 * ((uint64_t)j * s.nx + i))];
+	         double dlam;
+	         TMInverse (ctx, e - ctx.fe - ctx.strf[k], n - ctx.nfn, p[0], dlam);
+	         p[0] *= rad2deg;
+	         p[1] = (ctx.olam[k] + dlam) * rad2deg;
+	        }
+	     }
+	  }
+	g.head.dataCount = offset;
+	g.data = &g.storage[0];
+	MeasureGridError (g);
+	return true;
+}
+
+//=======================================================================
+//  Funkcja zapisuje siatk do pliku (nagwek i dane wzw, gotowe do odwzorowania w pamici)
+//=======================================================================
+//      Wynik: false w przypadku bdu zapisu lub pustej siatki.
+//=======================================================================
+bool SaveInterpolationGrid (const InterpolationGrid& g, const char* path)
+{
+	if(!g.data) return false;
+	FILE* file = fopen (path, "wb");
+	if(!file) return false;
+	char pad[64];
+	memset (pad, 0, sizeof (pad));
+	bool ok = fwrite (&g.head, sizeof (GridHeader), 1, file) == 1;
+	ok = ok && fwrite (pad, 1, (size_t)(g.head.dataOffset - sizeof (GridHeader)), file) == (size_t)(g.head.dataOffset - sizeof (GridHeader));
+	ok = ok && fwrite (g.data, sizeof (double), (size_t)g.head.dataCount, file) == (size_t)g.head.dataCount;
+	ok = fclose (file) == 0 && ok;
+	return ok;
+}
+
+//=======================================================================
+//  Funkcja odwzorowuje plik siatki w pamici (tylko do odczytu, bez kopiowania danych)
+//=======================================================================
+//      Wynik: false, jeli pliku nie mona otworzy, plik nie jest plikiem siatki, ma inn
+//      wersj formatu lub kolejno bajtw albo jest niepeny. Siatka g pozostaje wtedy bez zmian.
+//=======================================================================
+bool MapInterpolationGrid (InterpolationGrid& g, const char* path)
+{
+	const void* view = 0;
+	size_t size = 0;
+#ifdef _WIN32
+	HANDLE file = CreateFileA (path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if(file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER length;
+	if(GetFileSizeEx (file, &length) && length.QuadPart > 0)
+	  {
+	   HANDLE mapping = CreateFileMappingA (file, 0, PAGE_READONLY, 0, 0, 0);
+	   if(mapping)
+	     {
+	      view = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+	      size = (size_t)length.QuadPart;
+	      CloseHandle (mapping);
+	     }
+	  }
+	CloseHandle (file);
+#else
+	int file = open (path, O_RDONLY);
+	if(file < 0) return false;
+	struct stat st;
+	if(fstat (file, &st) == 0 && st.st_size > 0)
+	  {
+	   void* p = mmap (0, (size_t)st.st_size, PROT_READ, MAP_SHARED, file, 0);
+	   if(p != MAP_FAILED)
+	     {
+	      view = p;
+	      size = (size_t)st.st_size;
+	     }
+	  }
+	close (file);
+#endif
+	if(!view) return false;
+	const GridHeader* head = (const GridHeader*)view;
+	bool valid = size >= sizeof (GridHeader)
+	             && memcmp (head->magic, gridMagic, sizeof (gridMagic)) == 0
+	             && head->version == gridVersion
+	             && head->byteOrder == gridByteOrder
+	             && (head->proj == projPUWG1992 || head->proj == projPUWG2000)
+	             && (head->engine == engineClassic || head->engine == engineKruger)
+	             && head->precision >= precFull && head->precision <= precFloat
+	             && head->strips >= 1 && head->strips <= 4
+	             && head->dataOffset >= sizeof (GridHeader)
+	             && head->dataOffset % 64 == 0
+	             && head->dataCount <= (size - head->dataOffset) / sizeof (double);
+	for(uint32_t k = 0; valid && k < head->strips; k++)
+	  {
+	   valid = head->fwd[k].nx >= 4 && head->fwd[k].ny >= 4 && head->inv[k].nx >= 4 && head->inv[k].ny >= 4
+	           && head->fwd[k].offset + 2 * (uint64_t)head->fwd[k].nx * head->fwd[k].ny <= head->dataCount
+	           && head->inv[k].offset + 2 * (uint64_t)head->inv[k].nx * head->inv[k].ny <= head->dataCount;
+	  }
+	if(!valid)
+	  {
+	   UnmapGridView (view, size);
+	   return false;
+	  }
+	UnmapGridView (g.view, g.viewSize);
+	g.storage.clear ();
+	g.head = *head;
+	g.ctx = CreateProjectionContext (head->a, head->f, (ProjectionType)head->proj, (ProjectionEngine)head->engine, (ProjectionPrecision)head->precision);
+	g.view = view;
+	g.viewSize = size;
+	g.data = (const double*)((const char*)view + head->dataOffset);
+	return true;
+}
+
+//=======================================================================
+//  Przybliona konwersja lat/lon -> X/Y 1992 lub 2000 (odpowiednik LatLonToPUWG)
+//=======================================================================
+//       const InterpolationGrid& g: siatka zbudowana lub odwzorowana z pliku
+//       double& easting, double& northing: wsprzdne Y, X po konwersji [metry]
+//       double lat, double lon: wsprzdne lat/lon do konwersji [stopnie]
+//       GridInterpolation interp: metoda interpolacji (szacowany bd g.head.maxError[gridForward][interp])
+//      Dla dugoci spoza zakresu 13.5 - 25.5 wynik 999999999999999 (jak w LatLonToPUWG),
+//      dla szerokoci spoza zakresu siatki konwersja dokadna.
+//=======================================================================
+void LatLonToPUWGGrid (const InterpolationGrid& g, double& easting, double& northing, double lat, double lon, GridInterpolation interp = gridBilinear)
+{
+	UTM_STATS_CALL (statsLatLonToPUWGGrid, 1);
+	if(!(lon >= 13.5 && lon <= 25.5))
+	  {
+	   //Bdna warto dugoci geograficznej (zwracana warto 99999999999999)
+	   easting = 999999999999999;
+	   northing = 999999999999999;
+	   return;
+	  }
+	const GridStrip& s = g.head.fwd[GridStripFromLon (g, lon)];
+	if(!(lat >= s.yMin && lat <= s.yMax))
+	  {
+	   LatLonToPUWG (g.ctx, easting, northing, lat, lon);
+	   return;
+	  }
+	GridInterpolate (s, g.data, lon, lat, interp, easting, northing);
+}
+
+//=======================================================================
+//  Przybliona konwersja X/Y 1992 lub 2000 -> lat/lon (odpowiednik PUWGToLatLon)
+//=======================================================================
+//       const InterpolationGrid& g: siatka zbudowana lub odwzorowana z pliku
+//       double easting, double northing: wsprzdne Y, X do konwersji [metry]
+//       double& lat, double& lon: wsprzdne lat/lon po konwersji [stopnie]
+//       GridInterpolation interp: metoda interpolacji (szacowany bd g.head.maxError[gridInverse][interp])
+//      Dla punktw spoza obszaru siatki konwersja dokadna.
+//=======================================================================
+void PUWGToLatLonGrid (const InterpolationGrid& g, double easting, double northing, double& lat, double& lon, GridInterpolation interp = gridBilinear)
+{
+	UTM_STATS_CALL (statsPUWGToLatLonGrid, 1);
+	const GridStrip& s = g.head.inv[GridStripFromEasting (g, easting)];
+	if(!(easting >= s.xMin && easting <= s.xMax && northing >= s.yMin && northing <= s.yMax))
+	  {
+	   PUWGToLatLon (g.ctx, easting, northing, lat, lon);
+	   return;
+	  }
+	GridInterpolate (s, g.data, easting, northing, interp, lat, lon);
+}
+
+#endif
@@ -0,0 +1,402 @@
+/*
+Zapis i odczyt wsprzdnych w ukadzie MGRS (Military Grid Reference System) na podstawie UTM
+Strefa i pas szerokoci s wyznaczane przez LatLonToUtm (UtmZone, tablica cArray), litery kwadratu
+100 km wedug schematu MGRS dla WGS 84 (kolumny w zestawach po 8 liter, wiersze z przesuniciem
+o 5 liter w strefach parzystych), a odczyt wraca do lat/lon przez UtmToLatLon.
+
+Wynik jest zapisywany do bufora podanego przez wywoujcego (mgrsBufferSize znakw), bez
+przydziau pamici. Obszary polarne (UPS, szeroko poza zakresem -80 - 84) nie s obsugiwane;
+podobnie jak w LatLonToUtm nie s uwzgldniane wyjtki stref 32V i 31X - 37X.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Mgrs_H
+#define Unit_UTM_1992_2000_Mgrs_H
+
+#include <stddef.h>
+#include <math.h>
+#include "UTM_1992_2000_Batch.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Dokadno zapisu MGRS (liczba cyfr kadej wsprzdnej w kwadracie 100 km)
+enum MgrsPrecision { mgrs100km, mgrs10km, mgrs1km, mgrs100m, mgrs10m, mgrs1m };
+
+//Rozmiar bufora zapisu MGRS: strefa (2), pas (1), kwadrat 100 km (2), cyfry (do 10) i znak koca
+static const int mgrsBufferSize = 16;
+
+//Liczba punktw konwertowanych jednorazowo w funkcjach wsadowych (bufory porednie na stosie)
+static const size_t mgrsBlockSize = 256;
+
+//Litery MGRS (bez I i O); kolumny: zestawy A-H, J-R, S-Z, wiersze: pierwsze 20 liter A-V
+static const char mgrsLetters[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+
+//Dzielnik reszty wsprzdnej w kwadracie 100 km dla kadej dokadnoci
+static const long mgrsDivisor[6] = { 100000, 10000, 1000, 100, 10, 1 };
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//Indeks litery w tablicy mgrsLetters (wielko liter bez znaczenia) lub -1
+int MgrsLetterIndex (char c)
+{
+	if(c >= 'a' && c <= 'z') c = c - 'a' + 'A';
+	if(c < 'A' || c > 'Z' || c == 'I' || c == 'O') return -1;
+	int i = c - 'A';
+	if(c > 'I') i--;
+	if(c > 'O') i--;
+	return i;
+}
+
+//Indeks pasa szerokoci w tablicy cArray (wielko liter bez znaczenia) lub -1
+int MgrsBandIndex (char c)
+{
+	if(c >= 'a' && c <= 'z') c = c - 'a' + 'A';
+	for(int i = 0; i < 20; i++) if(cArray[i] == c) return i;
+	return -1;
+}
+
+//=======================================================================
+//  Dolne ograniczenie northing punktw pasa szerokoci
+//=======================================================================
+//      Litera wiersza okrela northing z dokadnoci do wielokrotnoci 2000 km; pas ma najwyej
+//      1400 km, wic northing punktu jest najmniejsz tak wartoci nie mniejsz od wyniku.
+//      Dugo uku poudnika jest przybliona wyrazem ap * sphi (bd do 16 km), a krzywizna
+//      rwnolenika na brzegu strefy (do 50 km na pkuli poudniowej) - staym zapasem 200 km.
+//=======================================================================
+double MgrsBandNorthing (const ProjectionContext& ctx, int band)
+{
+	double latRad = (-80.0 + 8.0 * band) * deg2rad;
+	return ctx.ok * ctx.ap * latRad + (latRad < 0.0 ? ctx.nfn : 0.0) - 200000.0;
+}
+
+//Znak zapisu pod adresem p ('\0' poza kocem end; end = 0 - zapis zakoczony znakiem 0)
+char MgrsChar (const char* p, const char* end)
+{
+	return (end == 0 || p < end) ? *p : '\0';
+}
+
+//Zapis liczby value jako digits cyfr (z zerami wiodcymi)
+char* MgrsWriteDigits (char* p, long value, int digits)
+{
+	for(int k = digits - 1; k >= 0; k--)
+	  {
+	   p[k] = (char)('0' + value % 10);
+	   value /= 10;
+	  }
+	return p + digits;
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: odczyt zapisu MGRS (bez wyznaczania wielokrotnoci 2000 km northing)
+//=======================================================================
+//       const char* mgrs: zapis MGRS, np. "33UXP0500069000" lub "33U XP 05000 69000"
+//       size_t maxLen: najwiksza liczba odczytywanych znakw (gdy zapis nie koczy si znakiem 0)
+//       int& utmXZone, int& band: strefa UTM i indeks pasa szerokoci w cArray
+//       double& easting: easting rodka kwadratu siatki [metry]
+//       double& northing: northing rodka kwadratu siatki modulo 2000 km [metry]
+//       int& digits: dokadno zapisu (MgrsPrecision)
+//      Wynik: false dla bdnego zapisu.
+//=======================================================================
+bool MgrsParse (const char* mgrs, size_t maxLen, int& utmXZone, int& band, double& easting, double& northing, int& digits)
+{
+	const char* end = maxLen == (size_t)-1 ? 0 : mgrs + maxLen;
+	const char* p = mgrs;
+	while(MgrsChar (p, end) == ' ') p++;
+	int zone = 0;
+	int zoneDigits = 0;
+	while(zoneDigits < 2 && MgrsChar (p, end) >= '0' && MgrsChar (p, end) <= '9')
+	  {
+	   zone = zone * 10 + (*p - '0');
+	   zoneDigits++;
+	   p++;
+	  }
+	if(zoneDigits == 0 || zone < 1 || zone > 60) return false;
+	band = MgrsBandIndex (MgrsChar (p, end));
+	if(band < 0) return false;
+	p++;
+	while(MgrsChar (p, end) == ' ') p++;
+	int col = MgrsLetterIndex (MgrsChar (p, end));
+	if(col < 0) return false;
+	p++;
+	int row = MgrsLetterIndex (MgrsChar (p, end));
+	if(row < 0 || row >= 20) return false;
+	p++;
+	// Kolumna musi nalee do zestawu liter strefy
+	col -= ((zone - 1) % 3) * 8;
+	if(col < 0 || col >= 8) return false;
+	// Cyfry: easting i northing po tyle samo cyfr, razem lub rozdzielone spacj
+	while(MgrsChar (p, end) == ' ') p++;
+	long long value[2] = { 0, 0 };
+	int count[2] = { 0, 0 };
+	int half = 0;
+	while(true)
+	  {
+	   char c = MgrsChar (p, end);
+	   if(c >= '0' && c <= '9')
+	     {
+	      if(count[half] == 10) return false;
+	      value[half] = value[half] * 10 + (c - '0');
+	      count[half]++;
+	      p++;
+	     }
+	   else if(c == ' ')
+	     {
+	      while(MgrsChar (p, end) == ' ') p++;
+	      if(MgrsChar (p, end) == '\0') break;
+	      if(half == 1 || count[0] == 0) return false;
+	      half = 1;
+	     }
+	   else if(c == '\0') break;
+	   else return false;
+	  }
+	if(half == 0)
+	  {
+	   // Cyfry bez odstpu: pierwsza poowa to easting, druga - northing
+	   if(count[0] % 2 != 0) return false;
+	   digits = count[0] / 2;
+	   long div = mgrsDivisor[5 - digits];
+	   value[1] = value[0] % div;
+	   value[0] /= div;
+	  }
+	  else
+	  {
+	   if(count[0] != count[1] || count[0] > 5) return false;
+	   digits = count[0];
+	  }
+	double scale = (double)mgrsDivisor[digits];
+	utmXZone = zone;
+	easting = (col + 1) * 100000.0 + value[0] * scale + 0.5 * scale;
+	row = (row + 20 - (zone % 2 == 0 ? 5 : 0)) % 20;
+	northing = row * 100000.0 + value[1] * scale + 0.5 * scale;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja zapisuje wsprzdne X/Y UTM w ukadzie MGRS
+//=======================================================================
+//       int utmXZone, char utmYZone: strefa UTM (jak w wyniku LatLonToUtm)
+//       double easting, double northing: wsprzdne Y, X UTM [metry]
+//       MgrsPrecision precision: dokadno zapisu (cyfry s obcinane, nie zaokrglane)
+//       char* mgrs: bufor wyniku (co najmniej mgrsBufferSize znakw), zakoczony znakiem 0
+//      Wynik: dugo zapisu; 0 (pusty zapis) dla strefy '*' lub wsprzdnych poza stref.
+//=======================================================================
+int UtmToMgrs (int utmXZone, char utmYZone, double easting, double northing, MgrsPrecision precision, char* mgrs)
+{
+	mgrs[0] = '\0';
+	int band = MgrsBandIndex (utmYZone);
+	if(band < 0 || utmXZone < 1 || utmXZone > 60 || precision < mgrs100km || precision > mgrs1m) return 0;
+	if(!(easting >= 100000.0 && easting < 900000.0 && northing >= 0.0 && northing < 10000000.0)) return 0;
+	long e = (long)easting;
+	long n = (long)northing;
+	int col = (int)(e / 100000) - 1;
+	int row = (int)((n / 100000 + (utmXZone % 2 == 0 ? 5 : 0)) % 20);
+	char* p = mgrs;
+	p = MgrsWriteDigits (p, utmXZone, 2);
+	*p++ = cArray[band];
+	*p++ = mgrsLetters[((utmXZone - 1) % 3) * 8 + col];
+	*p++ = mgrsLetters[row];
+	long div = mgrsDivisor[precision];
+	p = MgrsWriteDigits (p, (e % 100000) / div, precision);
+	p = MgrsWriteDigits (p, (n % 100000) / div, precision);
+	*p = '\0';
+	return (int)(p - mgrs);
+}
+
+//=======================================================================
+//  Funkcja zapisuje wsprzdne lat/lon w ukadzie MGRS (strefa i X/Y z LatLonToUtm)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       double lat, double lon: wsprzdne lat/lon [stopnie]
+//       MgrsPrecision precision: dokadno zapisu
+//       char* mgrs: bufor wyniku (co najmniej mgrsBufferSize znakw)
+//      Wynik: dugo zapisu; 0 dla szerokoci poza zakresem -80 - 84.
+//=======================================================================
+int LatLonToMgrs (const ProjectionContext& ctx, double lat, double lon, MgrsPrecision precision, char* mgrs)
+{
+	int utmXZone;
+	char utmYZone;
+	double easting, northing;
+	LatLonToUtm (ctx, utmXZone, utmYZone, easting, northing, lat, lon);
+	return UtmToMgrs (utmXZone, utmYZone, easting, northing, precision, mgrs);
+}
+
+//=======================================================================
+//  Funkcja odczytuje zapis MGRS jako wsprzdne X/Y UTM rodka kwadratu siatki
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM (northing granic pasw szerokoci)
+//       const char* mgrs: zapis MGRS zakoczony znakiem 0 (litery mae lub wielkie, dopuszczalne
+//                         spacje midzy stref, kwadratem 100 km i wsprzdnymi)
+//       int& utmXZone, char& utmYZone: strefa UTM
+//       double& easting, double& northing: wsprzdne Y, X UTM [metry]
+//       MgrsPrecision* precision: dokadno zapisu lub 0
+//      Wynik: false dla bdnego zapisu (wyniki bez zmian).
+//=======================================================================
+bool MgrsToUtm (const ProjectionContext& ctx, const char* mgrs, int& utmXZone, char& utmYZone, double& easting, double& northing, MgrsPrecision* precision = 0)
+{
+	int zone, band, digits;
+	double e, n;
+	if(!MgrsParse (mgrs, (size_t)-1, zone, band, e, n, digits))
+	  {
+	   UTM_STATS_DOMAIN (statsFormatError, 1);
+	   return false;
+	  }
+	double nMin = MgrsBandNorthing (ctx, band);
+	n += 2000000.0 * ceil ((nMin - n) / 2000000.0);
+	utmXZone = zone;
+	utmYZone = cArray[band];
+	easting = e;
+	northing = n;
+	if(precision) *precision = (MgrsPrecision)digits;
+	return true;
+}
+
+//=======================================================================
+//  Funkcja odczytuje zapis MGRS jako wsprzdne lat/lon rodka kwadratu siatki (przez UtmToLatLon)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       const char* mgrs: zapis MGRS (jak w MgrsToUtm)
+//       double& lat, double& lon: wsprzdne lat/lon [stopnie]
+//      Wynik: false dla bdnego zapisu (lat, lon = 999999999999999).
+//=======================================================================
+bool MgrsToLatLon (const ProjectionContext& ctx, const char* mgrs, double& lat, double& lon)
+{
+	int utmXZone;
+	char utmYZone;
+	double easting, northing;
+	if(!MgrsToUtm (ctx, mgrs, utmXZone, utmYZone, easting, northing))
+	  {
+	   lat = 999999999999999;
+	   lon = 999999999999999;
+	   return false;
+	  }
+	UtmToLatLon (ctx, utmXZone, utmYZone, easting, northing, lat, lon);
+	return true;
+}
+
+//=======================================================================
+//  Zapis wsadowy lat/lon -> MGRS (odpowiednik LatLonToMgrs dla count punktw)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       char* mgrs: bufor wynikw, count zapisw po mgrsBufferSize znakw (punkt i od mgrs + i * mgrsBufferSize)
+//       const double* lat, const double* lon: wsprzdne lat/lon [stopnie]
+//       size_t count: liczba punktw
+//       MgrsPrecision precision: dokadno zapisu
+//       unsigned char* status: status konwersji kadego punktu (ConversionStatus) lub 0
+//       BatchKernel kernel: wersja jdra obliczeniowego konwersji lat/lon -> X/Y UTM
+//=======================================================================
+void LatLonToMgrsBatch (const ProjectionContext& ctx, char* mgrs, const double* lat, const double* lon, size_t count, MgrsPrecision precision, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	int utmXZone[mgrsBlockSize];
+	char utmYZone[mgrsBlockSize];
+	double easting[mgrsBlockSize], northing[mgrsBlockSize];
+	for(size_t i0 = 0; i0 < count; i0 += mgrsBlockSize)
+	  {
+	   size_t n = count - i0 < mgrsBlockSize ? count - i0 : mgrsBlockSize;
+	   LatLonToUtmBatch (ctx, utmXZone, utmYZone, easting, northing, lat + i0, lon + i0, n, status ? status + i0 : 0, kernel);
+	   for(size_t i = 0; i < n; i++)
+	     {
+	      UtmToMgrs (utmXZone[i], utmYZone[i], easting[i], northing[i], precision, mgrs + (i0 + i) * mgrsBufferSize);
+	     }
+	  }
+}
+
+//=======================================================================
+//  Odczyt wsadowy MGRS -> lat/lon (odpowiednik MgrsToLatLon dla count punktw)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       const char* mgrs: count zapisw po mgrsBufferSize znakw (zakoczonych znakiem 0 lub
+//                         wypeniajcych cay bufor)
+//       double* lat, double* lon: wsprzdne lat/lon rodkw kwadratw siatki [stopnie]
+//       size_t count: liczba punktw
+//       unsigned char* status: statusOK lub statusFormatError (lat, lon = 999999999999999) kadego punktu, lub 0
+//       BatchKernel kernel: wersja jdra obliczeniowego konwersji X/Y UTM -> lat/lon
+//=======================================================================
+void MgrsToLatLonBatch (const ProjectionContext& ctx, const char* mgrs, double* lat, double* lon, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	int utmXZone[mgrsBlockSize];
+	char utmYZone[mgrsBlockSize];
+	double easting[mgrsBlockSize], northing[mgrsBlockSize];
+	bool valid[mgrsBlockSize];
+	for(size_t i0 = 0; i0 < count; i0 += mgrsBlockSize)
+	  {
+	   size_t n = count - i0 < mgrsBlockSize ? count - i0 : mgrsBlockSize;
+	   for(size_t i = 0; i < n; i++)
+	     {
+	      int zone, band, digits;
+	      double e, nr;
+	      valid[i] = MgrsParse (mgrs + (i0 + i) * mgrsBufferSize, mgrsBufferSize, zone, band, e, nr, digits);
+	      if(valid[i])
+	        {
+	         nr += 2000000.0 * ceil ((MgrsBandNorthing (ctx, band) - nr) / 2000000.0);
+	         utmXZone[i] = zone;
+	         utmYZone[i] = cArray[band];
+	        }
+	        else
+	        {
+	         UTM_STATS_DOMAIN (statsFormatError, 1);
+	         // Dowolny poprawny punkt, wynik jest zastpowany poniej
+	         utmXZone[i] = 31;
+	         utmYZone[i] = 'N';
+	         e = ctx.fe;
+	         nr = 0.0;
+	        }
+	      easting[i] = e;
+	      northing[i] = nr;
+	     }
+	   UtmToLatLonBatch (ctx, utmXZone, utmYZone, easting, northing, lat + i0, lon + i0, n, kernel);
+	   for(size_t i = 0; i < n; i++)
+	     {
+	      if(!valid[i])
+	        {
+	         lat[i0 + i] = 999999999999999;
+	         lon[i0 + i] = 999999999999999;
+	        }
+	      if(status) status[i0 + i] = valid[i] ? statusOK : statusFormatError;
+	     }
+	  }
+}
+
+//==============================================================================
+// Funkcja do zapisu wsprzdnych lat/lon WGS 84 w ukadzie MGRS
+//==============================================================================
+int LatLonToMgrsWGS84(double lat, double lon, MgrsPrecision precision, char* mgrs)
+   {
+   return LatLonToMgrs (WGS84Context (projUTM), lat, lon, precision, mgrs);
+   }
+
+//==============================================================================
+//  Funkcja do odczytu zapisu MGRS jako lat/lon elipsoidalne WGS 84
+//==============================================================================
+bool MgrsToLatLonWGS84(const char* mgrs, double& lat, double& lon)
+   {
+   return MgrsToLatLon (WGS84Context (projUTM), mgrs, lat, lon);
+   }
+
+//==============================================================================
+// Funkcja do wsadowego zapisu wsprzdnych lat/lon WGS 84 w ukadzie MGRS
+//==============================================================================
+void LatLonToMgrsWGS84Batch(char* mgrs, const double* lat, const double* lon, size_t count, MgrsPrecision precision, unsigned char* status = 0)
+   {
+   LatLonToMgrsBatch (WGS84Context (projUTM), mgrs, lat, lon, count, precision, status);
+   }
+
+//==============================================================================
+//  Funkcja do wsadowego odczytu zapisw MGRS jako lat/lon elipsoidalne WGS 84
+//==============================================================================
+void MgrsToLatLonWGS84Batch(const char* mgrs, double* lat, double* lon, size_t count, unsigned char* status = 0)
+   {
+   MgrsToLatLonBatch (WGS84Context (projUTM), mgrs, lat, lon, count, status);
+   }
+
+#endif
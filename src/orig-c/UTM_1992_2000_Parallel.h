@@ -0,0 +1,288 @@
+/*
+Wielowtkowe konwersje wsadowe UTM, 1992, 2000
+Tablice s dzielone na porcje (chunk) o rozmiarze dobranym do pamici podrcznej, a porcje
+wykonywane przez pul wtkw z podkradaniem pracy (work stealing).
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Parallel_H
+#define Unit_UTM_1992_2000_Parallel_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "UTM_1992_2000_Batch.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Domylny rozmiar porcji: 4096 punktw (4 tablice double = 128 KB, mieci si w L2)
+static const size_t defaultChunkSize = 4096;
+
+//=======================================================================
+//  Pula wtkw z podkradaniem pracy
+//=======================================================================
+//      Kady wtek ma wasny zakres numerw porcji [begin, end) zapisany w jednej
+//      zmiennej atomowej. Waciciel pobiera porcje od pocztku zakresu, a wtek bez
+//      pracy przejmuje (CAS) poow zakresu innego wtku od koca. Wtek wywoujcy
+//      Run rwnie wykonuje porcje, wic pula z jednym wtkiem nie tworzy wtkw.
+//      Pula wykonuje jedno zadanie naraz: wywoania Run z kilku wtkw s wykonywane kolejno
+//      (blokada runMutex), a wywoanie Run z wntrza fn tej samej puli wykonuje wszystkie porcje
+//      w biecym wtku, bez udziau puli (zamiast zakleszczenia).
+//=======================================================================
+class ConversionPool
+{
+public:
+	explicit ConversionPool (unsigned threads = 0);
+	~ConversionPool ();
+
+	//Liczba wtkw wykonujcych porcje (cznie z wtkiem wywoujcym Run)
+	unsigned Threads () const { return (unsigned)queues.size (); }
+
+	//Wykonuje fn (begin, end) dla wszystkich porcji [0, count) o rozmiarze chunkSize i czeka na zakoczenie
+	void Run (size_t count, size_t chunkSize, const std::function<void (size_t, size_t)>& fn);
+
+private:
+	struct Queue
+	{
+		// Zakres numerw porcji: begin w starszych 32 bitach, end w modszych
+		std::atomic<uint64_t> range;
+		char pad[64 - sizeof (std::atomic<uint64_t>)];
+	};
+
+	static uint64_t Pack (uint64_t begin, uint64_t end) { return (begin << 32) | end; }
+	static const ConversionPool*& Running ();
+	void Worker (unsigned id);
+	void Work (unsigned id);
+	void RunChunk (size_t chunk);
+
+	ConversionPool (const ConversionPool&);
+	ConversionPool& operator= (const ConversionPool&);
+
+	std::vector<Queue> queues;
+	std::vector<std::thread> workers;
+	std::mutex runMutex;    // jedno zadanie naraz
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable finished;
+	unsigned generation;
+	unsigned active;
+	bool stop;
+	// Biece zadanie
+	const std::function<void (size_t, size_t)>* job;
+	size_t jobCount;
+	size_t jobChunk;
+	std::atomic<size_t> remaining;
+};
+
+ConversionPool::ConversionPool (unsigned threads)
+	: queues (threads ? threads : (std::thread::hardware_concurrency () ? std::thread::hardware_concurrency () : 1)),
+	  generation (0), active (0), stop (false), job (0), jobCount (0), jobChunk (0), remaining (0)
+{
+	for(size_t i = 0; i < queues.size (); i++) queues[i].range.store (0);
+	for(unsigned i = 1; i < queues.size (); i++)
+	  {
+	   workers.push_back (std::thread (&ConversionPool::Worker, this, i));
+	  }
+}
+
+ConversionPool::~ConversionPool ()
+{
+	{
+	 std::lock_guard<std::mutex> lock (mutex);
+	 stop = true;
+	}
+	wake.notify_all ();
+	for(size_t i = 0; i < workers.size (); i++) workers[i].join ();
+}
+
+//Pula, ktrej porcj wykonuje biecy wtek (0 poza porcjami)
+const ConversionPool*& ConversionPool::Running ()
+{
+	static thread_local const ConversionPool* pool = 0;
+	return pool;
+}
+
+void ConversionPool::RunChunk (size_t chunk)
+{
+	size_t begin = chunk * jobChunk;
+	size_t end = begin + jobChunk < jobCount ? begin + jobChunk : jobCount;
+	const ConversionPool*& running = Running ();
+	const ConversionPool* outer = running;
+	running = this;
+	(*job) (begin, end);
+	running = outer;
+	if(remaining.fetch_sub (1) == 1)
+	  {
+	   std::lock_guard<std::mutex> lock (mutex);
+	   finished.notify_all ();
+	  }
+}
+
+void ConversionPool::Work (unsigned id)
+{
+	unsigned n = (unsigned)queues.size ();
+	std::atomic<uint64_t>& own = queues[id].range;
+	for(;;)
+	  {
+	   // Wasne porcje - od pocztku zakresu
+	   uint64_t r = own.load ();
+	   while((r >> 32) < (r & 0xFFFFFFFFu))
+	     {
+	      if(own.compare_exchange_weak (r, Pack ((r >> 32) + 1, r & 0xFFFFFFFFu)))
+	        {
+	         RunChunk ((size_t)(r >> 32));
+	         r = own.load ();
+	        }
+	     }
+	   // Podkradanie poowy zakresu innego wtku - od koca
+	   bool stolen = false;
+	   for(unsigned k = 1; k < n && !stolen; k++)
+	     {
+	      std::atomic<uint64_t>& victim = queues[(id + k) % n].range;
+	      uint64_t v = victim.load ();
+	      for(;;)
+	        {
+	         uint64_t b = v >> 32;
+	         uint64_t e = v & 0xFFFFFFFFu;
+	         if(b >= e) break;
+	         uint64_t half = (e - b) / 2 ? (e - b) / 2 : 1;
+	         if(victim.compare_exchange_weak (v, Pack (b, e - half)))
+	           {
+	            own.store (Pack (e - half, e));
+	            stolen = true;
+	            break;
+	           }
+	        }
+	     }
+	   if(!stolen) return;
+	  }
+}
+
+void ConversionPool::Worker (unsigned id)
+{
+	unsigned seen = 0;
+	for(;;)
+	  {
+	   {
+	    std::unique_lock<std::mutex> lock (mutex);
+	    while(!stop && generation == seen) wake.wait (lock);
+	    if(stop) return;
+	    seen = generation;
+	    active++;
+	   }
+	   Work (id);
+	   {
+	    std::lock_guard<std::mutex> lock (mutex);
+	    active--;
+	   }
+	   finished.notify_all ();
+	  }
+}
+
+void ConversionPool::Run (size_t count, size_t chunkSize, const std::function<void (size_t, size_t)>& fn)
+{
+	if(count == 0) return;
+	if(chunkSize == 0) chunkSize = defaultChunkSize;
+	size_t chunks = (count + chunkSize - 1) / chunkSize;
+	if(chunks > 0xFFFFFFFFu)
+	  {
+	   // Numery porcji musz zmieci si w 32 bitach
+	   chunkSize = (count + 0xFFFFFFFEu) / 0xFFFFFFFFu;
+	   chunks = (count + chunkSize - 1) / chunkSize;
+	  }
+	// Wywoanie z porcji tej samej puli - porcje wykonywane w biecym wtku
+	if(queues.size () == 1 || chunks == 1 || Running () == this)
+	  {
+	   for(size_t c = 0; c < chunks; c++)
+	     {
+	      size_t begin = c * chunkSize;
+	      fn (begin, begin + chunkSize < count ? begin + chunkSize : count);
+	     }
+	   return;
+	  }
+	size_t n = queues.size ();
+	std::lock_guard<std::mutex> serial (runMutex);
+	{
+	 std::unique_lock<std::mutex> lock (mutex);
+	 // Poprzednie zadanie mogo zosta ukoczone, zanim cz wtkw opucia Work
+	 while(active) finished.wait (lock);
+	 job = &fn;
+	 jobCount = count;
+	 jobChunk = chunkSize;
+	 remaining.store (chunks);
+	 for(size_t i = 0; i < n; i++)
+	   {
+	    queues[i].range.store (Pack (chunks * i / n, chunks * (i + 1) / n));
+	   }
+	 generation++;
+	}
+	wake.notify_all ();
+	Work (0);
+	std::unique_lock<std::mutex> lock (mutex);
+	while(remaining.load ()) finished.wait (lock);
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+//  Argumenty jak w odpowiednich funkcjach wsadowych (UTM_1992_2000_Batch.h), dodatkowo:
+//       ConversionPool& pool: pula wtkw
+//       size_t chunkSize: rozmiar porcji w punktach (0 - defaultChunkSize)
+//       BatchKernel kernel: jdro obliczeniowe porcji; dla kernelScalar (domylnie) wyniki s
+//                           bit w bit identyczne z funkcjami skalarnymi niezalenie od liczby wtkw,
+//                           jdra wektorowe daj wyniki powtarzalne, ale rne od skalarnych (< 1e-8 m)
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Wielowtkowa konwersja lat/lon -> X/Y UTM
+//=======================================================================
+void LatLonToUtmParallel (ConversionPool& pool, const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, size_t chunkSize = 0, BatchKernel kernel = kernelScalar)
+{
+	pool.Run (count, chunkSize, [&] (size_t b, size_t e)
+	  {
+	   LatLonToUtmBatch (ctx, utmXZone + b, utmYZone + b, easting + b, northing + b, lat + b, lon + b, e - b, status ? status + b : 0, kernel);
+	  });
+}
+
+//=======================================================================
+//  Wielowtkowa konwersja lat/lon -> X/Y 1992 lub 2000
+//=======================================================================
+void LatLonToPUWGParallel (ConversionPool& pool, const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, size_t chunkSize = 0, BatchKernel kernel = kernelScalar)
+{
+	pool.Run (count, chunkSize, [&] (size_t b, size_t e)
+	  {
+	   LatLonToPUWGBatch (ctx, easting + b, northing + b, lat + b, lon + b, e - b, status ? status + b : 0, kernel);
+	  });
+}
+
+//=======================================================================
+//  Wielowtkowa konwersja X/Y UTM -> lat/lon
+//=======================================================================
+void UtmToLatLonParallel (ConversionPool& pool, const ProjectionContext& ctx, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, size_t count, size_t chunkSize = 0, BatchKernel kernel = kernelScalar)
+{
+	pool.Run (count, chunkSize, [&] (size_t b, size_t e)
+	  {
+	   UtmToLatLonBatch (ctx, utmXZone + b, utmYZone + b, easting + b, northing + b, lat + b, lon + b, e - b, kernel);
+	  });
+}
+
+//=======================================================================
+//  Wielowtkowa konwersja X/Y 1992 lub 2000 -> lat/lon
+//=======================================================================
+void PUWGToLatLonParallel (ConversionPool& pool, const ProjectionContext& ctx, const double* easting, const double* northing, double* lat, double* lon, size_t count, size_t chunkSize = 0, BatchKernel kernel = kernelScalar)
+{
+	pool.Run (count, chunkSize, [&] (size_t b, size_t e)
+	  {
+	   PUWGToLatLonBatch (ctx, easting + b, northing + b, lat + b, lon + b, e - b, kernel);
+	  });
+}
+
+#endif
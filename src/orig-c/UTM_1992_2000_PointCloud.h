@@ -0,0 +1,357 @@
+/*
+Przeliczanie duych plikw chmur punktw (np. LiDAR) midzy WGS 84, UTM, 1992 i 2000 bez
+wczytywania caego pliku do pamici
+
+Plik wejciowy to nagwek (przepisywany bez zmian) i cig rekordw o staej dugoci, w ktrych
+wsprzdne x, y s liczbami double (little endian, kolejno bajtw procesora) pod staymi
+przesuniciami; pozostae pola rekordu (z, intensywno, klasyfikacja...) s przepisywane bez zmian.
+Domylny ukad rekordu to x, y, z (3 x double, 24 bajty).
+
+Przeliczenie jest potokiem trzech etapw dziaajcych jednoczenie na pointCloudBuffers buforach:
+  odczyt    - osobny wtek czyta kolejne porcje (chunk) pliku wejciowego
+  konwersja - wtek wywoujcy i pula wtkw (ConversionPool, wszystkie rdzenie) przeliczaj porcj
+              funkcjami wsadowymi (TransformCoordinatesBatch)
+  zapis     - osobny wtek zapisuje przeliczone porcje w kolejnoci odczytu
+Odczyt nastpnej porcji i zapis poprzedniej odbywaj si w czasie konwersji biecej, wic przy
+szybkim przeliczaniu dysk pracuje bez przerw. Pami: pointCloudBuffers x rozmiar porcji.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_PointCloud_H
+#define Unit_UTM_1992_2000_PointCloud_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "UTM_1992_2000_Geometry.h"
+#include "UTM_1992_2000_Parallel.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Liczba buforw potoku (odczyt, konwersja, zapis - po jednym dla kadego etapu)
+static const size_t pointCloudBuffers = 3;
+
+//Domylny rozmiar porcji pliku (zaokrglany w d do wielokrotnoci dugoci rekordu)
+static const size_t pointCloudChunkBytes = 8 << 20;
+
+//Wynik przeliczenia pliku chmury punktw
+//  pointCloudTrailingError - dugo danych po nagwku nie jest wielokrotnoci dugoci rekordu
+//  (niepeny rekord na kocu przepisany bez zmian, pozostae rekordy przeliczone)
+enum PointCloudResult { pointCloudOK, pointCloudOpenError, pointCloudReadError, pointCloudWriteError, pointCloudLayoutError, pointCloudTrailingError };
+
+//=======================================================================
+//  Ukad pliku: dugo nagwka, dugo rekordu i pooenie wsprzdnych x, y w rekordzie [bajty]
+//=======================================================================
+struct PointCloudLayout
+{
+	size_t headerSize;
+	size_t recordSize;
+	size_t xOffset;
+	size_t yOffset;
+};
+
+//Ukad x, y, z (double) bez nagwka
+static const PointCloudLayout pointCloudXYZ = { 0, 24, 0, 8 };
+
+//=======================================================================
+//  Podsumowanie przeliczenia (take stan poredni przekazywany do funkcji postpu)
+//=======================================================================
+//  Czasy oczekiwania pokazuj etap ograniczajcy przepustowo: convertWaitSeconds > 0
+//  - konwersja czeka na dane (ograniczeniem jest odczyt), readWaitSeconds > 0 - odczyt
+//  czeka na wolny bufor (ograniczeniem jest konwersja lub zapis).
+//=======================================================================
+struct PointCloudReport
+{
+	uint64_t points;              // liczba przeliczonych punktw
+	uint64_t outOfRange;          // punkty poza zakresem ukadu docelowego (wynik 999999999999999)
+	uint64_t trailingBytes;       // niepeny rekord na kocu pliku, przepisany bez zmian (pointCloudTrailingError)
+	double seconds;               // cakowity czas
+	double pointsPerSecond;       // rednia przepustowo
+	double readSeconds;           // czas odczytu (wtek odczytu)
+	double writeSeconds;          // czas zapisu (wtek zapisu)
+	double convertSeconds;        // czas konwersji
+	double convertWaitSeconds;    // oczekiwanie konwersji na odczytan porcj
+	double readWaitSeconds;       // oczekiwanie odczytu na wolny bufor
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+inline double PointCloudSeconds (std::chrono::steady_clock::time_point from)
+{
+	return std::chrono::duration<double> (std::chrono::steady_clock::now () - from).count ();
+}
+
+//=======================================================================
+//  Przeliczenie rekordw [0, count) bufora: x, y zbierane blokami i zapisywane z powrotem
+//=======================================================================
+//      Zwraca liczb punktw poza zakresem ukadu docelowego.
+//=======================================================================
+size_t TransformPointRecords (const CoordinateTransform& ct, const PointCloudLayout& layout, unsigned char* records, size_t count)
+{
+	double x[geometryBlockSize], y[geometryBlockSize];
+	unsigned char status[geometryBlockSize];
+	size_t outOfRange = 0;
+	for(size_t i = 0; i < count; i += geometryBlockSize)
+	  {
+	   size_t n = count - i < geometryBlockSize ? count - i : geometryBlockSize;
+	   unsigned char* r = records + i * layout.recordSize;
+	   // Rekordy nie musz by wyrwnane do 8 bajtw - memcpy
+	   for(size_t j = 0; j < n; j++, r += layout.recordSize)
+	     {
+	      memcpy (&x[j], r + layout.xOffset, sizeof (double));
+	      memcpy (&y[j], r + layout.yOffset, sizeof (double));
+	     }
+	   TransformCoordinatesBatch (ct, x, y, n, status);
+	   r = records + i * layout.recordSize;
+	   for(size_t j = 0; j < n; j++, r += layout.recordSize)
+	     {
+	      memcpy (r + layout.xOffset, &x[j], sizeof (double));
+	      memcpy (r + layout.yOffset, &y[j], sizeof (double));
+	      outOfRange += status[j] != statusOK;
+	     }
+	  }
+	return outOfRange;
+}
+
+//=======================================================================
+//  Stan potoku wspdzielony przez wtki odczytu, konwersji i zapisu
+//=======================================================================
+//  Porcja k zajmuje bufor k % pointCloudBuffers; bufor przechodzi kolejno stany
+//  wolny -> odczytany -> przeliczony -> wolny, wic kolejno porcji w pliku
+//  wynikowym jest taka sama jak w wejciowym.
+//=======================================================================
+struct PointCloudPipeline
+{
+	enum BufferState { bufferFree, bufferRead, bufferConverted };
+	struct Buffer
+	{
+		std::vector<unsigned char> data;
+		size_t bytes;
+		BufferState state;
+	};
+
+	Buffer buffers[pointCloudBuffers];
+	std::mutex mutex;
+	std::condition_variable changed;
+	size_t chunks;                // liczba porcji (znana po zakoczeniu odczytu)
+	bool readDone;
+	PointCloudResult error;
+	double readSeconds, writeSeconds, readWaitSeconds;
+
+	bool Failed () const { return error != pointCloudOK; }
+
+	void Fail (PointCloudResult e)
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		if(error == pointCloudOK) error = e;
+		changed.notify_all ();
+	}
+
+	void Reader (FILE* in, size_t chunkBytes)
+	{
+		for(size_t k = 0; ; k++)
+		  {
+		   Buffer& b = buffers[k % pointCloudBuffers];
+		   {
+		    std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now ();
+		    std::unique_lock<std::mutex> lock (mutex);
+		    while(b.state != bufferFree && !Failed ()) changed.wait (lock);
+		    readWaitSeconds += PointCloudSeconds (t);
+		    if(Failed ()) return;
+		   }
+		   std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now ();
+		   size_t bytes = fread (&b.data[0], 1, chunkBytes, in);
+		   readSeconds += PointCloudSeconds (t);
+		   if(bytes < chunkBytes && ferror (in))
+		     {
+		      Fail (pointCloudReadError);
+		      return;
+		     }
+		   std::lock_guard<std::mutex> lock (mutex);
+		   if(bytes)
+		     {
+		      b.bytes = bytes;
+		      b.state = bufferRead;
+		     }
+		   // fread zwraca mniej ni chunkBytes tylko na kocu pliku
+		   if(bytes < chunkBytes)
+		     {
+		      chunks = bytes ? k + 1 : k;
+		      readDone = true;
+		     }
+		   changed.notify_all ();
+		   if(readDone) return;
+		  }
+	}
+
+	void Writer (FILE* out)
+	{
+		for(size_t k = 0; ; k++)
+		  {
+		   Buffer& b = buffers[k % pointCloudBuffers];
+		   {
+		    std::unique_lock<std::mutex> lock (mutex);
+		    while(b.state != bufferConverted && !(readDone && k >= chunks) && !Failed ()) changed.wait (lock);
+		    if(Failed () || b.state != bufferConverted) return;
+		   }
+		   std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now ();
+		   size_t bytes = fwrite (&b.data[0], 1, b.bytes, out);
+		   writeSeconds += PointCloudSeconds (t);
+		   if(bytes != b.bytes)
+		     {
+		      Fail (pointCloudWriteError);
+		      return;
+		     }
+		   std::lock_guard<std::mutex> lock (mutex);
+		   b.state = bufferFree;
+		   changed.notify_all ();
+		  }
+	}
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja przelicza wsprzdne x, y wszystkich rekordw strumienia wejciowego do wyjciowego
+//=======================================================================
+//       const CoordinateTransform& ct: przeksztacenie (CreateCoordinateTransform)
+//       FILE* in, FILE* out: pliki otwarte w trybie binarnym ("rb", "wb"), przed jakkolwiek operacj
+//                            odczytu lub zapisu (funkcja wycza ich buforowanie - setvbuf)
+//       const PointCloudLayout& layout: ukad pliku (np. pointCloudXYZ)
+//       ConversionPool& pool: pula wtkw etapu konwersji
+//       PointCloudReport* report: podsumowanie lub 0
+//       const std::function<void (const PointCloudReport&)>& progress: wywoywana po kadej porcji
+//                                 (w wtku wywoujcym) lub pusta
+//       size_t chunkBytes: rozmiar porcji (0 - pointCloudChunkBytes)
+//=======================================================================
+PointCloudResult ReprojectPointCloud (const CoordinateTransform& ct, FILE* in, FILE* out, const PointCloudLayout& layout, ConversionPool& pool, PointCloudReport* report = 0, const std::function<void (const PointCloudReport&)>& progress = std::function<void (const PointCloudReport&)> (), size_t chunkBytes = 0)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+	PointCloudReport r;
+	memset (&r, 0, sizeof (r));
+	if(report) *report = r;
+	if(layout.recordSize == 0 || layout.xOffset + sizeof (double) > layout.recordSize || layout.yOffset + sizeof (double) > layout.recordSize)
+	  {
+	   return pointCloudLayoutError;
+	  }
+	if(chunkBytes == 0) chunkBytes = pointCloudChunkBytes;
+	chunkBytes = chunkBytes < layout.recordSize ? layout.recordSize : chunkBytes - chunkBytes % layout.recordSize;
+
+	// Bez buforowania biblioteki C - porcje s kopiowane bezporednio do buforw potoku;
+	// setvbuf musi poprzedza pierwsz operacj na strumieniu, wic take odczyt nagwka
+	setvbuf (in, 0, _IONBF, 0);
+	setvbuf (out, 0, _IONBF, 0);
+
+	// Nagwek
+	if(layout.headerSize)
+	  {
+	   std::vector<unsigned char> header (layout.headerSize);
+	   if(fread (&header[0], 1, header.size (), in) != header.size ()) return pointCloudReadError;
+	   if(fwrite (&header[0], 1, header.size (), out) != header.size ()) return pointCloudWriteError;
+	  }
+
+	PointCloudPipeline p;
+	for(size_t i = 0; i < pointCloudBuffers; i++)
+	  {
+	   p.buffers[i].data.resize (chunkBytes);
+	   p.buffers[i].bytes = 0;
+	   p.buffers[i].state = PointCloudPipeline::bufferFree;
+	  }
+	p.chunks = 0;
+	p.readDone = false;
+	p.error = pointCloudOK;
+	p.readSeconds = p.writeSeconds = p.readWaitSeconds = 0;
+	std::thread reader (&PointCloudPipeline::Reader, &p, in, chunkBytes);
+	std::thread writer (&PointCloudPipeline::Writer, &p, out);
+
+	const size_t recordSize = layout.recordSize;
+	for(size_t k = 0; ; k++)
+	  {
+	   PointCloudPipeline::Buffer& b = p.buffers[k % pointCloudBuffers];
+	   {
+	    std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now ();
+	    std::unique_lock<std::mutex> lock (p.mutex);
+	    while(b.state != PointCloudPipeline::bufferRead && !(p.readDone && k >= p.chunks) && !p.Failed ()) p.changed.wait (lock);
+	    r.convertWaitSeconds += PointCloudSeconds (t);
+	    if(p.Failed () || b.state != PointCloudPipeline::bufferRead) break;
+	   }
+	   std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now ();
+	   size_t count = b.bytes / recordSize;
+	   std::atomic<size_t> outOfRange (0);
+	   unsigned char* records = &b.data[0];
+	   pool.Run (count, defaultChunkSize, [&] (size_t begin, size_t end)
+	     {
+	      size_t n = TransformPointRecords (ct, layout, records + begin * recordSize, end - begin);
+	      if(n) outOfRange.fetch_add (n);
+	     });
+	   r.convertSeconds += PointCloudSeconds (t);
+	   r.points += count;
+	   r.outOfRange += outOfRange.load ();
+	   r.trailingBytes += b.bytes % recordSize;
+	   {
+	    std::lock_guard<std::mutex> lock (p.mutex);
+	    b.state = PointCloudPipeline::bufferConverted;
+	    p.changed.notify_all ();
+	   }
+	   if(progress)
+	     {
+	      r.seconds = PointCloudSeconds (start);
+	      r.pointsPerSecond = r.seconds > 0 ? r.points / r.seconds : 0;
+	      progress (r);
+	     }
+	  }
+	reader.join ();
+	writer.join ();
+	if(!p.Failed () && fflush (out) != 0) p.error = pointCloudWriteError;
+	if(!p.Failed () && r.trailingBytes) p.error = pointCloudTrailingError;
+
+	r.seconds = PointCloudSeconds (start);
+	r.pointsPerSecond = r.seconds > 0 ? r.points / r.seconds : 0;
+	r.readSeconds = p.readSeconds;
+	r.writeSeconds = p.writeSeconds;
+	r.readWaitSeconds = p.readWaitSeconds;
+	if(report) *report = r;
+	return p.error;
+}
+
+//=======================================================================
+//  Funkcja przelicza plik chmury punktw inPath i zapisuje wynik do outPath
+//=======================================================================
+//      Argumenty jak w ReprojectPointCloud; pula wtkw tworzona dla wszystkich rdzeni.
+//=======================================================================
+PointCloudResult ReprojectPointCloudFile (const CoordinateTransform& ct, const char* inPath, const char* outPath, const PointCloudLayout& layout = pointCloudXYZ, PointCloudReport* report = 0, const std::function<void (const PointCloudReport&)>& progress = std::function<void (const PointCloudReport&)> (), size_t chunkBytes = 0)
+{
+	if(report) memset (report, 0, sizeof (*report));
+	FILE* in = fopen (inPath, "rb");
+	if(!in) return pointCloudOpenError;
+	FILE* out = fopen (outPath, "wb");
+	if(!out)
+	  {
+	   fclose (in);
+	   return pointCloudOpenError;
+	  }
+	ConversionPool pool;
+	PointCloudResult result = ReprojectPointCloud (ct, in, out, layout, pool, report, progress, chunkBytes);
+	fclose (in);
+	if(fclose (out) != 0 && result == pointCloudOK) result = pointCloudWriteError;
+	return result;
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+Wektorowe (AVX2, AVX-512) wersje konwersji wsadowych UTM, 1992, 2000
+Funkcje jder s kompilowane z atrybutem target, wic pozostaa cz programu nie wymaga
+dodatkowych opcji kompilatora; wybr wersji nastpuje w czasie dziaania (UTM_1992_2000_Batch.h).
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Simd_H
+#define Unit_UTM_1992_2000_Simd_H
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTM_1992_2000_SIMD 1
+
+#include <stddef.h>
+#include <immintrin.h>
+
+// Bez czenia mnoenia i dodawania w FMA przez kompilator (operacje intrinsics s zwykymi
+// operatorami wektorowymi): wynik punktu nie zaley od miejsca, w ktre funkcja bloku zostaa
+// wstawiona (ptla gwna, kocwka tablicy, konwersje z podziaem na strefy). FMA tylko jawnie, przez vfma.
+#pragma GCC push_options
+#pragma GCC optimize ("fp-contract=off")
+
+////////////////////////////////////////////////////////////////////////////////
+//AVX2 + FMA: 4 liczby double w wektorze
+////////////////////////////////////////////////////////////////////////////////
+namespace SimdAvx2
+{
+#define UTM_SIMD_TARGET __attribute__((target("avx2,fma")))
+
+typedef __m256d vd;
+typedef __m256d vm;
+static const int W = 4;
+
+UTM_SIMD_TARGET static inline vd vset (double x) { return _mm256_set1_pd (x); }
+UTM_SIMD_TARGET static inline vd vload (const double* p) { return _mm256_loadu_pd (p); }
+UTM_SIMD_TARGET static inline void vstore (double* p, vd x) { _mm256_storeu_pd (p, x); }
+UTM_SIMD_TARGET static inline vd vadd (vd x, vd y) { return _mm256_add_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vsub (vd x, vd y) { return _mm256_sub_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vmul (vd x, vd y) { return _mm256_mul_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vdiv (vd x, vd y) { return _mm256_div_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vfma (vd x, vd y, vd z) { return _mm256_fmadd_pd (x, y, z); }
+UTM_SIMD_TARGET static inline vd vsqrt (vd x) { return _mm256_sqrt_pd (x); }
+UTM_SIMD_TARGET static inline vd vmin (vd x, vd y) { return _mm256_min_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vround (vd x) { return _mm256_round_pd (x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vd vtrunc (vd x) { return _mm256_round_pd (x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vd vfloor (vd x) { return _mm256_round_pd (x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vm vlt (vd x, vd y) { return _mm256_cmp_pd (x, y, _CMP_LT_OQ); }
+UTM_SIMD_TARGET static inline vm vle (vd x, vd y) { return _mm256_cmp_pd (x, y, _CMP_LE_OQ); }
+UTM_SIMD_TARGET static inline vm vgt (vd x, vd y) { return _mm256_cmp_pd (x, y, _CMP_GT_OQ); }
+UTM_SIMD_TARGET static inline vm vge (vd x, vd y) { return _mm256_cmp_pd (x, y, _CMP_GE_OQ); }
+UTM_SIMD_TARGET static inline vm veq (vd x, vd y) { return _mm256_cmp_pd (x, y, _CMP_EQ_OQ); }
+UTM_SIMD_TARGET static inline vm vand (vm x, vm y) { return _mm256_and_pd (x, y); }
+UTM_SIMD_TARGET static inline vm vor (vm x, vm y) { return _mm256_or_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vsel (vm m, vd x, vd y) { return _mm256_blendv_pd (y, x, m); }
+UTM_SIMD_TARGET static inline int vmask (vm m) { return _mm256_movemask_pd (m); }
+
+// Poziom precFloat: 8 liczb float w wektorze (dwa wektory double)
+typedef __m256 vf;
+typedef __m256 vmf;
+
+UTM_SIMD_TARGET static inline vf vsetf (float x) { return _mm256_set1_ps (x); }
+UTM_SIMD_TARGET static inline vf vaddf (vf x, vf y) { return _mm256_add_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vsubf (vf x, vf y) { return _mm256_sub_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vmulf (vf x, vf y) { return _mm256_mul_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vdivf (vf x, vf y) { return _mm256_div_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vfmaf (vf x, vf y, vf z) { return _mm256_fmadd_ps (x, y, z); }
+UTM_SIMD_TARGET static inline vf vsqrtf (vf x) { return _mm256_sqrt_ps (x); }
+UTM_SIMD_TARGET static inline vf vroundf (vf x) { return _mm256_round_ps (x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vf vfloorf (vf x) { return _mm256_round_ps (x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vmf veqf (vf x, vf y) { return _mm256_cmp_ps (x, y, _CMP_EQ_OQ); }
+UTM_SIMD_TARGET static inline vmf vorf (vmf x, vmf y) { return _mm256_or_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vself (vmf m, vf x, vf y) { return _mm256_blendv_ps (y, x, m); }
+UTM_SIMD_TARGET static inline vf vtof (vd lo, vd hi) { return _mm256_set_m128 (_mm256_cvtpd_ps (hi), _mm256_cvtpd_ps (lo)); }
+UTM_SIMD_TARGET static inline void vfromf (vf x, vd& lo, vd& hi)
+{
+	lo = _mm256_cvtps_pd (_mm256_castps256_ps128 (x));
+	hi = _mm256_cvtps_pd (_mm256_extractf128_ps (x, 1));
+}
+
+#include "UTM_1992_2000_SimdKernel.h"
+
+#undef UTM_SIMD_TARGET
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//AVX-512F: 8 liczb double w wektorze, maski w rejestrach k
+////////////////////////////////////////////////////////////////////////////////
+namespace SimdAvx512
+{
+#define UTM_SIMD_TARGET __attribute__((target("avx512f")))
+
+typedef __m512d vd;
+typedef __mmask8 vm;
+static const int W = 8;
+
+// sqrt, min i roundscale w wersjach z mask (pen) - wersje bez maski korzystaj z _mm512_undefined_pd
+
+UTM_SIMD_TARGET static inline vd vset (double x) { return _mm512_set1_pd (x); }
+UTM_SIMD_TARGET static inline vd vload (const double* p) { return _mm512_loadu_pd (p); }
+UTM_SIMD_TARGET static inline void vstore (double* p, vd x) { _mm512_storeu_pd (p, x); }
+UTM_SIMD_TARGET static inline vd vadd (vd x, vd y) { return _mm512_add_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vsub (vd x, vd y) { return _mm512_sub_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vmul (vd x, vd y) { return _mm512_mul_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vdiv (vd x, vd y) { return _mm512_div_pd (x, y); }
+UTM_SIMD_TARGET static inline vd vfma (vd x, vd y, vd z) { return _mm512_fmadd_pd (x, y, z); }
+UTM_SIMD_TARGET static inline vd vsqrt (vd x) { return _mm512_mask_sqrt_pd (x, 0xFF, x); }
+UTM_SIMD_TARGET static inline vd vmin (vd x, vd y) { return _mm512_mask_min_pd (x, 0xFF, x, y); }
+UTM_SIMD_TARGET static inline vd vround (vd x) { return _mm512_mask_roundscale_pd (x, 0xFF, x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vd vtrunc (vd x) { return _mm512_mask_roundscale_pd (x, 0xFF, x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vd vfloor (vd x) { return _mm512_mask_roundscale_pd (x, 0xFF, x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vm vlt (vd x, vd y) { return _mm512_cmp_pd_mask (x, y, _CMP_LT_OQ); }
+UTM_SIMD_TARGET static inline vm vle (vd x, vd y) { return _mm512_cmp_pd_mask (x, y, _CMP_LE_OQ); }
+UTM_SIMD_TARGET static inline vm vgt (vd x, vd y) { return _mm512_cmp_pd_mask (x, y, _CMP_GT_OQ); }
+UTM_SIMD_TARGET static inline vm vge (vd x, vd y) { return _mm512_cmp_pd_mask (x, y, _CMP_GE_OQ); }
+UTM_SIMD_TARGET static inline vm veq (vd x, vd y) { return _mm512_cmp_pd_mask (x, y, _CMP_EQ_OQ); }
+UTM_SIMD_TARGET static inline vm vand (vm x, vm y) { return (vm)(x & y); }
+UTM_SIMD_TARGET static inline vm vor (vm x, vm y) { return (vm)(x | y); }
+UTM_SIMD_TARGET static inline vd vsel (vm m, vd x, vd y) { return _mm512_mask_blend_pd (m, y, x); }
+UTM_SIMD_TARGET static inline int vmask (vm m) { return (int)m; }
+
+// Poziom precFloat: 16 liczb float w wektorze (dwa wektory double)
+typedef __m512 vf;
+typedef __mmask16 vmf;
+
+UTM_SIMD_TARGET static inline vf vsetf (float x) { return _mm512_set1_ps (x); }
+UTM_SIMD_TARGET static inline vf vaddf (vf x, vf y) { return _mm512_add_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vsubf (vf x, vf y) { return _mm512_sub_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vmulf (vf x, vf y) { return _mm512_mul_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vdivf (vf x, vf y) { return _mm512_div_ps (x, y); }
+UTM_SIMD_TARGET static inline vf vfmaf (vf x, vf y, vf z) { return _mm512_fmadd_ps (x, y, z); }
+UTM_SIMD_TARGET static inline vf vsqrtf (vf x) { return _mm512_mask_sqrt_ps (x, 0xFFFF, x); }
+UTM_SIMD_TARGET static inline vf vroundf (vf x) { return _mm512_mask_roundscale_ps (x, 0xFFFF, x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vf vfloorf (vf x) { return _mm512_mask_roundscale_ps (x, 0xFFFF, x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+UTM_SIMD_TARGET static inline vmf veqf (vf x, vf y) { return _mm512_cmp_ps_mask (x, y, _CMP_EQ_OQ); }
+UTM_SIMD_TARGET static inline vmf vorf (vmf x, vmf y) { return (vmf)(x | y); }
+UTM_SIMD_TARGET static inline vf vself (vmf m, vf x, vf y) { return _mm512_mask_blend_ps (m, y, x); }
+UTM_SIMD_TARGET static inline vf vtof (vd lo, vd hi)
+{
+	__m512d r = _mm512_castpd256_pd512 (_mm256_castps_pd (_mm512_mask_cvtpd_ps (_mm256_setzero_ps (), 0xFF, lo)));
+	return _mm512_castpd_ps (_mm512_mask_insertf64x4 (r, 0xFF, r, _mm256_castps_pd (_mm512_mask_cvtpd_ps (_mm256_setzero_ps (), 0xFF, hi)), 1));
+}
+UTM_SIMD_TARGET static inline void vfromf (vf x, vd& lo, vd& hi)
+{
+	__m512d d = _mm512_castps_pd (x);
+	lo = _mm512_mask_cvtps_pd (_mm512_setzero_pd (), 0xFF, _mm256_castpd_ps (_mm512_mask_extractf64x4_pd (_mm256_setzero_pd (), 0xF, d, 0)));
+	hi = _mm512_mask_cvtps_pd (_mm512_setzero_pd (), 0xFF, _mm256_castpd_ps (_mm512_mask_extractf64x4_pd (_mm256_setzero_pd (), 0xF, d, 1)));
+}
+
+#include "UTM_1992_2000_SimdKernel.h"
+
+#undef UTM_SIMD_TARGET
+}
+
+#pragma GCC pop_options
+
+#endif
+
+#endif
@@ -0,0 +1,1282 @@
+/*
+Wektorowe jdra obliczeniowe konwersji wsadowych UTM, 1992, 2000
+
+Plik doczany wielokrotnie przez UTM_1992_2000_Simd.h - raz dla kadego zestawu instrukcji.
+Przed doczeniem musz by zdefiniowane (w biecej przestrzeni nazw):
+  vd, vm           - typ wektora liczb double i typ maski
+  W                - liczba elementw wektora
+  UTM_SIMD_TARGET  - atrybut zestawu instrukcji dla kadej funkcji
+  vset, vload, vstore, vadd, vsub, vmul, vdiv, vfma, vsqrt, vmin,
+  vround, vtrunc, vfloor, vlt, vle, vgt, vge, veq, vand, vor, vsel, vmask
+                   (vmin (x, y) jak minpd: y, gdy x lub y to NaN - ograniczenie vmin (granica, v)
+                   przepuszcza NaN, jak porwnanie v >= granica w funkcjach skalarnych)
+  vf, vmf          - typ wektora 2 W liczb float i typ jego maski (poziom precFloat)
+  vsetf, vaddf, vsubf, vmulf, vdivf, vfmaf, vsqrtf, vroundf, vfloorf, veqf, vorf, vself,
+  vtof, vfromf     - operacje float oraz zamiana dwch wektorw double na wektor float i z powrotem
+Nie naley docza go bezporednio.
+*/
+//---------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+
+//=======================================================================
+//  Jednoczesne wyznaczenie sin i cos (redukcja Cody-Waite'a do przedziau [-pi/4, pi/4] i wielomiany fdlibm)
+//=======================================================================
+UTM_SIMD_TARGET static inline void vsincos (vd x, vd& s, vd& c)
+{
+	vd j = vround (vmul (x, vset (6.36619772367581382433e-01)));
+	vd r = vfma (j, vset (-1.57079632673412561417e+00), x);
+	r = vfma (j, vset (-6.07710050630396597660e-11), r);
+	r = vfma (j, vset (-2.02226624879595063154e-21), r);
+	vd z = vmul (r, r);
+	vd ps = vfma (z, vset (1.58969099521155010221e-10), vset (-2.50507602534068634195e-08));
+	ps = vfma (z, ps, vset (2.75573137070700676789e-06));
+	ps = vfma (z, ps, vset (-1.98412698298579493134e-04));
+	ps = vfma (z, ps, vset (8.33333333332248946124e-03));
+	ps = vfma (z, ps, vset (-1.66666666666666324348e-01));
+	vd sr = vfma (vmul (r, z), ps, r);
+	vd pc = vfma (z, vset (-1.13596475577881948265e-11), vset (2.08757232129817482790e-09));
+	pc = vfma (z, pc, vset (-2.75573143513906633035e-07));
+	pc = vfma (z, pc, vset (2.48015872894767294178e-05));
+	pc = vfma (z, pc, vset (-1.38888888888741095749e-03));
+	pc = vfma (z, pc, vset (4.16666666666666019037e-02));
+	vd cr = vsub (vset (1.0), vsub (vmul (vset (0.5), z), vmul (vmul (z, z), pc)));
+	// wiartka q = j mod 4: 1 i 3 zamieniaj sin z cos, 2 i 3 zmieniaj znak sin, 1 i 2 zmieniaj znak cos
+	vd q = vsub (j, vmul (vset (4.0), vfloor (vmul (j, vset (0.25)))));
+	vm swap = vor (veq (q, vset (1.0)), veq (q, vset (3.0)));
+	vm negs = vor (veq (q, vset (2.0)), veq (q, vset (3.0)));
+	vm negc = vor (veq (q, vset (1.0)), veq (q, vset (2.0)));
+	vd ss = vsel (swap, cr, sr);
+	vd cc = vsel (swap, sr, cr);
+	s = vsel (negs, vsub (vset (0.0), ss), ss);
+	c = vsel (negc, vsub (vset (0.0), cc), cc);
+}
+
+//=======================================================================
+//  sin i cos w liczbach float (redukcja do przedziau [-pi/4, pi/4] i wielomiany Cephes), poziom precFloat
+//=======================================================================
+UTM_SIMD_TARGET static inline void vsincosf (vf x, vf& s, vf& c)
+{
+	vf j = vroundf (vmulf (x, vsetf (6.36619772e-01f)));
+	vf r = vfmaf (j, vsetf (-1.5703125f), x);
+	r = vfmaf (j, vsetf (-4.837512969970703125e-4f), r);
+	r = vfmaf (j, vsetf (-7.54978995489188216e-8f), r);
+	vf z = vmulf (r, r);
+	vf ps = vfmaf (z, vsetf (-1.9515295891e-4f), vsetf (8.3321608736e-3f));
+	ps = vfmaf (z, ps, vsetf (-1.6666654611e-1f));
+	vf sr = vfmaf (vmulf (r, z), ps, r);
+	vf pc = vfmaf (z, vsetf (2.443315711809948e-5f), vsetf (-1.388731625493765e-3f));
+	pc = vfmaf (z, pc, vsetf (4.166664568298827e-2f));
+	vf cr = vfmaf (vmulf (z, z), pc, vfmaf (vsetf (-0.5f), z, vsetf (1.0f)));
+	// wiartka jak w vsincos
+	vf q = vsubf (j, vmulf (vsetf (4.0f), vfloorf (vmulf (j, vsetf (0.25f)))));
+	vmf swap = vorf (veqf (q, vsetf (1.0f)), veqf (q, vsetf (3.0f)));
+	vmf negs = vorf (veqf (q, vsetf (2.0f)), veqf (q, vsetf (3.0f)));
+	vmf negc = vorf (veqf (q, vsetf (1.0f)), veqf (q, vsetf (2.0f)));
+	vf ss = vself (swap, cr, sr);
+	vf cc = vself (swap, sr, cr);
+	s = vself (negs, vsubf (vsetf (0.0f), ss), ss);
+	c = vself (negc, vsubf (vsetf (0.0f), cc), cc);
+}
+
+//Stae kontekstu odwzorowania wykorzystywane przez jdra (kopia lokalna, aby kompilator mg je trzyma w rejestrach)
+struct KernelConstants
+{
+	double a, eSquared, e2Squared;
+	double ap, bp, cp, dp, ep;
+	int kruger;
+	double arc[4], fpb[5], rap;
+	double ok, sr0, ra, rsr;
+	double okPow[9];
+	double fe, nfn;
+	int precision;
+	double truncFwd[3], truncInv[3];
+};
+
+UTM_SIMD_TARGET static inline void kconst (const ProjectionContext& ctx, KernelConstants& k)
+{
+	k.a = ctx.a;
+	k.eSquared = ctx.eSquared;
+	k.e2Squared = ctx.e2Squared;
+	k.ap = ctx.ap;
+	k.bp = ctx.bp;
+	k.cp = ctx.cp;
+	k.dp = ctx.dp;
+	k.ep = ctx.ep;
+	k.kruger = ctx.engine == engineKruger;
+	for(int i = 0; i < 4; i++) k.arc[i] = ctx.arc[i];
+	for(int i = 0; i < 5; i++) k.fpb[i] = ctx.fpb[i];
+	k.rap = 1.0 / ctx.ap;
+	k.ok = ctx.ok;
+	k.sr0 = ctx.sr0;
+	// 1 / a i 1 / (a (1 - e^2)): sn = a / dn, sr = a (1 - e^2) / dn^3
+	k.ra = 1.0 / ctx.a;
+	k.rsr = 1.0 / (ctx.a * (1.0 - ctx.eSquared));
+	for(int i = 0; i < 9; i++) k.okPow[i] = ctx.okPow[i];
+	k.fe = ctx.fe;
+	k.nfn = ctx.nfn;
+	k.precision = ctx.precision;
+	for(int i = 0; i < 3; i++)
+	  {
+	   k.truncFwd[i] = ctx.truncFwd[i];
+	   k.truncInv[i] = ctx.truncInv[i];
+	  }
+}
+
+//=======================================================================
+//  Dugo uku poudnika (sphtmd) z sin/cos szerokoci - wielokrotnoci kta z tosamoci trygonometrycznych
+//=======================================================================
+UTM_SIMD_TARGET static inline vd vsphtmd (const KernelConstants& k, vd phi, vd s, vd c)
+{
+	vd s2 = vmul (vset (2.0), vmul (s, c));
+	vd c2 = vmul (vsub (c, s), vadd (c, s));
+	vd s4 = vmul (vset (2.0), vmul (s2, c2));
+	vd c4 = vfma (vset (-2.0), vmul (s2, s2), vset (1.0));
+	vd s6 = vfma (s4, c2, vmul (c4, s2));
+	vd s8 = vmul (vset (2.0), vmul (s4, c4));
+	vd r = vmul (vset (k.ap), phi);
+	r = vfma (vset (-k.bp), s2, r);
+	r = vfma (vset (k.cp), s4, r);
+	r = vfma (vset (-k.dp), s6, r);
+	return vfma (vset (k.ep), s8, r);
+}
+
+//=======================================================================
+//  Suma szeregu sinusw wielokrotnoci 2x metod Clenshawa, odpowiednik ClenshawSin
+//=======================================================================
+UTM_SIMD_TARGET static inline vd vclenshaw (const double* cf, int n, vd s2, vd c2)
+{
+	vd x = vmul (vset (2.0), c2);
+	vd b1 = vset (cf[n - 1]);
+	vd b2 = vset (0.0);
+	for(int i = n - 2; i >= 0; i--)
+	  {
+	   vd b0 = vsub (vfma (x, b1, vset (cf[i])), b2);
+	   b2 = b1;
+	   b1 = b0;
+	  }
+	return vmul (b1, s2);
+}
+
+//Suma Clenshawa w liczbach float, odpowiednik ClenshawSinFloat
+UTM_SIMD_TARGET static inline vf vclenshawf (const double* cf, int n, vf s2, vf c2)
+{
+	vf x = vmulf (vsetf (2.0f), c2);
+	vf b1 = vsetf ((float)cf[n - 1]);
+	vf b2 = vsetf (0.0f);
+	for(int i = n - 2; i >= 0; i--)
+	  {
+	   vf b0 = vsubf (vfmaf (x, b1, vsetf ((float)cf[i])), b2);
+	   b2 = b1;
+	   b1 = b0;
+	  }
+	return vmulf (b1, s2);
+}
+
+//=======================================================================
+//  Szereg odwzorowania Gaussa-Krgera w liczbach float dla dwch wektorw punktw, odpowiednik TMForwardFloat
+//=======================================================================
+UTM_SIMD_TARGET static inline void vforwardf (const KernelConstants& k, const vd* latRad, const vd* dlam, const vd* nfn, const vd* efe, vd* easting, vd* northing)
+{
+	vf s, c;
+	vsincosf (vtof (latRad[0], latRad[1]), s, c);
+	vf t = vdivf (s, c);
+	vf tt = vmulf (t, t);
+	vf t4 = vmulf (tt, tt);
+	vf t6 = vmulf (t4, tt);
+	vf cc = vmulf (c, c);
+	vf eta = vmulf (vsetf ((float)k.e2Squared), cc);
+	vf eta2 = vmulf (eta, eta);
+	vf eta3 = vmulf (eta2, eta);
+	vf eta4 = vmulf (eta2, eta2);
+	vf snc = vdivf (vmulf (vsetf ((float)(k.a * k.ok)), c), vsqrtf (vfmaf (vsetf ((float)-k.eSquared), vmulf (s, s), vsetf (1.0f))));
+	vf snc3 = vmulf (snc, cc);
+	vf snc5 = vmulf (snc3, cc);
+	vf snc7 = vmulf (snc5, cc);
+	vf dl = vtof (dlam[0], dlam[1]);
+	vf l = vmulf (dl, dl);
+	vf p;
+	// Skadowa X (northing) bez ap * latRad
+	vf t2 = vmulf (vmulf (snc, s), vsetf (0.5f));
+	p = vfmaf (vsetf (4.0f), eta2, vfmaf (vsetf (9.0f), eta, vsubf (vsetf (5.0f), tt)));
+	vf t3 = vmulf (vmulf (snc3, s), vmulf (p, vsetf (1.0f / 24.0f)));
+	p = vaddf (vsubf (vsetf (61.0f), vmulf (vsetf (58.0f), tt)), t4);
+	p = vfmaf (vsetf (270.0f), eta, p);
+	p = vfmaf (vsetf (-330.0f), vmulf (tt, eta), p);
+	p = vfmaf (vsetf (445.0f), eta2, p);
+	p = vfmaf (vsetf (324.0f), eta3, p);
+	p = vfmaf (vsetf (-680.0f), vmulf (tt, eta2), p);
+	p = vfmaf (vsetf (88.0f), eta4, p);
+	p = vfmaf (vsetf (-600.0f), vmulf (tt, eta3), p);
+	p = vfmaf (vsetf (-192.0f), vmulf (tt, eta4), p);
+	vf t4s = vmulf (vmulf (snc5, s), vmulf (p, vsetf (1.0f / 720.0f)));
+	p = vsubf (vfmaf (vsetf (543.0f), t4, vfmaf (vsetf (-3111.0f), tt, vsetf (1385.0f))), t6);
+	vf t5 = vmulf (vmulf (snc7, s), vmulf (p, vsetf (1.0f / 40320.0f)));
+	vf sum = vfmaf (l, t5, t4s);
+	sum = vfmaf (l, sum, t3);
+	sum = vfmaf (l, sum, t2);
+	vf arc = vmulf (vsetf ((float)k.ok), vclenshawf (k.arc, 4, vmulf (vsetf (2.0f), vmulf (s, c)), vmulf (vsubf (c, s), vaddf (c, s))));
+	vd lo, hi;
+	vfromf (vfmaf (l, sum, arc), lo, hi);
+	northing[0] = vadd (vfma (vset (k.ok * k.ap), latRad[0], nfn[0]), lo);
+	northing[1] = vadd (vfma (vset (k.ok * k.ap), latRad[1], nfn[1]), hi);
+	// Skadowa Y (easting): iloczyn z dlam w double
+	p = vaddf (vsubf (vsetf (1.0f), tt), eta);
+	vf t7 = vmulf (snc3, vmulf (p, vsetf (1.0f / 6.0f)));
+	p = vaddf (vsubf (vsetf (5.0f), vmulf (vsetf (18.0f), tt)), t4);
+	p = vfmaf (vsetf (14.0f), eta, p);
+	p = vfmaf (vsetf (-58.0f), vmulf (tt, eta), p);
+	p = vfmaf (vsetf (13.0f), eta2, p);
+	p = vfmaf (vsetf (4.0f), eta3, p);
+	p = vfmaf (vsetf (-64.0f), vmulf (tt, eta2), p);
+	p = vfmaf (vsetf (-24.0f), vmulf (tt, eta3), p);
+	vf t8 = vmulf (snc5, vmulf (p, vsetf (1.0f / 120.0f)));
+	p = vsubf (vfmaf (vsetf (179.0f), t4, vfmaf (vsetf (-479.0f), tt, vsetf (61.0f))), t6);
+	vf t9 = vmulf (snc7, vmulf (p, vsetf (1.0f / 5040.0f)));
+	sum = vfmaf (l, t9, t8);
+	sum = vfmaf (l, sum, t7);
+	vfromf (vfmaf (l, sum, snc), lo, hi);
+	easting[0] = vfma (dlam[0], lo, efe[0]);
+	easting[1] = vfma (dlam[1], hi, efe[1]);
+}
+
+//=======================================================================
+//  Szereg odwrotny odwzorowania Gaussa-Krgera w liczbach float dla dwch wektorw punktw, odpowiednik TMInverseFloat
+//=======================================================================
+UTM_SIMD_TARGET static inline void vinversef (const KernelConstants& k, const vd* de, const vd* dn, vd* latRad, vd* dlam)
+{
+	vd mu[2], ftphi[2], lo, hi;
+	vf s, c;
+	for(int h = 0; h < 2; h++) mu[h] = vmul (vdiv (dn[h], vset (k.ok)), vset (k.rap));
+	vsincosf (vtof (vmul (vset (2.0), mu[0]), vmul (vset (2.0), mu[1])), s, c);
+	vfromf (vclenshawf (k.fpb, 5, s, c), lo, hi);
+	ftphi[0] = vadd (mu[0], lo);
+	ftphi[1] = vadd (mu[1], hi);
+	vsincosf (vtof (ftphi[0], ftphi[1]), s, c);
+	vf t = vdivf (s, c);
+	vf tt = vmulf (t, t);
+	vf t4 = vmulf (tt, tt);
+	vf t6 = vmulf (t4, tt);
+	vf eta = vmulf (vsetf ((float)k.e2Squared), vmulf (c, c));
+	vf eta2 = vmulf (eta, eta);
+	vf eta3 = vmulf (eta2, eta);
+	vf eta4 = vmulf (eta2, eta2);
+	vf dnm2 = vfmaf (vsetf ((float)-k.eSquared), vmulf (s, s), vsetf (1.0f));
+	vf rsnok = vmulf (vsqrtf (dnm2), vsetf ((float)(1.0 / (k.a * k.ok))));   // 1 / (sn ok)
+	vf x = vmulf (vtof (de[0], de[1]), rsnok);                                // de / (sn ok)
+	vf xx = vmulf (x, x);
+	vf snr = vmulf (dnm2, vsetf ((float)(1.0 / (1.0 - k.eSquared))));        // sn / sr
+	vf p;
+	// Szeroko geograficzna: ftphi - t (sn / sr) x^2 (1/2 - x^2 (P11 / 24 - x^2 (P12 / 720 - x^2 P13 / 40320)))
+	vf p13 = vfmaf (vsetf (1575.0f), t6, vfmaf (vsetf (4095.0f), t4, vfmaf (vsetf (3633.0f), tt, vsetf (1385.0f))));
+	p = vfmaf (vsetf (90.0f), tt, vsetf (61.0f));
+	p = vfmaf (vsetf (46.0f), eta, p);
+	p = vfmaf (vsetf (45.0f), t4, p);
+	p = vfmaf (vsetf (-252.0f), vmulf (tt, eta), p);
+	p = vfmaf (vsetf (-3.0f), eta2, p);
+	p = vfmaf (vsetf (100.0f), eta3, p);
+	p = vfmaf (vsetf (-66.0f), vmulf (tt, eta2), p);
+	p = vfmaf (vsetf (-90.0f), vmulf (t4, eta), p);
+	p = vfmaf (vsetf (88.0f), eta4, p);
+	p = vfmaf (vsetf (225.0f), vmulf (t4, eta2), p);
+	p = vfmaf (vsetf (84.0f), vmulf (tt, eta3), p);
+	p = vfmaf (vsetf (-192.0f), vmulf (tt, eta4), p);
+	vf sum = vfmaf (vmulf (xx, vsetf (-1.0f / 40320.0f)), p13, vmulf (p, vsetf (1.0f / 720.0f)));
+	p = vfmaf (vsetf (-9.0f), vmulf (tt, eta), vfmaf (vsetf (-4.0f), eta2, vaddf (vfmaf (vsetf (3.0f), tt, vsetf (5.0f)), eta)));
+	sum = vfmaf (vsubf (vsetf (0.0f), xx), sum, vmulf (p, vsetf (1.0f / 24.0f)));
+	sum = vfmaf (vsubf (vsetf (0.0f), xx), sum, vsetf (0.5f));
+	vfromf (vmulf (vmulf (vmulf (t, snr), xx), sum), lo, hi);
+	latRad[0] = vsub (ftphi[0], lo);
+	latRad[1] = vsub (ftphi[1], hi);
+	// Rnica dugoci geograficznej: de / (sn ok c) (1 - x^2 (Q15 / 6 - x^2 (Q16 / 120 - x^2 Q17 / 5040))), iloczyn z de w double
+	vf q17 = vfmaf (vsetf (720.0f), t6, vfmaf (vsetf (1320.0f), t4, vfmaf (vsetf (662.0f), tt, vsetf (61.0f))));
+	p = vfmaf (vsetf (6.0f), eta, vsetf (5.0f));
+	p = vfmaf (vsetf (28.0f), tt, p);
+	p = vfmaf (vsetf (-3.0f), eta2, p);
+	p = vfmaf (vsetf (8.0f), vmulf (tt, eta), p);
+	p = vfmaf (vsetf (24.0f), t4, p);
+	p = vfmaf (vsetf (-4.0f), eta3, p);
+	p = vfmaf (vsetf (4.0f), vmulf (tt, eta2), p);
+	p = vfmaf (vsetf (24.0f), vmulf (tt, eta3), p);
+	sum = vfmaf (vmulf (xx, vsetf (-1.0f / 5040.0f)), q17, vmulf (p, vsetf (1.0f / 120.0f)));
+	p = vaddf (vfmaf (vsetf (2.0f), tt, vsetf (1.0f)), eta);
+	sum = vfmaf (vsubf (vsetf (0.0f), xx), sum, vmulf (p, vsetf (1.0f / 6.0f)));
+	sum = vfmaf (vsubf (vsetf (0.0f), xx), sum, vsetf (1.0f));
+	vfromf (vmulf (vdivf (rsnok, c), sum), lo, hi);
+	dlam[0] = vmul (de[0], lo);
+	dlam[1] = vmul (de[1], hi);
+}
+
+//Maski torw, dla ktrych |x| przekracza progi grup wyrazw szeregu (precTruncated); any[g] = 0, gdy grupa jest pomijana w caym bloku
+UTM_SIMD_TARGET static inline void vgroups (vd x, const double* limit, vm* use, int* any)
+{
+	vd ax = vsel (vlt (x, vset (0.0)), vsub (vset (0.0), x), x);
+	for(int g = 0; g < 3; g++)
+	  {
+	   use[g] = vgt (ax, vset (limit[g]));
+	   any[g] = vmask (use[g]) != 0;
+	  }
+}
+
+//=======================================================================
+//  Zbieno poudnikw [radiany] i skala w punkcie z sin/cos szerokoci, odpowiednik GridFactors
+//=======================================================================
+UTM_SIMD_TARGET static inline void vgridfactors (const KernelConstants& k, vd s, vd c, vd dlam, vd& convergence, vd& scale)
+{
+	vd l = vmul (dlam, c);
+	vd l2 = vmul (l, l);
+	vd m = vmul (dlam, s);
+	vd m2 = vmul (m, m);
+	vd eta = vmul (vset (k.e2Squared), vmul (c, c));
+	vd eta2 = vmul (eta, eta);
+	vd eta3 = vmul (eta2, eta);
+	vd p = vfma (vset (2.0 / 3.0), eta2, vfma (vset (1.0), eta, vset (1.0 / 3.0)));
+	p = vadd (p, vmul (vfma (vset (2.0), l2, vsub (vset (0.0), m2)), vset (1.0 / 15.0)));
+	convergence = vmul (m, vfma (l2, p, vset (1.0)));
+	vd q = vfma (vset (4.0), eta3, vfma (vset (13.0), eta2, vfma (vset (14.0), eta, vset (5.0))));
+	vd r = vfma (vset (24.0), eta3, vfma (vset (48.0), eta2, vfma (vset (28.0), eta, vset (4.0))));
+	p = vmul (vsub (vmul (l2, q), vmul (m2, r)), vset (1.0 / 24.0));
+	p = vfma (vadd (vset (1.0), eta), vset (0.5), p);
+	q = vfma (vset (16.0), vmul (m2, m2), vmul (l2, vfma (vset (-148.0), m2, vmul (vset (61.0), l2))));
+	p = vfma (q, vset (1.0 / 720.0), p);
+	scale = vmul (vset (k.ok), vfma (l2, p, vset (1.0)));
+}
+
+//=======================================================================
+//  Zbieno i skala dla wyniku konwersji odwrotnej, odpowiednik GridFactorsInverse
+//  (s, c - sin i cos szerokoci punktu podnkowego ftphi)
+//=======================================================================
+UTM_SIMD_TARGET static inline void vgridfactorsInverse (const KernelConstants& k, vd ftphi, vd s, vd c, vd latRad, vd dlam, vd& convergence, vd& scale)
+{
+	vd d = vsub (ftphi, latRad);
+	vd dd = vmul (d, d);
+	vd sd = vmul (d, vfma (vmul (dd, vset (-1.0 / 6.0)), vfma (dd, vset (-1.0 / 20.0), vset (1.0)), vset (1.0)));
+	vd cd = vfma (vmul (dd, vset (-0.5)), vfma (vmul (dd, vset (-1.0 / 12.0)), vfma (dd, vset (-1.0 / 30.0), vset (1.0)), vset (1.0)), vset (1.0));
+	vgridfactors (k, vsub (vmul (s, cd), vmul (c, sd)), vadd (vmul (c, cd), vmul (s, sd)), dlam, convergence, scale);
+}
+
+//=======================================================================
+//  Szereg odwzorowania Gaussa-Krgera (lat/lon -> X/Y), odpowiednik TMForward
+//=======================================================================
+//  convergence, scale: zbieno poudnikw i skala w punkcie (vgridfactors) lub 0;
+//  dla precFloat liczone w double z dodatkowym sin/cos szerokoci.
+//=======================================================================
+UTM_SIMD_TARGET static inline void vforward (const KernelConstants& k, vd latRad, vd dlam, vd nfn, vd efe, vd& easting, vd& northing, vd* convergence = 0, vd* scale = 0)
+{
+	if(k.precision == precFloat)
+	  {
+	   // Pojedynczy blok: obie poowy wektora float liczone z tych samych punktw
+	   vd la[2] = { latRad, latRad }, dl[2] = { dlam, dlam }, nf[2] = { nfn, nfn }, ef[2] = { efe, efe };
+	   vd e[2], n[2];
+	   vforwardf (k, la, dl, nf, ef, e, n);
+	   easting = e[0];
+	   northing = n[0];
+	   if(convergence)
+	     {
+	      vd s, c;
+	      vsincos (latRad, s, c);
+	      vgridfactors (k, s, c, dlam, *convergence, *scale);
+	     }
+	   return;
+	  }
+	vd s, c;
+	vsincos (latRad, s, c);
+	vd t = vdiv (s, c);
+	vd tt = vmul (t, t);
+	vd t4 = vmul (tt, tt);
+	vd t6 = vmul (t4, tt);
+	vd eta = vmul (vset (k.e2Squared), vmul (c, c));
+	vd eta2 = vmul (eta, eta);
+	vd eta3 = vmul (eta2, eta);
+	vd eta4 = vmul (eta2, eta2);
+	vd sn = vdiv (vset (k.a), vsqrt (vfma (vset (-k.eSquared), vmul (s, s), vset (1.0))));
+	vd tmd;
+	if(k.kruger) tmd = vfma (vset (k.ap), latRad, vclenshaw (k.arc, 4, vmul (vset (2.0), vmul (s, c)), vmul (vsub (c, s), vadd (c, s))));
+	else tmd = vsphtmd (k, latRad, s, c);
+	vd cc = vmul (c, c);
+	vd snc = vmul (vmul (sn, c), vset (k.ok));           // sn c ok
+	vd snc3 = vmul (snc, cc);
+	vd snc5 = vmul (snc3, cc);
+	vd snc7 = vmul (snc5, cc);
+	vd p;
+	// precTruncated: grupy wyrazw (t3, t7), (t4, t8), (t5, t9) liczone tylko dla torw, w ktrych |dlam| przekracza prg
+	vd zero = vset (0.0);
+	vd t3 = zero, t4s = zero, t5 = zero, t7 = zero, t8 = zero, t9 = zero;
+	vm use[3];
+	int any[3] = { 1, 1, 1 };
+	bool trunc = k.precision == precTruncated;
+	if(trunc) vgroups (dlam, k.truncFwd, use, any);
+	if(any[0])
+	  {
+	   p = vfma (vset (4.0), eta2, vfma (vset (9.0), eta, vsub (vset (5.0), tt)));
+	   t3 = vmul (vmul (snc3, s), vmul (p, vset (1.0 / 24.0)));
+	   p = vadd (vsub (vset (1.0), tt), eta);
+	   t7 = vmul (snc3, vmul (p, vset (1.0 / 6.0)));
+	   if(trunc)
+	     {
+	      t3 = vsel (use[0], t3, zero);
+	      t7 = vsel (use[0], t7, zero);
+	     }
+	  }
+	if(any[1])
+	  {
+	   p = vadd (vsub (vset (61.0), vmul (vset (58.0), tt)), t4);
+	   p = vfma (vset (270.0), eta, p);
+	   p = vfma (vset (-330.0), vmul (tt, eta), p);
+	   p = vfma (vset (445.0), eta2, p);
+	   p = vfma (vset (324.0), eta3, p);
+	   p = vfma (vset (-680.0), vmul (tt, eta2), p);
+	   p = vfma (vset (88.0), eta4, p);
+	   p = vfma (vset (-600.0), vmul (tt, eta3), p);
+	   p = vfma (vset (-192.0), vmul (tt, eta4), p);
+	   t4s = vmul (vmul (snc5, s), vmul (p, vset (1.0 / 720.0)));
+	   p = vadd (vsub (vset (5.0), vmul (vset (18.0), tt)), t4);
+	   p = vfma (vset (14.0), eta, p);
+	   p = vfma (vset (-58.0), vmul (tt, eta), p);
+	   p = vfma (vset (13.0), eta2, p);
+	   p = vfma (vset (4.0), eta3, p);
+	   p = vfma (vset (-64.0), vmul (tt, eta2), p);
+	   p = vfma (vset (-24.0), vmul (tt, eta3), p);
+	   t8 = vmul (snc5, vmul (p, vset (1.0 / 120.0)));
+	   if(trunc)
+	     {
+	      t4s = vsel (use[1], t4s, zero);
+	      t8 = vsel (use[1], t8, zero);
+	     }
+	  }
+	if(any[2])
+	  {
+	   p = vsub (vfma (vset (543.0), t4, vfma (vset (-3111.0), tt, vset (1385.0))), t6);
+	   t5 = vmul (vmul (snc7, s), vmul (p, vset (1.0 / 40320.0)));
+	   p = vsub (vfma (vset (179.0), t4, vfma (vset (-479.0), tt, vset (61.0))), t6);
+	   t9 = vmul (snc7, vmul (p, vset (1.0 / 5040.0)));
+	   if(trunc)
+	     {
+	      t5 = vsel (use[2], t5, zero);
+	      t9 = vsel (use[2], t9, zero);
+	     }
+	  }
+	// Skadowa X (northing)
+	vd t1 = vmul (tmd, vset (k.ok));
+	vd t2 = vmul (vmul (snc, s), vset (1.0 / 2.0));
+	vd l = vmul (dlam, dlam);
+	vd sum = vfma (l, t5, t4s);
+	sum = vfma (l, sum, t3);
+	sum = vfma (l, sum, t2);
+	northing = vfma (l, sum, vadd (nfn, t1));
+	// Skadowa Y (easting)
+	sum = vfma (l, t9, t8);
+	sum = vfma (l, sum, t7);
+	sum = vfma (l, sum, snc);
+	easting = vfma (dlam, sum, efe);
+	if(convergence) vgridfactors (k, s, c, dlam, *convergence, *scale);
+}
+
+//=======================================================================
+//  Szereg odwrotny odwzorowania Gaussa-Krgera (X/Y -> lat/lon), odpowiednik TMInverse
+//=======================================================================
+UTM_SIMD_TARGET static inline void vinverse (const KernelConstants& k, vd de, vd dn, vd& latRad, vd& dlam, vd* convergence = 0, vd* scale = 0)
+{
+	if(k.precision == precFloat)
+	  {
+	   vd e[2] = { de, de }, n[2] = { dn, dn };
+	   vd la[2], dl[2];
+	   vinversef (k, e, n, la, dl);
+	   latRad = la[0];
+	   dlam = dl[0];
+	   if(convergence)
+	     {
+	      vd s, c;
+	      vsincos (latRad, s, c);
+	      vgridfactors (k, s, c, dlam, *convergence, *scale);
+	     }
+	   return;
+	  }
+	vd tmd = vdiv (dn, vset (k.ok));
+	vd ftphi = vdiv (tmd, vset (k.sr0));
+	vd s, c, dnm;
+	if(k.kruger)
+	  {
+	   // Szeroko punktu podnkowego z szeregu Krgera: mu = tmd / ap
+	   vd mu = vmul (tmd, vset (k.rap));
+	   vsincos (vmul (vset (2.0), mu), s, c);
+	   ftphi = vadd (mu, vclenshaw (k.fpb, 5, s, c));
+	  }
+	  else
+	  {
+	   for(int i = 0; i < 5; i++)
+	     {
+	      vsincos (ftphi, s, c);
+	      vd t10 = vsphtmd (k, ftphi, s, c);
+	      dnm = vsqrt (vfma (vset (-k.eSquared), vmul (s, s), vset (1.0)));
+	      // (tmd - t10) / sr = (tmd - t10) dn^3 / (a (1 - e^2))
+	      vd rsr = vmul (vmul (vmul (dnm, dnm), dnm), vset (k.rsr));
+	      ftphi = vfma (vsub (tmd, t10), rsr, ftphi);
+	     }
+	  }
+	vsincos (ftphi, s, c);
+	dnm = vsqrt (vfma (vset (-k.eSquared), vmul (s, s), vset (1.0)));
+	vd rc = vdiv (vset (1.0), c);
+	vd t = vmul (s, rc);
+	vd tt = vmul (t, t);
+	vd t4 = vmul (tt, tt);
+	vd t6 = vmul (t4, tt);
+	vd eta = vmul (vset (k.e2Squared), vmul (c, c));
+	vd eta2 = vmul (eta, eta);
+	vd eta3 = vmul (eta2, eta);
+	vd eta4 = vmul (eta2, eta2);
+	vd rsn = vmul (dnm, vset (k.ra));                                  // 1 / sn
+	vd rsr = vmul (vmul (vmul (dnm, dnm), dnm), vset (k.rsr));          // 1 / sr
+	vd rsnok = vmul (rsn, vset (1.0 / k.ok));                            // 1 / (sn ok)
+	vd rsnok2 = vmul (rsnok, rsnok);
+	vd p;
+	vd zero = vset (0.0);
+	vd t11 = zero, t12 = zero, t13 = zero, t15 = zero, t16 = zero, t17 = zero;
+	vm use[3];
+	int any[3] = { 1, 1, 1 };
+	bool trunc = k.precision == precTruncated;
+	// precTruncated: prg porwnywany z |de| / (sn ok c) - przyblieniem |dlam|
+	if(trunc) vgroups (vmul (vmul (de, rsnok), rc), k.truncInv, use, any);
+	// Wspczynniki kolejnych wyrazw: b = t / (sr sn^(2i-1) ok^(2i)) i b = 1 / (sn^(2i+1) c ok^(2i+1))
+	vd b = vmul (vmul (t, rsr), rsnok);                                  // t / (sr sn ok)
+	b = vmul (b, vset (1.0 / k.ok));                                     // t / (sr sn ok^2)
+	vd t10 = vmul (b, vset (1.0 / 2.0));
+	b = vmul (b, rsnok2);
+	if(any[0])
+	  {
+	   p = vfma (vset (-9.0), vmul (tt, eta), vfma (vset (-4.0), eta2, vadd (vfma (vset (3.0), tt, vset (5.0)), eta)));
+	   t11 = vmul (b, vmul (p, vset (1.0 / 24.0)));
+	  }
+	b = vmul (b, rsnok2);
+	if(any[1])
+	  {
+	   p = vfma (vset (90.0), tt, vset (61.0));
+	   p = vfma (vset (46.0), eta, p);
+	   p = vfma (vset (45.0), t4, p);
+	   p = vfma (vset (-252.0), vmul (tt, eta), p);
+	   p = vfma (vset (-3.0), eta2, p);
+	   p = vfma (vset (100.0), eta3, p);
+	   p = vfma (vset (-66.0), vmul (tt, eta2), p);
+	   p = vfma (vset (-90.0), vmul (t4, eta), p);
+	   p = vfma (vset (88.0), eta4, p);
+	   p = vfma (vset (225.0), vmul (t4, eta2), p);
+	   p = vfma (vset (84.0), vmul (tt, eta3), p);
+	   p = vfma (vset (-192.0), vmul (tt, eta4), p);
+	   t12 = vmul (b, vmul (p, vset (1.0 / 720.0)));
+	  }
+	b = vmul (b, rsnok2);
+	if(any[2])
+	  {
+	   p = vfma (vset (1575.0), t6, vfma (vset (4095.0), t4, vfma (vset (3633.0), tt, vset (1385.0))));
+	   t13 = vmul (b, vmul (p, vset (1.0 / 40320.0)));
+	  }
+	b = vmul (rsnok, rc);
+	vd t14 = b;
+	b = vmul (b, rsnok2);
+	if(any[0])
+	  {
+	   p = vadd (vfma (vset (2.0), tt, vset (1.0)), eta);
+	   t15 = vmul (b, vmul (p, vset (1.0 / 6.0)));
+	  }
+	b = vmul (b, rsnok2);
+	if(any[1])
+	  {
+	   p = vfma (vset (6.0), eta, vset (5.0));
+	   p = vfma (vset (28.0), tt, p);
+	   p = vfma (vset (-3.0), eta2, p);
+	   p = vfma (vset (8.0), vmul (tt, eta), p);
+	   p = vfma (vset (24.0), t4, p);
+	   p = vfma (vset (-4.0), eta3, p);
+	   p = vfma (vset (4.0), vmul (tt, eta2), p);
+	   p = vfma (vset (24.0), vmul (tt, eta3), p);
+	   t16 = vmul (b, vmul (p, vset (1.0 / 120.0)));
+	  }
+	b = vmul (b, rsnok2);
+	if(any[2])
+	  {
+	   p = vfma (vset (720.0), t6, vfma (vset (1320.0), t4, vfma (vset (662.0), tt, vset (61.0))));
+	   t17 = vmul (b, vmul (p, vset (1.0 / 5040.0)));
+	  }
+	if(trunc)
+	  {
+	   t11 = vsel (use[0], t11, zero);
+	   t15 = vsel (use[0], t15, zero);
+	   t12 = vsel (use[1], t12, zero);
+	   t16 = vsel (use[1], t16, zero);
+	   t13 = vsel (use[2], t13, zero);
+	   t17 = vsel (use[2], t17, zero);
+	  }
+	// Szeroko geograficzna
+	vd d = vmul (de, de);
+	vd sum = vfma (vsub (vset (0.0), d), t13, t12);
+	sum = vfma (vsub (vset (0.0), d), sum, t11);
+	sum = vfma (vsub (vset (0.0), d), sum, t10);
+	latRad = vfma (vsub (vset (0.0), d), sum, ftphi);
+	// Rnica dugoci geograficznej
+	sum = vfma (vsub (vset (0.0), d), t17, t16);
+	sum = vfma (vsub (vset (0.0), d), sum, t15);
+	sum = vfma (vsub (vset (0.0), d), sum, t14);
+	dlam = vmul (de, sum);
+	if(convergence) vgridfactorsInverse (k, ftphi, s, c, latRad, dlam, *convergence, *scale);
+}
+
+//Zapis statusw W punktw na podstawie bitw maski bdu
+UTM_SIMD_TARGET static inline void vstatus (unsigned char* status, int bad, unsigned char code)
+{
+	for(int i = 0; i < W; i++)
+	  {
+	   status[i] = (bad & (1 << i)) ? code : (unsigned char)statusOK;
+	  }
+}
+
+//Szeregi dla NB (1 lub 2) blokw W punktw; dla precFloat para blokw jest liczona jednym wektorem float
+template <int NB>
+UTM_SIMD_TARGET static inline void vforwardN (const KernelConstants& k, const vd* latRad, const vd* dlam, const vd* nfn, const vd* efe, vd* easting, vd* northing, vd* convergence = 0, vd* scale = 0)
+{
+	if(NB == 2 && k.precision == precFloat)
+	  {
+	   vforwardf (k, latRad, dlam, nfn, efe, easting, northing);
+	   for(int b = 0; convergence && b < NB; b++)
+	     {
+	      vd s, c;
+	      vsincos (latRad[b], s, c);
+	      vgridfactors (k, s, c, dlam[b], convergence[b], scale[b]);
+	     }
+	   return;
+	  }
+	for(int b = 0; b < NB; b++) vforward (k, latRad[b], dlam[b], nfn[b], efe[b], easting[b], northing[b], convergence ? convergence + b : 0, scale ? scale + b : 0);
+}
+
+template <int NB>
+UTM_SIMD_TARGET static inline void vinverseN (const KernelConstants& k, const vd* de, const vd* dn, vd* latRad, vd* dlam, vd* convergence = 0, vd* scale = 0)
+{
+	if(NB == 2 && k.precision == precFloat)
+	  {
+	   vinversef (k, de, dn, latRad, dlam);
+	   for(int b = 0; convergence && b < NB; b++)
+	     {
+	      vd s, c;
+	      vsincos (latRad[b], s, c);
+	      vgridfactors (k, s, c, dlam[b], convergence[b], scale[b]);
+	     }
+	   return;
+	  }
+	for(int b = 0; b < NB; b++) vinverse (k, de[b], dn[b], latRad[b], dlam[b], convergence ? convergence + b : 0, scale ? scale + b : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//Bloki NB x W punktw (NB = 2 tylko dla precFloat)
+////////////////////////////////////////////////////////////////////////////////
+
+template <int NB>
+UTM_SIMD_TARGET static inline void LatLonToUtmBlock (const KernelConstants& k, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, unsigned char* status, double* convergence = 0, double* scale = 0)
+{
+	vd latRad[NB], dlam[NB], nfn[NB], efe[NB], e[NB], n[NB], g[NB], sc[NB];
+	for(int b = 0; b < NB; b++)
+	  {
+	   vd vlat = vload (lat + b * W);
+	   vd vlon = vload (lon + b * W);
+	   // Nr strefy jako liczba rzeczywista: 30 + (int)(lon / 6) lub 31 + (int)(lon / 6)
+	   vd zone = vadd (vtrunc (vdiv (vlon, vset (6.0))), vsel (vle (vlon, vset (0.0)), vset (30.0), vset (31.0)));
+	   vd olam = vmul (vsub (vmul (zone, vset (6.0)), vset (183.0)), vset (deg2rad));
+	   latRad[b] = vmul (vlat, vset (deg2rad));
+	   dlam[b] = vsub (vmul (vlon, vset (deg2rad)), olam);
+	   nfn[b] = vsel (vlt (latRad[b], vset (0.0)), vset (k.nfn), vset (0.0));
+	   efe[b] = vset (k.fe);
+	  }
+	vforwardN<NB> (k, latRad, dlam, nfn, efe, e, n, convergence ? g : 0, sc);
+	for(int b = 0; b < NB; b++)
+	  {
+	   vd vlat = vload (lat + b * W);
+	   vstore (easting + b * W, e[b]);
+	   vstore (northing + b * W, vmin (vset (9999999.0), n[b]));
+	   if(convergence)
+	     {
+	      vstore (convergence + b * W, vmul (g[b], vset (rad2deg)));
+	      vstore (scale + b * W, sc[b]);
+	     }
+	   // Bdna warto szerokoci geograficznej (take NaN): poza przedziaem [-80, 84)
+	   int bad = vmask (vand (vge (vlat, vset (-80.0)), vlt (vlat, vset (84.0)))) ^ ((1 << W) - 1);
+	   for(int i = b * W; i < (b + 1) * W; i++)
+	     {
+	      double la = lat[i];
+	      double lo = lon[i];
+	      if(lo <= 0.0) utmXZone[i] = 30 + (int)(lo / 6.0); else utmXZone[i] = 31 + (int)(lo / 6.0);
+	      if(bad & (1 << (i - b * W))) utmYZone[i] = '*';
+	      else if(la >= 72.0) utmYZone[i] = cArray[19];
+	      else utmYZone[i] = cArray[(int)((la + 80.0) / 8.0)];
+	     }
+	   if(status) vstatus (status + b * W, bad, statusLatOutOfRange);
+	  }
+}
+
+template <int NB>
+UTM_SIMD_TARGET static inline void LatLonToPUWGBlock (const KernelConstants& k, const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, unsigned char* status, double* convergence = 0, double* scale = 0)
+{
+	vd latRad[NB], dlam[NB], nfn[NB], efe[NB], e[NB], n[NB], g[NB], sc[NB];
+	for(int b = 0; b < NB; b++)
+	  {
+	   vd vlon = vload (lon + b * W);
+	   vd olam = vset (ctx.olam[0]);
+	   efe[b] = vset (ctx.fe + ctx.strf[0]);
+	   if(ctx.proj == projPUWG2000)
+	     {
+	      // Wybr pasa bez rozgazie: 15, 18, 21, 24 stopnie
+	      vm m = vge (vlon, vset (16.5));
+	      olam = vsel (m, vset (ctx.olam[1]), olam);
+	      efe[b] = vsel (m, vset (ctx.fe + ctx.strf[1]), efe[b]);
+	      m = vge (vlon, vset (19.5));
+	      olam = vsel (m, vset (ctx.olam[2]), olam);
+	      efe[b] = vsel (m, vset (ctx.fe + ctx.strf[2]), efe[b]);
+	      m = vge (vlon, vset (22.5));
+	      olam = vsel (m, vset (ctx.olam[3]), olam);
+	      efe[b] = vsel (m, vset (ctx.fe + ctx.strf[3]), efe[b]);
+	     }
+	   latRad[b] = vmul (vload (lat + b * W), vset (deg2rad));
+	   dlam[b] = vsub (vmul (vlon, vset (deg2rad)), olam);
+	   nfn[b] = vset (ctx.nfn);
+	  }
+	vforwardN<NB> (k, latRad, dlam, nfn, efe, e, n, convergence ? g : 0, sc);
+	for(int b = 0; b < NB; b++)
+	  {
+	   vd vlon = vload (lon + b * W);
+	   vm valid = vand (vge (vlon, vset (13.5)), vle (vlon, vset (25.5)));
+	   // Bdna warto dugoci geograficznej (zwracana warto 99999999999999)
+	   vstore (easting + b * W, vsel (valid, e[b], vset (999999999999999.0)));
+	   vstore (northing + b * W, vsel (valid, n[b], vset (999999999999999.0)));
+	   if(convergence)
+	     {
+	      vstore (convergence + b * W, vsel (valid, vmul (g[b], vset (rad2deg)), vset (999999999999999.0)));
+	      vstore (scale + b * W, vsel (valid, sc[b], vset (999999999999999.0)));
+	     }
+	   if(status) vstatus (status + b * W, vmask (valid) ^ ((1 << W) - 1), statusLonOutOfRange);
+	  }
+}
+
+template <int NB>
+UTM_SIMD_TARGET static inline void UtmToLatLonBlock (const KernelConstants& k, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, double* convergence = 0, double* scale = 0)
+{
+	double nfnLane[NB * W];
+	double olamLane[NB * W];
+	for(int i = 0; i < NB * W; i++)
+	  {
+	   char z = utmYZone[i];
+	   nfnLane[i] = ((z <= 'M' && z >= 'C') || (z <= 'm' && z >= 'c')) ? k.nfn : 0.0;
+	   olamLane[i] = (utmXZone[i] * 6 - 183.0) * deg2rad;
+	  }
+	vd de[NB], dn[NB], latRad[NB], dlam[NB], g[NB], sc[NB];
+	for(int b = 0; b < NB; b++)
+	  {
+	   de[b] = vsub (vload (easting + b * W), vset (k.fe));
+	   dn[b] = vsub (vload (northing + b * W), vload (nfnLane + b * W));
+	  }
+	vinverseN<NB> (k, de, dn, latRad, dlam, convergence ? g : 0, sc);
+	for(int b = 0; b < NB; b++)
+	  {
+	   vstore (lat + b * W, vmul (latRad[b], vset (rad2deg)));
+	   vstore (lon + b * W, vmul (vadd (vload (olamLane + b * W), dlam[b]), vset (rad2deg)));
+	   if(convergence)
+	     {
+	      vstore (convergence + b * W, vmul (g[b], vset (rad2deg)));
+	      vstore (scale + b * W, sc[b]);
+	     }
+	  }
+}
+
+template <int NB>
+UTM_SIMD_TARGET static inline void PUWGToLatLonBlock (const KernelConstants& k, const ProjectionContext& ctx, const double* easting, const double* northing, double* lat, double* lon, double* convergence = 0, double* scale = 0)
+{
+	vd olam[NB], de[NB], dn[NB], latRad[NB], dlam[NB], g[NB], sc[NB];
+	for(int b = 0; b < NB; b++)
+	  {
+	   vd ve = vload (easting + b * W);
+	   vd strf = vset (ctx.strf[0]);
+	   olam[b] = vset (ctx.olam[0]);
+	   if(ctx.proj == projPUWG2000)
+	     {
+	      vm m = vge (ve, vset (6000000.0));
+	      olam[b] = vsel (m, vset (ctx.olam[1]), olam[b]);
+	      strf = vsel (m, vset (ctx.strf[1]), strf);
+	      m = vge (ve, vset (7000000.0));
+	      olam[b] = vsel (m, vset (ctx.olam[2]), olam[b]);
+	      strf = vsel (m, vset (ctx.strf[2]), strf);
+	      m = vge (ve, vset (8000000.0));
+	      olam[b] = vsel (m, vset (ctx.olam[3]), olam[b]);
+	      strf = vsel (m, vset (ctx.strf[3]), strf);
+	     }
+	   de[b] = vsub (vsub (ve, vset (ctx.fe)), strf);
+	   dn[b] = vsub (vload (northing + b * W), vset (ctx.nfn));
+	  }
+	vinverseN<NB> (k, de, dn, latRad, dlam, convergence ? g : 0, sc);
+	for(int b = 0; b < NB; b++)
+	  {
+	   vstore (lat + b * W, vmul (latRad[b], vset (rad2deg)));
+	   vstore (lon + b * W, vmul (vadd (olam[b], dlam[b]), vset (rad2deg)));
+	   if(convergence)
+	     {
+	      vstore (convergence + b * W, vmul (g[b], vset (rad2deg)));
+	      vstore (scale + b * W, sc[b]);
+	     }
+	  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//Jdra wsadowe
+////////////////////////////////////////////////////////////////////////////////
+//  Ostatnie (count mod W) punkty s kopiowane do bufora uzupenionego poprawnymi
+//  wartociami i liczone tym samym blokiem wektorowym, dziki czemu wynik dla punktu
+//  nie zaley od jego pooenia w tablicy. Zbieno poudnikw [stopnie] i skala w punkcie
+//  zapisywane s tylko, gdy convergence i scale s rne od 0.
+////////////////////////////////////////////////////////////////////////////////
+
+UTM_SIMD_TARGET void LatLonToUtmKernel (const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status, double* convergence = 0, double* scale = 0)
+{
+	KernelConstants k;
+	kconst (ctx, k);
+	size_t i = 0;
+	if(k.precision == precFloat)
+	  {
+	   for(; i + 2 * W <= count; i += 2 * W)
+	     {
+	      LatLonToUtmBlock<2> (k, utmXZone + i, utmYZone + i, easting + i, northing + i, lat + i, lon + i, status ? status + i : 0, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	     }
+	  }
+	for(; i + W <= count; i += W)
+	  {
+	   LatLonToUtmBlock<1> (k, utmXZone + i, utmYZone + i, easting + i, northing + i, lat + i, lon + i, status ? status + i : 0, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double la[W], lo[W], e[W], n[W], g[W], sc[W];
+	   int z[W];
+	   char y[W];
+	   unsigned char st[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      la[j] = j < (int)rest ? lat[i + j] : 0.0;
+	      lo[j] = j < (int)rest ? lon[i + j] : 3.0;
+	     }
+	   LatLonToUtmBlock<1> (k, z, y, e, n, la, lo, st, convergence ? g : 0, sc);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      utmXZone[i + j] = z[j];
+	      utmYZone[i + j] = y[j];
+	      easting[i + j] = e[j];
+	      northing[i + j] = n[j];
+	      if(status) status[i + j] = st[j];
+	      if(convergence)
+	        {
+	         convergence[i + j] = g[j];
+	         scale[i + j] = sc[j];
+	        }
+	     }
+	  }
+}
+
+UTM_SIMD_TARGET void LatLonToPUWGKernel (const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status, double* convergence = 0, double* scale = 0)
+{
+	KernelConstants k;
+	kconst (ctx, k);
+	size_t i = 0;
+	if(k.precision == precFloat)
+	  {
+	   for(; i + 2 * W <= count; i += 2 * W)
+	     {
+	      LatLonToPUWGBlock<2> (k, ctx, easting + i, northing + i, lat + i, lon + i, status ? status + i : 0, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	     }
+	  }
+	for(; i + W <= count; i += W)
+	  {
+	   LatLonToPUWGBlock<1> (k, ctx, easting + i, northing + i, lat + i, lon + i, status ? status + i : 0, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double la[W], lo[W], e[W], n[W], g[W], sc[W];
+	   unsigned char st[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      la[j] = j < (int)rest ? lat[i + j] : 52.0;
+	      lo[j] = j < (int)rest ? lon[i + j] : 19.0;
+	     }
+	   LatLonToPUWGBlock<1> (k, ctx, e, n, la, lo, st, convergence ? g : 0, sc);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      easting[i + j] = e[j];
+	      northing[i + j] = n[j];
+	      if(status) status[i + j] = st[j];
+	      if(convergence)
+	        {
+	         convergence[i + j] = g[j];
+	         scale[i + j] = sc[j];
+	        }
+	     }
+	  }
+}
+
+UTM_SIMD_TARGET void UtmToLatLonKernel (const ProjectionContext& ctx, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* lat, double* lon, size_t count, double* convergence = 0, double* scale = 0)
+{
+	KernelConstants k;
+	kconst (ctx, k);
+	size_t i = 0;
+	if(k.precision == precFloat)
+	  {
+	   for(; i + 2 * W <= count; i += 2 * W)
+	     {
+	      UtmToLatLonBlock<2> (k, utmXZone + i, utmYZone + i, easting + i, northing + i, lat + i, lon + i, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	     }
+	  }
+	for(; i + W <= count; i += W)
+	  {
+	   UtmToLatLonBlock<1> (k, utmXZone + i, utmYZone + i, easting + i, northing + i, lat + i, lon + i, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double e[W], n[W], la[W], lo[W], g[W], sc[W];
+	   int z[W];
+	   char y[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      bool in = j < (int)rest;
+	      z[j] = in ? utmXZone[i + j] : 31;
+	      y[j] = in ? utmYZone[i + j] : 'N';
+	      e[j] = in ? easting[i + j] : fe;
+	      n[j] = in ? northing[i + j] : 0.0;
+	     }
+	   UtmToLatLonBlock<1> (k, z, y, e, n, la, lo, convergence ? g : 0, sc);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      lat[i + j] = la[j];
+	      lon[i + j] = lo[j];
+	      if(convergence)
+	        {
+	         convergence[i + j] = g[j];
+	         scale[i + j] = sc[j];
+	        }
+	     }
+	  }
+}
+
+UTM_SIMD_TARGET void PUWGToLatLonKernel (const ProjectionContext& ctx, const double* easting, const double* northing, double* lat, double* lon, size_t count, double* convergence = 0, double* scale = 0)
+{
+	KernelConstants k;
+	kconst (ctx, k);
+	size_t i = 0;
+	if(k.precision == precFloat)
+	  {
+	   for(; i + 2 * W <= count; i += 2 * W)
+	     {
+	      PUWGToLatLonBlock<2> (k, ctx, easting + i, northing + i, lat + i, lon + i, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	     }
+	  }
+	for(; i + W <= count; i += W)
+	  {
+	   PUWGToLatLonBlock<1> (k, ctx, easting + i, northing + i, lat + i, lon + i, convergence ? convergence + i : 0, scale ? scale + i : 0);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double e[W], n[W], la[W], lo[W], g[W], sc[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      bool in = j < (int)rest;
+	      e[j] = in ? easting[i + j] : ctx.fe + ctx.strf[0];
+	      n[j] = in ? northing[i + j] : ctx.nfn;
+	     }
+	   PUWGToLatLonBlock<1> (k, ctx, e, n, la, lo, convergence ? g : 0, sc);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      lat[i + j] = la[j];
+	      lon[i + j] = lo[j];
+	      if(convergence)
+	        {
+	         convergence[i + j] = g[j];
+	         scale[i + j] = sc[j];
+	        }
+	     }
+	  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//Jdra dla punktw o wsplnym poudniku osiowym (konwersje z podziaem na strefy)
+////////////////////////////////////////////////////////////////////////////////
+//  Poudnik osiowy i faszywy wschd s stae dla caej tablicy; dla utm = true faszywa
+//  pnoc jest stosowana tylko na pkuli poudniowej, a northing ograniczany do 9999999.
+////////////////////////////////////////////////////////////////////////////////
+
+UTM_SIMD_TARGET static inline void ForwardUniformBlock (const KernelConstants& k, bool utm, vd olam, vd efe, const double* lat, const double* lon, double* easting, double* northing)
+{
+	vd latRad = vmul (vload (lat), vset (deg2rad));
+	vd dlam = vsub (vmul (vload (lon), vset (deg2rad)), olam);
+	vd nfn = utm ? vsel (vlt (latRad, vset (0.0)), vset (k.nfn), vset (0.0)) : vset (k.nfn);
+	vd e, n;
+	vforward (k, latRad, dlam, nfn, efe, e, n);
+	vstore (easting, e);
+	vstore (northing, utm ? vmin (vset (9999999.0), n) : n);
+}
+
+UTM_SIMD_TARGET void ForwardUniformKernel (const ProjectionContext& ctx, bool utm, double olam, double efe, const double* lat, const double* lon, double* easting, double* northing, size_t count)
+{
+	KernelConstants k;
+	kconst (ctx, k);
+	vd vo = vset (olam);
+	vd ve = vset (efe);
+	size_t i = 0;
+	for(; i + W <= count; i += W)
+	  {
+	   ForwardUniformBlock (k, utm, vo, ve, lat + i, lon + i, easting + i, northing + i);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double la[W], lo[W], e[W], n[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      la[j] = j < (int)rest ? lat[i + j] : lat[i];
+	      lo[j] = j < (int)rest ? lon[i + j] : lon[i];
+	     }
+	   ForwardUniformBlock (k, utm, vo, ve, la, lo, e, n);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      easting[i + j] = e[j];
+	      northing[i + j] = n[j];
+	     }
+	  }
+}
+
+UTM_SIMD_TARGET static inline void InverseUniformBlock (const KernelConstants& k, vd olam, vd fe, vd strf, vd nfn, const double* easting, const double* northing, double* lat, double* lon)
+{
+	vd latRad, dlam;
+	vinverse (k, vsub (vsub (vload (easting), fe), strf), vsub (vload (northing), nfn), latRad, dlam);
+	vstore (lat, vmul (latRad, vset (rad2deg)));
+	vstore (lon, vmul (vadd (olam, dlam), vset (rad2deg)));
+}
+
+UTM_SIMD_TARGET void InverseUniformKernel (const ProjectionContext& ctx, double olam, double strf, double nfn, const double* easting, const double* northing, double* lat, double* lon, size_t count)
+{
+	KernelConstants k;
+	kconst (ctx, k);
+	vd vo = vset (olam);
+	vd vfe = vset (ctx.fe);
+	vd vs = vset (strf);
+	vd vn = vset (nfn);
+	size_t i = 0;
+	for(; i + W <= count; i += W)
+	  {
+	   InverseUniformBlock (k, vo, vfe, vs, vn, easting + i, northing + i, lat + i, lon + i);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double e[W], n[W], la[W], lo[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      e[j] = j < (int)rest ? easting[i + j] : easting[i];
+	      n[j] = j < (int)rest ? northing[i + j] : northing[i];
+	     }
+	   InverseUniformBlock (k, vo, vfe, vs, vn, e, n, la, lo);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      lat[i + j] = la[j];
+	      lon[i + j] = lo[j];
+	     }
+	  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//Jdra przeksztace X/Y UTM <-> X/Y 1992 lub 2000 (UTM_1992_2000_Transform.h)
+////////////////////////////////////////////////////////////////////////////////
+//  Szeroko i dugo geograficzna pozostaj w rejestrach, w radianach; granice zakresu
+//  i pasw odwzorowania porwnywane s w radianach. ks - stae odwzorowania rdowego,
+//  kd - docelowego (ta sama elipsoida). Ptla gwna liczy etap odwrotny dwch blokw przed
+//  etapami prostymi, aby obliczenia niezalenych blokw mogy si nakada w procesorze.
+////////////////////////////////////////////////////////////////////////////////
+
+//Etap odwrotny: X/Y UTM -> szeroko i dugo geograficzna [radiany]
+UTM_SIMD_TARGET static inline void UtmInverseStage (const KernelConstants& ks, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, vd& latRad, vd& lonRad)
+{
+	double nfnLane[W];
+	double olamLane[W];
+	for(int i = 0; i < W; i++)
+	  {
+	   char z = utmYZone[i];
+	   nfnLane[i] = ((z <= 'M' && z >= 'C') || (z <= 'm' && z >= 'c')) ? ks.nfn : 0.0;
+	   olamLane[i] = (utmXZone[i] * 6 - 183.0) * deg2rad;
+	  }
+	vd dlam;
+	vinverse (ks, vsub (vload (easting), vset (ks.fe)), vsub (vload (northing), vload (nfnLane)), latRad, dlam);
+	lonRad = vadd (vload (olamLane), dlam);
+}
+
+//Etap prosty: szeroko i dugo geograficzna [radiany] -> X/Y 1992 lub 2000
+UTM_SIMD_TARGET static inline void PUWGForwardStage (const KernelConstants& kd, const ProjectionContext& dst, vd latRad, vd lonRad, double* dstEasting, double* dstNorthing, unsigned char* status)
+{
+	vd olam = vset (dst.olam[0]);
+	vd efe = vset (dst.fe + dst.strf[0]);
+	if(dst.proj == projPUWG2000)
+	  {
+	   vm m = vge (lonRad, vset (16.5 * deg2rad));
+	   olam = vsel (m, vset (dst.olam[1]), olam);
+	   efe = vsel (m, vset (dst.fe + dst.strf[1]), efe);
+	   m = vge (lonRad, vset (19.5 * deg2rad));
+	   olam = vsel (m, vset (dst.olam[2]), olam);
+	   efe = vsel (m, vset (dst.fe + dst.strf[2]), efe);
+	   m = vge (lonRad, vset (22.5 * deg2rad));
+	   olam = vsel (m, vset (dst.olam[3]), olam);
+	   efe = vsel (m, vset (dst.fe + dst.strf[3]), efe);
+	  }
+	vd e, n;
+	vforward (kd, latRad, vsub (lonRad, olam), vset (kd.nfn), efe, e, n);
+	vm valid = vand (vge (lonRad, vset (13.5 * deg2rad)), vle (lonRad, vset (25.5 * deg2rad)));
+	vstore (dstEasting, vsel (valid, e, vset (999999999999999.0)));
+	vstore (dstNorthing, vsel (valid, n, vset (999999999999999.0)));
+	if(status) vstatus (status, vmask (valid) ^ ((1 << W) - 1), statusLonOutOfRange);
+}
+
+//Etap odwrotny: X/Y 1992 lub 2000 -> szeroko i dugo geograficzna [radiany]
+UTM_SIMD_TARGET static inline void PUWGInverseStage (const KernelConstants& ks, const ProjectionContext& src, const double* easting, const double* northing, vd& latRad, vd& lonRad)
+{
+	vd ve = vload (easting);
+	vd olam = vset (src.olam[0]);
+	vd strf = vset (src.strf[0]);
+	if(src.proj == projPUWG2000)
+	  {
+	   vm m = vge (ve, vset (6000000.0));
+	   olam = vsel (m, vset (src.olam[1]), olam);
+	   strf = vsel (m, vset (src.strf[1]), strf);
+	   m = vge (ve, vset (7000000.0));
+	   olam = vsel (m, vset (src.olam[2]), olam);
+	   strf = vsel (m, vset (src.strf[2]), strf);
+	   m = vge (ve, vset (8000000.0));
+	   olam = vsel (m, vset (src.olam[3]), olam);
+	   strf = vsel (m, vset (src.strf[3]), strf);
+	  }
+	vd dlam;
+	vinverse (ks, vsub (vsub (ve, vset (src.fe)), strf), vsub (vload (northing), vset (src.nfn)), latRad, dlam);
+	lonRad = vadd (olam, dlam);
+}
+
+//Etap prosty: szeroko i dugo geograficzna [radiany] -> X/Y UTM
+UTM_SIMD_TARGET static inline void UtmForwardStage (const KernelConstants& kd, vd latRad, vd lonRad, int* utmXZone, char* utmYZone, double* dstEasting, double* dstNorthing, unsigned char* status)
+{
+	// Strefa UTM ze stopni (jak w UtmZone), szereg odwzorowania z radianw
+	vd lon = vmul (lonRad, vset (rad2deg));
+	vd lat = vmul (latRad, vset (rad2deg));
+	vd zone = vadd (vtrunc (vdiv (lon, vset (6.0))), vsel (vle (lon, vset (0.0)), vset (30.0), vset (31.0)));
+	vd zlam = vmul (vsub (vmul (zone, vset (6.0)), vset (183.0)), vset (deg2rad));
+	vd nfn = vsel (vlt (latRad, vset (0.0)), vset (kd.nfn), vset (0.0));
+	vd e, n;
+	vforward (kd, latRad, vsub (lonRad, zlam), nfn, vset (kd.fe), e, n);
+	vstore (dstEasting, e);
+	vstore (dstNorthing, vmin (vset (9999999.0), n));
+	int bad = vmask (vand (vge (lat, vset (-80.0)), vlt (lat, vset (84.0)))) ^ ((1 << W) - 1);
+	double la[W], lo[W];
+	vstore (la, lat);
+	vstore (lo, lon);
+	for(int i = 0; i < W; i++)
+	  {
+	   if(lo[i] <= 0.0) utmXZone[i] = 30 + (int)(lo[i] / 6.0); else utmXZone[i] = 31 + (int)(lo[i] / 6.0);
+	   if(bad & (1 << i)) utmYZone[i] = '*';
+	   else if(la[i] >= 72.0) utmYZone[i] = cArray[19];
+	   else utmYZone[i] = cArray[(int)((la[i] + 80.0) / 8.0)];
+	  }
+	if(status) vstatus (status, bad, statusLatOutOfRange);
+}
+
+UTM_SIMD_TARGET void UtmToPUWGKernel (const ProjectionContext& src, const ProjectionContext& dst, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* dstEasting, double* dstNorthing, size_t count, unsigned char* status)
+{
+	KernelConstants ks, kd;
+	kconst (src, ks);
+	kconst (dst, kd);
+	size_t i = 0;
+	for(; i + 2 * W <= count; i += 2 * W)
+	  {
+	   vd lat0, lon0, lat1, lon1;
+	   UtmInverseStage (ks, utmXZone + i, utmYZone + i, easting + i, northing + i, lat0, lon0);
+	   UtmInverseStage (ks, utmXZone + i + W, utmYZone + i + W, easting + i + W, northing + i + W, lat1, lon1);
+	   PUWGForwardStage (kd, dst, lat0, lon0, dstEasting + i, dstNorthing + i, status ? status + i : 0);
+	   PUWGForwardStage (kd, dst, lat1, lon1, dstEasting + i + W, dstNorthing + i + W, status ? status + i + W : 0);
+	  }
+	for(; i + W <= count; i += W)
+	  {
+	   vd latRad, lonRad;
+	   UtmInverseStage (ks, utmXZone + i, utmYZone + i, easting + i, northing + i, latRad, lonRad);
+	   PUWGForwardStage (kd, dst, latRad, lonRad, dstEasting + i, dstNorthing + i, status ? status + i : 0);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double e[W], n[W], de[W], dn[W];
+	   int z[W];
+	   char y[W];
+	   unsigned char st[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      size_t s = j < (int)rest ? i + j : i;
+	      z[j] = utmXZone[s];
+	      y[j] = utmYZone[s];
+	      e[j] = easting[s];
+	      n[j] = northing[s];
+	     }
+	   vd latRad, lonRad;
+	   UtmInverseStage (ks, z, y, e, n, latRad, lonRad);
+	   PUWGForwardStage (kd, dst, latRad, lonRad, de, dn, st);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      dstEasting[i + j] = de[j];
+	      dstNorthing[i + j] = dn[j];
+	      if(status) status[i + j] = st[j];
+	     }
+	  }
+}
+
+UTM_SIMD_TARGET void PUWGToUtmKernel (const ProjectionContext& src, const ProjectionContext& dst, const double* easting, const double* northing, int* utmXZone, char* utmYZone, double* dstEasting, double* dstNorthing, size_t count, unsigned char* status)
+{
+	KernelConstants ks, kd;
+	kconst (src, ks);
+	kconst (dst, kd);
+	size_t i = 0;
+	for(; i + 2 * W <= count; i += 2 * W)
+	  {
+	   vd lat0, lon0, lat1, lon1;
+	   PUWGInverseStage (ks, src, easting + i, northing + i, lat0, lon0);
+	   PUWGInverseStage (ks, src, easting + i + W, northing + i + W, lat1, lon1);
+	   UtmForwardStage (kd, lat0, lon0, utmXZone + i, utmYZone + i, dstEasting + i, dstNorthing + i, status ? status + i : 0);
+	   UtmForwardStage (kd, lat1, lon1, utmXZone + i + W, utmYZone + i + W, dstEasting + i + W, dstNorthing + i + W, status ? status + i + W : 0);
+	  }
+	for(; i + W <= count; i += W)
+	  {
+	   vd latRad, lonRad;
+	   PUWGInverseStage (ks, src, easting + i, northing + i, latRad, lonRad);
+	   UtmForwardStage (kd, latRad, lonRad, utmXZone + i, utmYZone + i, dstEasting + i, dstNorthing + i, status ? status + i : 0);
+	  }
+	if(i < count)
+	  {
+	   size_t rest = count - i;
+	   double e[W], n[W], de[W], dn[W];
+	   int z[W];
+	   char y[W];
+	   unsigned char st[W];
+	   for(int j = 0; j < W; j++)
+	     {
+	      size_t s = j < (int)rest ? i + j : i;
+	      e[j] = easting[s];
+	      n[j] = northing[s];
+	     }
+	   vd latRad, lonRad;
+	   PUWGInverseStage (ks, src, e, n, latRad, lonRad);
+	   UtmForwardStage (kd, latRad, lonRad, z, y, de, dn, st);
+	   for(size_t j = 0; j < rest; j++)
+	     {
+	      utmXZone[i + j] = z[j];
+	      utmYZone[i + j] = y[j];
+	      dstEasting[i + j] = de[j];
+	      dstNorthing[i + j] = dn[j];
+	      if(status) status[i + j] = st[j];
+	     }
+	  }
+}
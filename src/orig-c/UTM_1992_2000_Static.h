@@ -0,0 +1,242 @@
+/*
+Odwzorowania UTM, 1992, 2000 wyspecjalizowane w czasie kompilacji
+Elipsoida i odwzorowanie s parametrami szablonu, a wszystkie stae pochodne (wspczynniki szeregu
+dugoci uku poudnika, potgi wspczynnika skali, przesunicia pasw) s wyraeniami constexpr.
+Kompilator wylicza je podczas kompilacji i usuwa rozgazienia zalene od odwzorowania.
+Wyniki s identyczne z funkcjami korzystajcymi z kontekstu odwzorowania (ProjectionContext).
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Static_H
+#define Unit_UTM_1992_2000_Static_H
+
+#include "UTM_1992_2000.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Elipsoidy odniesienia
+////////////////////////////////////////////////////////////////////////////////
+
+struct EllipsoidWGS84
+{
+	static constexpr double a = 6378137.0;
+	static constexpr double f = 1 / 298.257223563;
+};
+
+struct EllipsoidGRS80
+{
+	static constexpr double a = 6378137.0;
+	static constexpr double f = 1 / 298.257222101;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//Odwzorowania kartograficzne
+////////////////////////////////////////////////////////////////////////////////
+//  olamDeg - poudniki osiowe pasw [stopnie], zamieniane na radiany w funkcjach konwersji (deg2rad)
+//  strf - przesunicia pasw [metry]
+////////////////////////////////////////////////////////////////////////////////
+
+struct ProjUTM
+{
+	static constexpr ProjectionType proj = projUTM;
+	static constexpr double ok = 0.9996;
+	static constexpr double nfn = 10000000.0;
+	static constexpr int strips = 0;
+	static constexpr double olamDeg[4] = { 0.0, 0.0, 0.0, 0.0 };
+	static constexpr double strf[4] = { 0.0, 0.0, 0.0, 0.0 };
+};
+
+struct ProjPUWG1992
+{
+	static constexpr ProjectionType proj = projPUWG1992;
+	static constexpr double ok = 0.9993;
+	static constexpr double nfn = -5300000.0;
+	static constexpr int strips = 1;
+	static constexpr double olamDeg[4] = { 19.0, 0.0, 0.0, 0.0 };
+	static constexpr double strf[4] = { 0.0, 0.0, 0.0, 0.0 };
+};
+
+struct ProjPUWG2000
+{
+	static constexpr ProjectionType proj = projPUWG2000;
+	static constexpr double ok = 0.999923;
+	static constexpr double nfn = 0;
+	static constexpr int strips = 4;
+	static constexpr double olamDeg[4] = { 15.0, 18.0, 21.0, 24.0 };
+	static constexpr double strf[4] = { 5000000.0, 6000000.0, 7000000.0, 8000000.0 };
+};
+
+constexpr double ProjUTM::olamDeg[4];
+constexpr double ProjUTM::strf[4];
+constexpr double ProjPUWG1992::olamDeg[4];
+constexpr double ProjPUWG1992::strf[4];
+constexpr double ProjPUWG2000::olamDeg[4];
+constexpr double ProjPUWG2000::strf[4];
+
+//=======================================================================
+//  Kontekst odwzorowania wyznaczany w czasie kompilacji
+//=======================================================================
+//      Pola maj te same nazwy i wartoci co pola ProjectionContext (wyliczane tymi samymi
+//      wzorami, w tej samej kolejnoci dziaa), dziki czemu TMForward i TMInverse
+//      przyjmuj oba rodzaje kontekstu.
+//      Ellipsoid: EllipsoidWGS84, EllipsoidGRS80 lub wasna struktura ze staymi a i f
+//      Projection: ProjUTM, ProjPUWG1992, ProjPUWG2000
+//      Engine: engineClassic lub engineKruger
+//=======================================================================
+template <class Ellipsoid, class Projection, ProjectionEngine Engine = engineClassic>
+struct StaticContext
+{
+	static constexpr ProjectionType proj = Projection::proj;
+	static constexpr ProjectionEngine engine = Engine;
+	// Parametry elipsoidy
+	static constexpr double a = Ellipsoid::a;
+	static constexpr double f = Ellipsoid::f;
+	static constexpr double b = a * ((1.0 / f) - 1.0) / (1.0 / f);
+	static constexpr double eSquared = ((a * a) - (b * b)) / (a * a);
+	static constexpr double e2Squared = ((a * a) - (b * b)) / (b * b);
+	static constexpr double tn = (a - b) / (a + b);
+	// Wspczynniki szeregu dugoci uku poudnika
+	static constexpr double ap = a * (1.0 - tn + 5.0 * ((tn * tn) - (tn * tn * tn)) / 4.0 + 81.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 64.0);
+	static constexpr double bp = 3.0 * a * (tn - (tn * tn) + 7.0 * ((tn * tn * tn) - (tn * tn * tn * tn)) / 8.0 + 55.0 * (tn * tn * tn * tn * tn) / 64.0) / 2.0;
+	static constexpr double cp = 15.0 * a * ((tn * tn) - (tn * tn * tn) + 3.0 * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 4.0) / 16.0;
+	static constexpr double dp = 35.0 * a * ((tn * tn * tn) - (tn * tn * tn * tn) + 11.0 * (tn * tn * tn * tn * tn) / 16.0) / 48.0;
+	static constexpr double ep = 315.0 * a * ((tn * tn * tn * tn) - (tn * tn * tn * tn * tn)) / 512.0;
+	static constexpr double arc[4] = { -bp, cp, -dp, ep };
+	static constexpr double fpb[5] =
+	  {
+	   3.0 * tn / 2.0 - 27.0 * (tn * tn * tn) / 32.0 + 269.0 * (tn * tn * tn * tn * tn) / 512.0,
+	   21.0 * (tn * tn) / 16.0 - 55.0 * (tn * tn * tn * tn) / 32.0,
+	   151.0 * (tn * tn * tn) / 96.0 - 417.0 * (tn * tn * tn * tn * tn) / 128.0,
+	   1097.0 * (tn * tn * tn * tn) / 512.0,
+	   8011.0 * (tn * tn * tn * tn * tn) / 2560.0
+	  };
+	// sphsr (a, eSquared, 0): dla sphi = 0 mianownik jest rwny dokadnie 1
+	static constexpr double sr0 = a * (1.0 - eSquared) / 1.0;
+	// Wspczynnik skali i jego potgi (mnoenie od lewej, jak w CreateProjectionContext)
+	static constexpr double ok = Projection::ok;
+	static constexpr double okPow[9] =
+	  {
+	   1.0, 1.0 * ok, 1.0 * ok * ok, 1.0 * ok * ok * ok, 1.0 * ok * ok * ok * ok,
+	   1.0 * ok * ok * ok * ok * ok, 1.0 * ok * ok * ok * ok * ok * ok,
+	   1.0 * ok * ok * ok * ok * ok * ok * ok, 1.0 * ok * ok * ok * ok * ok * ok * ok * ok
+	  };
+	// Faszywy wschd i faszywa pnoc
+	static constexpr double fe = 500000.0;
+	static constexpr double nfn = Projection::nfn;
+	static constexpr int strips = Projection::strips;
+	// Zawsze pena dokadno: gazie precTruncated i precFloat w TMForward i TMInverse s usuwane w czasie kompilacji
+	static constexpr ProjectionPrecision precision = precFull;
+	static constexpr double truncFwd[3] = { -1.0, -1.0, -1.0 };
+	static constexpr double truncInv[3] = { -1.0, -1.0, -1.0 };
+};
+
+template <class E, class P, ProjectionEngine G> constexpr ProjectionType StaticContext<E, P, G>::proj;
+template <class E, class P, ProjectionEngine G> constexpr ProjectionEngine StaticContext<E, P, G>::engine;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::a;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::f;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::b;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::eSquared;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::e2Squared;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::tn;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::ap;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::bp;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::cp;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::dp;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::ep;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::arc[4];
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::fpb[5];
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::sr0;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::ok;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::okPow[9];
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::fe;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::nfn;
+template <class E, class P, ProjectionEngine G> constexpr int StaticContext<E, P, G>::strips;
+template <class E, class P, ProjectionEngine G> constexpr ProjectionPrecision StaticContext<E, P, G>::precision;
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::truncFwd[3];
+template <class E, class P, ProjectionEngine G> constexpr double StaticContext<E, P, G>::truncInv[3];
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+//  Argumenty jak w funkcjach korzystajcych z kontekstu odwzorowania, np.:
+//       LatLonToUtm<EllipsoidWGS84> (utmXZone, utmYZone, easting, northing, lat, lon);
+//       LatLonToPUWG<EllipsoidGRS80, ProjPUWG2000> (easting, northing, lat, lon);
+//       PUWGToLatLon<EllipsoidGRS80, ProjPUWG1992, engineKruger> (easting, northing, lat, lon);
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y UTM dla elipsoidy Ellipsoid
+//=======================================================================
+template <class Ellipsoid, ProjectionEngine Engine = engineClassic>
+void LatLonToUtm (int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon)
+{
+	typedef StaticContext<Ellipsoid, ProjUTM, Engine> Context;
+	UTM_STATS_CALL (statsLatLonToUtm, 1);
+	UtmZone (lat, lon, utmXZone, utmYZone);
+	UTM_STATS_UTM_ZONES (&utmXZone, &utmYZone, 1, true);
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	double nfn = latRad < 0.0 ? Context::nfn : 0;
+	TMForward (Context (), latRad, lonRad - UtmCentralMeridian (utmXZone), nfn, Context::fe, easting, northing);
+	if (northing >= 9999999.0) northing = 9999999.0;
+}
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y 1992 lub 2000 dla elipsoidy Ellipsoid
+//=======================================================================
+template <class Ellipsoid, class Projection, ProjectionEngine Engine = engineClassic>
+void LatLonToPUWG (double& easting, double& northing, double lat, double lon)
+{
+	typedef StaticContext<Ellipsoid, Projection, Engine> Context;
+	static_assert (Projection::proj != projUTM, "LatLonToPUWG: odwzorowanie 1992 lub 2000");
+	UTM_STATS_CALL (statsLatLonToPUWG, 1);
+	UTM_STATS_PUWG_LON (Projection::proj == projPUWG2000, &lon, 1);
+	if(lon < 13.5 || lon > 25.5)
+	  {
+	   //Bdna warto dugoci geograficznej (zwracana warto 99999999999999)
+	   easting = 999999999999999;
+	   northing = 999999999999999;
+	   return;
+	  }
+	int strip = Projection::proj == projPUWG2000 ? PUWGStripFromLon (lon) : 0;
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	TMForward (Context (), latRad, lonRad - Projection::olamDeg[strip] * deg2rad, Context::nfn, Context::fe + Projection::strf[strip], easting, northing);
+}
+
+//=======================================================================
+//  Konwersja X/Y UTM -> lat/lon dla elipsoidy Ellipsoid
+//=======================================================================
+template <class Ellipsoid, ProjectionEngine Engine = engineClassic>
+void UtmToLatLon (int utmXZone, char utmYZone, double easting, double northing, double& lat, double& lon)
+{
+	typedef StaticContext<Ellipsoid, ProjUTM, Engine> Context;
+	UTM_STATS_CALL (statsUtmToLatLon, 1);
+	UTM_STATS_UTM_ZONES (&utmXZone, &utmYZone, 1, false);
+	double dlam;
+	double nfn = ((utmYZone <= 'M' && utmYZone >= 'C') || (utmYZone <= 'm' && utmYZone >= 'c')) ? Context::nfn : 0;
+	TMInverse (Context (), easting - Context::fe, northing - nfn, lat, dlam);
+	lon = UtmCentralMeridian (utmXZone) + dlam;
+	lon *= rad2deg;
+	lat *= rad2deg;
+}
+
+//=======================================================================
+//  Konwersja X/Y 1992 lub 2000 -> lat/lon dla elipsoidy Ellipsoid
+//=======================================================================
+template <class Ellipsoid, class Projection, ProjectionEngine Engine = engineClassic>
+void PUWGToLatLon (double easting, double northing, double& lat, double& lon)
+{
+	typedef StaticContext<Ellipsoid, Projection, Engine> Context;
+	static_assert (Projection::proj != projUTM, "PUWGToLatLon: odwzorowanie 1992 lub 2000");
+	UTM_STATS_CALL (statsPUWGToLatLon, 1);
+	UTM_STATS_PUWG_EASTING (Projection::proj == projPUWG2000, &easting, 1);
+	double dlam;
+	int strip = Projection::proj == projPUWG2000 ? PUWGStripFromEasting (easting) : 0;
+	TMInverse (Context (), easting - Context::fe - Projection::strf[strip], northing - Context::nfn, lat, dlam);
+	lon = Projection::olamDeg[strip] * deg2rad + dlam;
+	lon *= rad2deg;
+	lat *= rad2deg;
+}
+
+#endif
@@ -0,0 +1,496 @@
+/*
+Statystyki konwersji: liczba wywoa i punktw, histogram czasu wywoa (prbkowany), liczba punktw
+spoza zakresu wedug przyczyny i liczba punktw w kadej strefie UTM / pasie 1992 i 2000
+
+Wczane w czasie kompilacji: #define UTM_1992_2000_STATS przed doczeniem UTM_1992_2000.h.
+Bez tej definicji makra UTM_STATS_* s puste (kod konwersji jest taki sam jak bez statystyk),
+a TakeStatsSnapshot zwraca same zera.
+
+Kady wtek zapisuje liczniki we wasnym bloku (bez operacji atomowych typu read-modify-write
+i bez blokad); bloki s czone w list, do ktrej wtek docza si jednorazowo (compare-exchange),
+a po zakoczeniu wtku blok jest przejmowany przez nastpny nowy wtek, wic ich liczba nie
+przekracza najwikszej liczby wtkw dziaajcych jednoczenie. TakeStatsSnapshot sumuje bloki
+w trakcie pracy innych wtkw (kady licznik odczytany w caoci, liczniki niezalenie od siebie).
+
+Zapisywane jest tylko zewntrzne wywoanie: punkty liczone przez funkcj wsadow wywoujc funkcje
+skalarne (jdro kernelScalar) lub przez funkcj z podziaem na strefy wywoujc funkcj wsadow
+s liczone raz, dla funkcji wywoanej przez program. Strefy, pasy i punkty spoza zakresu funkcji
+wsadowych s liczone na podstawie danych wejciowych i wynikw po konwersji (dodatkowy przebieg
+po tablicach, tylko przy wczonych statystykach).
+
+Funkcje objte statystykami (pozostae funkcje biblioteki nie s liczone osobno):
+  UTM_1992_2000.h, _Batch.h, _Bucketed.h, _Static.h - konwersje lat/lon <-> X/Y (Static.h pod nazwami
+      funkcji z kontekstem odwzorowania); wszystkie liczniki, take strefy, pasy i punkty spoza zakresu
+  _Cache.h     - ConversionCache::LatLonToUtm, LatLonToPUWG (trafienia i chybienia); strefy, pasy i punkty
+                 spoza zakresu jak w LatLonToUtm, LatLonToPUWG
+  _Transform.h - UtmToPUWG, PUWGToUtm i ich wersje wsadowe
+  _Grid.h      - LatLonToPUWGGrid, PUWGToLatLonGrid (budowa siatki nie jest liczona)
+  _Trajectory.h - wersje wsadowe LatLonToUtmTrajectory, LatLonToPUWGTrajectory (funkcje dla jednego punktu
+                 z TrajectoryState nie s liczone)
+  _Warp.h      - BuildWarpMap (punkty: komrki rastra)
+  _Geometry.h  - TransformCoordinatesBatch; ReprojectWkb i ReprojectGeoJson s liczone przez
+                 TransformCoordinatesBatch (wywoanie dla kadego bloku wsprzdnych)
+  _PointCloud.h - przez TransformCoordinatesBatch (wywoanie dla kadego fragmentu w wtku puli)
+  _Datum.h     - DatumShiftBatch; funkcje *DatumBatch s liczone jako kolejne wywoania DatumShiftBatch
+                 i funkcji wsadowej odwzorowania dla kadego bloku datumBlockSize punktw
+  _Parallel.h  - przez funkcj wsadow wywoywan w wtkach puli (wywoanie dla kadego fragmentu);
+                 ConversionPool::Run nie jest liczona
+Liczniki stref, pasw i punktw spoza zakresu zapisuj tylko funkcje z UTM_1992_2000.h, _Batch.h, _Bucketed.h,
+_Static.h i _Cache.h; pozostae funkcje zapisuj liczb wywoa, punktw i czas.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Stats_H
+#define Unit_UTM_1992_2000_Stats_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef UTM_1992_2000_STATS
+#include <atomic>
+#include <chrono>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Funkcje objte statystykami (najpierw funkcje dla jednego punktu, potem wsadowe)
+enum StatsFunction
+{
+	statsLatLonToUtm, statsLatLonToPUWG, statsUtmToLatLon, statsPUWGToLatLon,
+	statsUtmToPUWG, statsPUWGToUtm, statsLatLonToPUWGGrid, statsPUWGToLatLonGrid,
+	statsCacheLatLonToUtm, statsCacheLatLonToPUWG,
+	statsLatLonToUtmBatch, statsLatLonToPUWGBatch, statsUtmToLatLonBatch, statsPUWGToLatLonBatch,
+	statsLatLonToUtmBucketed, statsLatLonToPUWGBucketed, statsUtmToLatLonBucketed, statsPUWGToLatLonBucketed,
+	statsUtmToPUWGBatch, statsPUWGToUtmBatch, statsLatLonToUtmTrajectory, statsLatLonToPUWGTrajectory,
+	statsDatumShiftBatch, statsTransformCoordinatesBatch, statsBuildWarpMap,
+	statsFunctionCount
+};
+
+static const char* const statsFunctionName[statsFunctionCount] =
+{
+	"LatLonToUtm", "LatLonToPUWG", "UtmToLatLon", "PUWGToLatLon",
+	"UtmToPUWG", "PUWGToUtm", "LatLonToPUWGGrid", "PUWGToLatLonGrid",
+	"CacheLatLonToUtm", "CacheLatLonToPUWG",
+	"LatLonToUtmBatch", "LatLonToPUWGBatch", "UtmToLatLonBatch", "PUWGToLatLonBatch",
+	"LatLonToUtmBucketed", "LatLonToPUWGBucketed", "UtmToLatLonBucketed", "PUWGToLatLonBucketed",
+	"UtmToPUWGBatch", "PUWGToUtmBatch", "LatLonToUtmTrajectory", "LatLonToPUWGTrajectory",
+	"DatumShiftBatch", "TransformCoordinatesBatch", "BuildWarpMap"
+};
+
+//Pierwsza funkcja wsadowa (czas mierzony dla kadego wywoania; funkcje skalarne - co statsSampleInterval wywoanie)
+static const int statsFirstBatch = statsLatLonToUtmBatch;
+static const uint64_t statsSampleInterval = 64;
+
+//Przyczyny wyniku spoza zakresu (odpowiadaj statusom ConversionStatus)
+//  statsLonOutOfRange - 1992, 2000: dugo poza zakresem 13.5 - 25.5, wynik 999999999999999
+//  statsLatOutOfRange - UTM: szeroko poza zakresem -80 - 84, strefa '*'
+//  statsFormatError   - bdny zapis MGRS
+enum StatsDomainError { statsLonOutOfRange, statsLatOutOfRange, statsFormatError, statsDomainCount };
+
+static const char* const statsDomainName[statsDomainCount] = { "lon_out_of_range", "lat_out_of_range", "format_error" };
+
+//Histogram czasu wywoania: przedzia k obejmuje czasy [2^k, 2^(k+1)) ns (ostatni - wszystkie dusze);
+//czas obejmuje odczyt zegara (steady_clock, zwykle 20 - 50 ns), istotny tylko dla funkcji skalarnych
+static const int statsLatencyBuckets = 40;
+
+//Liczniki stref: UTM 1 - 60 (0 - strefa spoza zakresu), pasy: 0 - 1992, 1 - 4 - pasy 5 - 8 odwzorowania 2000
+static const int statsUtmZones = 61;
+static const int statsPUWGStrips = 5;
+
+//=======================================================================
+//  Stan statystyk (suma dla wszystkich wtkw)
+//=======================================================================
+struct StatsFunctionSnapshot
+{
+	uint64_t calls;
+	uint64_t points;
+	uint64_t sampled;                            // liczba wywoa w histogramie
+	uint64_t latencySum;                         // suma czasw wywoa w histogramie [ns]
+	uint64_t latency[statsLatencyBuckets];
+};
+
+struct StatsSnapshot
+{
+	StatsFunctionSnapshot function[statsFunctionCount];
+	uint64_t domainErrors[statsDomainCount];
+	uint64_t utmZoneHits[statsUtmZones];
+	uint64_t puwgStripHits[statsPUWGStrips];
+	unsigned threads;                            // liczba blokw wtkw
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+#ifdef UTM_1992_2000_STATS
+
+//Liczniki jednego wtku (zapisywane tylko przez wtek waciciela)
+struct ThreadStats
+{
+	std::atomic<uint64_t> calls[statsFunctionCount];
+	std::atomic<uint64_t> points[statsFunctionCount];
+	std::atomic<uint64_t> sampled[statsFunctionCount];
+	std::atomic<uint64_t> latencySum[statsFunctionCount];
+	std::atomic<uint64_t> latency[statsFunctionCount][statsLatencyBuckets];
+	std::atomic<uint64_t> domainErrors[statsDomainCount];
+	std::atomic<uint64_t> utmZoneHits[statsUtmZones];
+	std::atomic<uint64_t> puwgStripHits[statsPUWGStrips];
+	std::atomic<bool> inUse;
+	ThreadStats* next;
+	int depth;                                   // zagniedenie wywoa funkcji objtych statystykami
+};
+
+//Zwikszenie licznika przez jedynego zapisujcego (zwyky odczyt i zapis, bez blokady magistrali)
+inline void StatsAdd (std::atomic<uint64_t>& counter, uint64_t n)
+{
+	counter.store (counter.load (std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+//Pocztek listy blokw wszystkich wtkw
+inline std::atomic<ThreadStats*>& StatsRegistry ()
+{
+	static std::atomic<ThreadStats*> head (0);
+	return head;
+}
+
+//Blok dla nowego wtku: wolny blok zakoczonego wtku lub nowy, doczany na pocztek listy
+ThreadStats* AcquireThreadStats ()
+{
+	std::atomic<ThreadStats*>& head = StatsRegistry ();
+	for(ThreadStats* t = head.load (std::memory_order_acquire); t; t = t->next)
+	  {
+	   bool free = false;
+	   if(t->inUse.compare_exchange_strong (free, true, std::memory_order_acq_rel)) return t;
+	  }
+	ThreadStats* t = new ThreadStats ();
+	t->inUse.store (true, std::memory_order_relaxed);
+	t->next = head.load (std::memory_order_relaxed);
+	while(!head.compare_exchange_weak (t->next, t, std::memory_order_release, std::memory_order_relaxed)) {}
+	return t;
+}
+
+//Blok biecego wtku, zwalniany po jego zakoczeniu
+struct ThreadStatsHolder
+{
+	ThreadStats* stats;
+	ThreadStatsHolder () : stats (AcquireThreadStats ()) {}
+	~ThreadStatsHolder ()
+	{
+		stats->depth = 0;
+		stats->inUse.store (false, std::memory_order_release);
+	}
+};
+
+inline ThreadStats* StatsThread ()
+{
+	static thread_local ThreadStatsHolder holder;
+	return holder.stats;
+}
+
+inline uint64_t StatsClock ()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+//Wywoanie funkcji objtej statystykami (obiekt na czas wywoania)
+struct StatsScope
+{
+	ThreadStats* stats;
+	int function;
+	uint64_t start;
+
+	StatsScope (int f, size_t count) : stats (StatsThread ()), function (f), start (0)
+	{
+		if(stats->depth++ > 0) return;
+		uint64_t calls = stats->calls[f].load (std::memory_order_relaxed);
+		stats->calls[f].store (calls + 1, std::memory_order_relaxed);
+		StatsAdd (stats->points[f], count);
+		if(f >= statsFirstBatch || calls % statsSampleInterval == 0) start = StatsClock ();
+	}
+
+	~StatsScope ()
+	{
+		if(--stats->depth > 0 || start == 0) return;
+		uint64_t ns = StatsClock () - start;
+		StatsAdd (stats->latencySum[function], ns);
+		int k = 0;
+		while(ns > 1 && k < statsLatencyBuckets - 1)
+		  {
+		   ns >>= 1;
+		   k++;
+		  }
+		StatsAdd (stats->sampled[function], 1);
+		StatsAdd (stats->latency[function][k], 1);
+	}
+};
+
+//Liczniki stref i punktw spoza zakresu zapisywane tylko dla zewntrznego wywoania (lub poza funkcjami objtymi statystykami)
+inline ThreadStats* StatsOuter ()
+{
+	ThreadStats* stats = StatsThread ();
+	return stats->depth <= 1 ? stats : 0;
+}
+
+inline void StatsDomain (int reason, uint64_t n)
+{
+	ThreadStats* stats = StatsOuter ();
+	if(stats && n) StatsAdd (stats->domainErrors[reason], n);
+}
+
+inline void StatsUtmZones (const int* utmXZone, const char* utmYZone, size_t count, bool forward)
+{
+	ThreadStats* stats = StatsOuter ();
+	if(!stats) return;
+	// Histogram lokalny (liczniki bloku zapisywane raz na wywoanie)
+	uint64_t hits[statsUtmZones] = { 0 };
+	for(size_t i = 0; i < count; i++)
+	  {
+	   int z = utmXZone[i];
+	   hits[z >= 1 && z <= 60 && utmYZone[i] != '*' ? z : 0]++;
+	  }
+	for(int z = 0; z < statsUtmZones; z++) if(hits[z]) StatsAdd (stats->utmZoneHits[z], hits[z]);
+	if(forward && hits[0]) StatsAdd (stats->domainErrors[statsLatOutOfRange], hits[0]);
+}
+
+//Sumy porwna zamiast histogramu (ptle bez rozgazie, wektoryzowane przez kompilator w wersji AVX2):
+//  lon:     sum[0] - punkty w zakresie 13.5 - 25.5, sum[1 + k] - w zakresie i od granicy k + 1 pasa 2000 (16.5, 19.5, 22.5)
+//  easting: sum[1 + k] - punkty od pocztku pasu 6, 7, 8 (6000000, 7000000, 8000000)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTM_STATS_AVX2 1
+#define UTM_STATS_LOOP inline __attribute__((always_inline))
+#else
+#define UTM_STATS_LOOP inline
+#endif
+
+UTM_STATS_LOOP void StatsCountLonLoop (const double* lon, size_t count, uint64_t* sum)
+{
+	uint64_t n = 0, s0 = 0, s1 = 0, s2 = 0;
+	for(size_t i = 0; i < count; i++)
+	  {
+	   double l = lon[i];
+	   uint64_t valid = (l >= 13.5) & (l <= 25.5);
+	   n += valid;
+	   s0 += valid & (l >= 16.5);
+	   s1 += valid & (l >= 19.5);
+	   s2 += valid & (l >= 22.5);
+	  }
+	sum[0] = n;
+	sum[1] = s0;
+	sum[2] = s1;
+	sum[3] = s2;
+}
+
+UTM_STATS_LOOP void StatsCountEastingLoop (const double* easting, size_t count, uint64_t* sum)
+{
+	uint64_t s0 = 0, s1 = 0, s2 = 0;
+	for(size_t i = 0; i < count; i++)
+	  {
+	   double e = easting[i];
+	   s0 += e >= 6000000.0;
+	   s1 += e >= 7000000.0;
+	   s2 += e >= 8000000.0;
+	  }
+	sum[0] = count;
+	sum[1] = s0;
+	sum[2] = s1;
+	sum[3] = s2;
+}
+
+#ifdef UTM_STATS_AVX2
+__attribute__((target ("avx2"), optimize ("tree-vectorize"))) void StatsCountLonAvx2 (const double* lon, size_t count, uint64_t* sum)
+{
+	StatsCountLonLoop (lon, count, sum);
+}
+
+__attribute__((target ("avx2"), optimize ("tree-vectorize"))) void StatsCountEastingAvx2 (const double* easting, size_t count, uint64_t* sum)
+{
+	StatsCountEastingLoop (easting, count, sum);
+}
+#endif
+
+inline bool StatsUseAvx2 ()
+{
+#ifdef UTM_STATS_AVX2
+	static const bool avx2 = __builtin_cpu_supports ("avx2");
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+//Dodanie licznikw pasw (is2000 - odwzorowanie 2000) z sum porwna
+inline void StatsPUWGStrips (ThreadStats* stats, bool is2000, const uint64_t* sum)
+{
+	if(!is2000)
+	  {
+	   if(sum[0]) StatsAdd (stats->puwgStripHits[0], sum[0]);
+	   return;
+	  }
+	uint64_t hits[4] = { sum[0] - sum[1], sum[1] - sum[2], sum[2] - sum[3], sum[3] };
+	for(int s = 0; s < 4; s++) if(hits[s]) StatsAdd (stats->puwgStripHits[1 + s], hits[s]);
+}
+
+//Pasy punktw lat/lon i punkty spoza zakresu dugoci geograficznej
+inline void StatsPUWGLon (bool is2000, const double* lon, size_t count)
+{
+	ThreadStats* stats = StatsOuter ();
+	if(!stats) return;
+	uint64_t sum[4];
+#ifdef UTM_STATS_AVX2
+	if(StatsUseAvx2 ()) StatsCountLonAvx2 (lon, count, sum);
+	else
+#endif
+	StatsCountLonLoop (lon, count, sum);
+	StatsPUWGStrips (stats, is2000, sum);
+	if(count - sum[0]) StatsAdd (stats->domainErrors[statsLonOutOfRange], count - sum[0]);
+}
+
+//Pasy punktw X/Y (nr pasa z pierwszej cyfry wsprzdnej easting, jak PUWGStripFromEasting)
+inline void StatsPUWGEasting (bool is2000, const double* easting, size_t count)
+{
+	ThreadStats* stats = StatsOuter ();
+	if(!stats) return;
+	uint64_t sum[4];
+#ifdef UTM_STATS_AVX2
+	if(StatsUseAvx2 ()) StatsCountEastingAvx2 (easting, count, sum);
+	else
+#endif
+	StatsCountEastingLoop (easting, count, sum);
+	StatsPUWGStrips (stats, is2000, sum);
+}
+
+#define UTM_STATS_CALL(function, count) StatsScope statsScope ((function), (count))
+#define UTM_STATS_DOMAIN(reason, count) StatsDomain ((reason), (count))
+#define UTM_STATS_UTM_ZONES(utmXZone, utmYZone, count, forward) StatsUtmZones ((utmXZone), (utmYZone), (count), (forward))
+#define UTM_STATS_PUWG_LON(is2000, lon, count) StatsPUWGLon ((is2000), (lon), (count))
+#define UTM_STATS_PUWG_EASTING(is2000, easting, count) StatsPUWGEasting ((is2000), (easting), (count))
+
+#else
+
+#define UTM_STATS_CALL(function, count)
+#define UTM_STATS_DOMAIN(reason, count)
+#define UTM_STATS_UTM_ZONES(utmXZone, utmYZone, count, forward)
+#define UTM_STATS_PUWG_LON(is2000, lon, count)
+#define UTM_STATS_PUWG_EASTING(is2000, easting, count)
+
+#endif
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja zwraca sum licznikw wszystkich wtkw (zera, gdy statystyki s wyczone)
+//=======================================================================
+//      Liczniki tylko rosn; statystyki przedziau czasu to rnica dwch stanw.
+//=======================================================================
+StatsSnapshot TakeStatsSnapshot ()
+{
+	StatsSnapshot s;
+	memset (&s, 0, sizeof (s));
+#ifdef UTM_1992_2000_STATS
+	const std::memory_order r = std::memory_order_relaxed;
+	for(ThreadStats* t = StatsRegistry ().load (std::memory_order_acquire); t; t = t->next)
+	  {
+	   s.threads++;
+	   for(int f = 0; f < statsFunctionCount; f++)
+	     {
+	      s.function[f].calls += t->calls[f].load (r);
+	      s.function[f].points += t->points[f].load (r);
+	      s.function[f].sampled += t->sampled[f].load (r);
+	      s.function[f].latencySum += t->latencySum[f].load (r);
+	      for(int k = 0; k < statsLatencyBuckets; k++) s.function[f].latency[k] += t->latency[f][k].load (r);
+	     }
+	   for(int d = 0; d < statsDomainCount; d++) s.domainErrors[d] += t->domainErrors[d].load (r);
+	   for(int z = 0; z < statsUtmZones; z++) s.utmZoneHits[z] += t->utmZoneHits[z].load (r);
+	   for(int p = 0; p < statsPUWGStrips; p++) s.puwgStripHits[p] += t->puwgStripHits[p].load (r);
+	  }
+#endif
+	return s;
+}
+
+//=======================================================================
+//  Funkcja zwraca przybliony kwantyl q (0 - 1) czasu wywoania [ns] - grn granic przedziau histogramu
+//=======================================================================
+//      Wynik 0, gdy dla funkcji nie zmierzono adnego wywoania.
+//=======================================================================
+double StatsLatencyQuantile (const StatsFunctionSnapshot& fs, double q)
+{
+	if(fs.sampled == 0) return 0.0;
+	uint64_t rank = (uint64_t)(q * (double)fs.sampled);
+	if(rank >= fs.sampled) rank = fs.sampled - 1;
+	uint64_t seen = 0;
+	for(int k = 0; k < statsLatencyBuckets; k++)
+	  {
+	   seen += fs.latency[k];
+	   if(seen > rank) return ldexp (1.0, k + 1);
+	  }
+	return ldexp (1.0, statsLatencyBuckets);
+}
+
+//=======================================================================
+//  Funkcja zapisuje stan statystyk w formacie tekstowym Prometheus (pomijane liczniki zerowe)
+//=======================================================================
+//       const StatsSnapshot& s: stan statystyk (TakeStatsSnapshot)
+//       FILE* out: plik wynikowy
+//=======================================================================
+void WriteStatsSnapshot (const StatsSnapshot& s, FILE* out)
+{
+	static const char* const stripName[statsPUWGStrips] = { "1992", "2000_5", "2000_6", "2000_7", "2000_8" };
+	fprintf (out, "# TYPE geoconverter_calls_total counter\n");
+	for(int f = 0; f < statsFunctionCount; f++)
+	  {
+	   if(s.function[f].calls) fprintf (out, "geoconverter_calls_total{function=\"%s\"} %llu\n", statsFunctionName[f], (unsigned long long)s.function[f].calls);
+	  }
+	fprintf (out, "# TYPE geoconverter_points_total counter\n");
+	for(int f = 0; f < statsFunctionCount; f++)
+	  {
+	   if(s.function[f].calls) fprintf (out, "geoconverter_points_total{function=\"%s\"} %llu\n", statsFunctionName[f], (unsigned long long)s.function[f].points);
+	  }
+	fprintf (out, "# TYPE geoconverter_call_duration_ns histogram\n");
+	for(int f = 0; f < statsFunctionCount; f++)
+	  {
+	   const StatsFunctionSnapshot& fs = s.function[f];
+	   if(fs.sampled == 0) continue;
+	   // Przedziay od pierwszego do ostatniego niezerowego
+	   uint64_t cumulative = 0;
+	   int first = 0;
+	   int last = statsLatencyBuckets - 1;
+	   while(first < last && fs.latency[first] == 0) first++;
+	   while(last > first && fs.latency[last] == 0) last--;
+	   for(int k = first; k <= last; k++)
+	     {
+	      cumulative += fs.latency[k];
+	      fprintf (out, "geoconverter_call_duration_ns_bucket{function=\"%s\",le=\"%.0f\"} %llu\n", statsFunctionName[f], ldexp (1.0, k + 1), (unsigned long long)cumulative);
+	     }
+	   fprintf (out, "geoconverter_call_duration_ns_bucket{function=\"%s\",le=\"+Inf\"} %llu\n", statsFunctionName[f], (unsigned long long)fs.sampled);
+	   fprintf (out, "geoconverter_call_duration_ns_sum{function=\"%s\"} %llu\n", statsFunctionName[f], (unsigned long long)fs.latencySum);
+	   fprintf (out, "geoconverter_call_duration_ns_count{function=\"%s\"} %llu\n", statsFunctionName[f], (unsigned long long)fs.sampled);
+	  }
+	fprintf (out, "# TYPE geoconverter_domain_errors_total counter\n");
+	for(int d = 0; d < statsDomainCount; d++)
+	  {
+	   fprintf (out, "geoconverter_domain_errors_total{reason=\"%s\"} %llu\n", statsDomainName[d], (unsigned long long)s.domainErrors[d]);
+	  }
+	fprintf (out, "# TYPE geoconverter_utm_zone_points_total counter\n");
+	for(int z = 0; z < statsUtmZones; z++)
+	  {
+	   if(s.utmZoneHits[z] == 0) continue;
+	   if(z) fprintf (out, "geoconverter_utm_zone_points_total{zone=\"%d\"} %llu\n", z, (unsigned long long)s.utmZoneHits[z]);
+	   else fprintf (out, "geoconverter_utm_zone_points_total{zone=\"*\"} %llu\n", (unsigned long long)s.utmZoneHits[z]);
+	  }
+	fprintf (out, "# TYPE geoconverter_puwg_strip_points_total counter\n");
+	for(int p = 0; p < statsPUWGStrips; p++)
+	  {
+	   if(s.puwgStripHits[p]) fprintf (out, "geoconverter_puwg_strip_points_total{strip=\"%s\"} %llu\n", stripName[p], (unsigned long long)s.puwgStripHits[p]);
+	  }
+}
+
+#endif
@@ -0,0 +1,310 @@
+/*
+Konwersje lat/lon -> X/Y UTM, 1992, 2000 dla gstych cigw punktw (trasy GPS)
+Odwzorowanie Gaussa-Krgera jest konforemne: X + iY jest funkcj analityczn zmiennej q + i lam
+(q - szeroko izometryczna). Dla punktu zaczepienia trasy liczony jest peny szereg oraz pochodne
+zespolone X + iY (ilorazy rnicowe wzdu dugoci geograficznej), a kolejne punkty s liczone
+wielomianem trzeciego stopnia wzgldem punktu zaczepienia - bez sin, cos, sphsn i sphtmd.
+Nowy punkt zaczepienia jest wyznaczany, gdy punkt wychodzi poza promie, w ktrym bd rozwinicia
+nie przekracza zadanej tolerancji, lub gdy zmienia si strefa, pkula albo pas odwzorowania.
+Kady punkt jest liczony bezporednio od punktu zaczepienia, wic bdy si nie kumuluj.
+
+Konwersja odwrotna nie jest obsugiwana (trasy GPS s rejestrowane w lat/lon).
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Trajectory_H
+#define Unit_UTM_1992_2000_Trajectory_H
+
+#include <stddef.h>
+#include <math.h>
+#include "UTM_1992_2000_Batch.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Domylna tolerancja bdu rozwinicia wzgldem penego szeregu [metry]
+//(mniejsze wartoci ni 1e-5 m nie s zachowywane - bdy zaokrgle ilorazw rnicowych)
+static const double trajectoryTolerance = 0.0001;
+
+//Krok ilorazw rnicowych w punkcie zaczepienia i najwikszy promie rozwinicia [radiany]
+static const double trajectoryStep = 0.001;
+static const double trajectoryMaxRadius = 0.01;
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Struktury danych
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Stan konwersji trasy: punkt zaczepienia i wspczynniki rozwinicia
+//=======================================================================
+//      Stan tworzy funkcja CreateTrajectoryState; jest zmieniany przy kadym punkcie, wic
+//      kada trasa (i kady wtek) potrzebuje wasnego stanu.
+//=======================================================================
+struct TrajectoryState
+{
+	// Kopia kontekstu odwzorowania (zawsze precFull)
+	ProjectionContext ctx;
+	double tolerance;
+	// Punkt zaczepienia: brak (false) lub strefa UTM / pas 2000 i pkula
+	bool anchored;
+	int zone;
+	bool south;
+	// Szeroko i dugo geograficzna punktu zaczepienia [radiany]
+	double lat0;
+	double lon0;
+	// Najwiksze |dlat|, |dlon| wzgldem punktu zaczepienia [radiany]
+	double maxDLat;
+	double maxDLon;
+	// Wspczynniki szeregu q - q0 wzgldem dlat: q', q''/2, q'''/6
+	double q1, q2, q3;
+	// X + iY w punkcie zaczepienia i pochodne zespolone Z', Z''/2, Z'''/6 (cz rzeczywista - northing, urojona - easting)
+	double n0, e0;
+	double z1n, z1e, z2n, z2e, z3n, z3e;
+	// Liczba punktw zaczepienia i wszystkich punktw od utworzenia stanu
+	size_t anchors;
+	size_t points;
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja tworzy stan konwersji trasy
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania (poziom dokadnoci jest ignorowany - punkty
+//                                     zaczepienia s liczone penym szeregiem)
+//       double tolerance: najwikszy bd rozwinicia wzgldem penego szeregu [metry]
+//=======================================================================
+TrajectoryState CreateTrajectoryState (const ProjectionContext& ctx, double tolerance = trajectoryTolerance)
+{
+	TrajectoryState t;
+	t.ctx = ctx;
+	t.ctx.precision = precFull;
+	for(int g = 0; g < 3; g++)
+	  {
+	   t.ctx.truncFwd[g] = -1.0;
+	   t.ctx.truncInv[g] = -1.0;
+	  }
+	t.tolerance = tolerance;
+	t.anchored = false;
+	t.zone = 0;
+	t.south = false;
+	t.anchors = 0;
+	t.points = 0;
+	return t;
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: nowy punkt zaczepienia trasy
+//=======================================================================
+//       TrajectoryState& t: stan konwersji trasy
+//       double latRad, double lonRad: punkt zaczepienia [radiany]
+//       double olam: poudnik osiowy [radiany]
+//       double nfn, double efe: faszywa pnoc i wschd (cznie z przesuniciem pasa) [metry]
+//       double& easting, double& northing: wsprzdne punktu zaczepienia (peny szereg) [metry]
+//=======================================================================
+//      Pochodne Z(k) = d^k (X + iY) / d(q + i lam)^k s liczone z piciu wartoci penego szeregu
+//      w odstpach trajectoryStep wzdu dugoci: d^k / dlam^k = i^k Z(k). Promie rozwinicia
+//      wynika z wyrazw czwartego rzdu: |Z''''| |w|^4 / 24 dla w = q - q0 + i dlam oraz bdu
+//      szeregu q - q0 obcitego do dlat^3: |Z'| |q''''| dlat^4 / 24.
+//=======================================================================
+void AnchorTrajectory (TrajectoryState& t, double latRad, double lonRad, double olam, double nfn, double efe, double& easting, double& northing)
+{
+	const ProjectionContext& ctx = t.ctx;
+	double h = trajectoryStep;
+	double dlam = lonRad - olam;
+	double fn[5], fe[5];
+	for(int k = 0; k < 5; k++)
+	  {
+	   if(k == 2) continue;
+	   TMForward (ctx, latRad, dlam + (k - 2) * h, nfn, efe, fe[k], fn[k]);
+	  }
+	TMForward (ctx, latRad, dlam, nfn, efe, easting, northing);
+	fn[2] = northing;
+	fe[2] = easting;
+	// Pochodne wzgldem dlam (wzory piciopunktowe)
+	double d1n = (fn[0] - 8.0 * fn[1] + 8.0 * fn[3] - fn[4]) / (12.0 * h);
+	double d1e = (fe[0] - 8.0 * fe[1] + 8.0 * fe[3] - fe[4]) / (12.0 * h);
+	double d2n = (-fn[0] + 16.0 * fn[1] - 30.0 * fn[2] + 16.0 * fn[3] - fn[4]) / (12.0 * h * h);
+	double d2e = (-fe[0] + 16.0 * fe[1] - 30.0 * fe[2] + 16.0 * fe[3] - fe[4]) / (12.0 * h * h);
+	double d3n = (-fn[0] + 2.0 * fn[1] - 2.0 * fn[3] + fn[4]) / (2.0 * h * h * h);
+	double d3e = (-fe[0] + 2.0 * fe[1] - 2.0 * fe[3] + fe[4]) / (2.0 * h * h * h);
+	double d4n = (fn[0] - 4.0 * fn[1] + 6.0 * fn[2] - 4.0 * fn[3] + fn[4]) / (h * h * h * h);
+	double d4e = (fe[0] - 4.0 * fe[1] + 6.0 * fe[2] - 4.0 * fe[3] + fe[4]) / (h * h * h * h);
+	// Z' = -i d1, Z'' = -d2, Z''' = i d3 (dla Z = n + i e: -i (a + ib) = b - ia, i (a + ib) = -b + ia)
+	t.n0 = northing;
+	t.e0 = easting;
+	t.z1n = d1e;
+	t.z1e = -d1n;
+	t.z2n = -d2n / 2.0;
+	t.z2e = -d2e / 2.0;
+	t.z3n = -d3e / 6.0;
+	t.z3e = d3n / 6.0;
+	// Pochodne szerokoci izometrycznej q wzgldem szerokoci geograficznej
+	double es = ctx.eSquared;
+	double s = sin (latRad);
+	double c = cos (latRad);
+	double s2 = 2.0 * s * c;
+	double c2 = (c - s) * (c + s);
+	double den = 1.0 - es * s * s;
+	double g0 = s / c + es * s2 / den;
+	double g1 = 1.0 / (c * c) + 2.0 * es * c2 / den + es * es * s2 * s2 / (den * den);
+	double g2 = 2.0 * s / (c * c * c) - 4.0 * es * s2 / den + 6.0 * es * es * s2 * c2 / (den * den) + 2.0 * es * es * es * s2 * s2 * s2 / (den * den * den);
+	double q1 = (1.0 - es) / (den * c);
+	t.q1 = q1;
+	t.q2 = q1 * g0 / 2.0;
+	t.q3 = q1 * (g0 * g0 + g1) / 6.0;
+	double q4 = q1 * (g0 * g0 * g0 + 3.0 * g0 * g1 + g2);
+	// Promie: |dlon| <= r, |dlat| <= r / q' (|w| <= r sqrt 2), bd <= tolerance / 2
+	double k = hypot (d4n, d4e) / 6.0 + hypot (d1n, d1e) * fabs (q4) / (24.0 * q1 * q1 * q1 * q1);
+	double r = k > 0.0 ? pow (0.5 * t.tolerance / k, 0.25) : trajectoryMaxRadius;
+	if(r > trajectoryMaxRadius) r = trajectoryMaxRadius;
+	t.lat0 = latRad;
+	t.lon0 = lonRad;
+	t.maxDLon = r;
+	t.maxDLat = r / q1;
+	t.anchored = true;
+	t.anchors++;
+}
+
+//=======================================================================
+//  Funkcja pomocnicza: wsprzdne punktu z rozwinicia wok punktu zaczepienia
+//=======================================================================
+//      Wynik: false, jeli punkt jest poza promieniem rozwinicia.
+//=======================================================================
+bool ExpandTrajectory (const TrajectoryState& t, double latRad, double lonRad, double& easting, double& northing)
+{
+	double dlat = latRad - t.lat0;
+	double dlon = lonRad - t.lon0;
+	if(!(fabs (dlat) <= t.maxDLat && fabs (dlon) <= t.maxDLon)) return false;
+	// w = q - q0 + i dlon, X + iY = Z0 + w (Z' + w (Z''/2 + w Z'''/6))
+	double wn = dlat * (t.q1 + dlat * (t.q2 + dlat * t.q3));
+	double we = dlon;
+	double an = t.z2n + (wn * t.z3n - we * t.z3e);
+	double ae = t.z2e + (wn * t.z3e + we * t.z3n);
+	double bn = t.z1n + (wn * an - we * ae);
+	double be = t.z1e + (wn * ae + we * an);
+	northing = t.n0 + (wn * bn - we * be);
+	easting = t.e0 + (wn * be + we * bn);
+	return true;
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Konwersja kolejnego punktu trasy lat/lon -> X/Y UTM (odpowiednik LatLonToUtm)
+//=======================================================================
+//       TrajectoryState& t: stan konwersji trasy utworzony dla kontekstu UTM
+//       pozostae argumenty jak w LatLonToUtm
+//=======================================================================
+void LatLonToUtmTrajectory (TrajectoryState& t, int& utmXZone, char& utmYZone, double& easting, double& northing, double lat, double lon)
+{
+	UtmZone (lat, lon, utmXZone, utmYZone);
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	bool south = latRad < 0.0;
+	t.points++;
+	if(!t.anchored || t.zone != utmXZone || t.south != south || !ExpandTrajectory (t, latRad, lonRad, easting, northing))
+	  {
+	   t.zone = utmXZone;
+	   t.south = south;
+	   AnchorTrajectory (t, latRad, lonRad, UtmCentralMeridian (utmXZone), south ? t.ctx.nfn : 0, t.ctx.fe, easting, northing);
+	  }
+	if (northing >= 9999999.0) northing = 9999999.0;
+}
+
+//=======================================================================
+//  Konwersja kolejnego punktu trasy lat/lon -> X/Y 1992 lub 2000 (odpowiednik LatLonToPUWG)
+//=======================================================================
+//       TrajectoryState& t: stan konwersji trasy utworzony dla kontekstu 1992 lub 2000
+//       pozostae argumenty jak w LatLonToPUWG (dla dugoci spoza zakresu 13.5 - 25.5 wynik 999999999999999)
+//=======================================================================
+void LatLonToPUWGTrajectory (TrajectoryState& t, double& easting, double& northing, double lat, double lon)
+{
+	t.points++;
+	if(lon < 13.5 || lon > 25.5)
+	  {
+	   easting = 999999999999999;
+	   northing = 999999999999999;
+	   return;
+	  }
+	int strip = 0;
+	if(t.ctx.proj == projPUWG2000) strip = PUWGStripFromLon (lon);
+	double latRad = lat * deg2rad;
+	double lonRad = lon * deg2rad;
+	if(!t.anchored || t.zone != strip || !ExpandTrajectory (t, latRad, lonRad, easting, northing))
+	  {
+	   t.zone = strip;
+	   AnchorTrajectory (t, latRad, lonRad, t.ctx.olam[strip], t.ctx.nfn, t.ctx.fe + t.ctx.strf[strip], easting, northing);
+	  }
+}
+
+//=======================================================================
+//  Konwersja trasy lat/lon -> X/Y UTM (count kolejnych punktw, odpowiednik LatLonToUtmBatch)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM
+//       int* utmXZone, char* utmYZone, double* easting, double* northing: wyniki (count elementw)
+//       const double* lat, const double* lon: kolejne punkty trasy [stopnie]
+//       size_t count: liczba punktw
+//       unsigned char* status: status konwersji kadego punktu (ConversionStatus) lub 0
+//       double tolerance: najwikszy bd wzgldem penego szeregu [metry]
+//      Wynik: liczba punktw liczonych penym szeregiem (punktw zaczepienia).
+//=======================================================================
+size_t LatLonToUtmTrajectory (const ProjectionContext& ctx, int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, double tolerance = trajectoryTolerance)
+{
+	UTM_STATS_CALL (statsLatLonToUtmTrajectory, count);
+	TrajectoryState t = CreateTrajectoryState (ctx, tolerance);
+	for(size_t i = 0; i < count; i++)
+	  {
+	   LatLonToUtmTrajectory (t, utmXZone[i], utmYZone[i], easting[i], northing[i], lat[i], lon[i]);
+	   if(status) status[i] = utmYZone[i] != '*' ? statusOK : statusLatOutOfRange;
+	  }
+	return t.anchors;
+}
+
+//=======================================================================
+//  Konwersja trasy lat/lon -> X/Y 1992 lub 2000 (count kolejnych punktw, odpowiednik LatLonToPUWGBatch)
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania 1992 lub 2000
+//       pozostae argumenty jak w LatLonToUtmTrajectory
+//      Wynik: liczba punktw liczonych penym szeregiem (punktw zaczepienia).
+//=======================================================================
+size_t LatLonToPUWGTrajectory (const ProjectionContext& ctx, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0, double tolerance = trajectoryTolerance)
+{
+	UTM_STATS_CALL (statsLatLonToPUWGTrajectory, count);
+	TrajectoryState t = CreateTrajectoryState (ctx, tolerance);
+	for(size_t i = 0; i < count; i++)
+	  {
+	   LatLonToPUWGTrajectory (t, easting[i], northing[i], lat[i], lon[i]);
+	   if(status) status[i] = (lon[i] >= 13.5 && lon[i] <= 25.5) ? statusOK : statusLonOutOfRange;
+	  }
+	return t.anchors;
+}
+
+//==============================================================================
+// Funkcja do konwersji trasy lat/lon WGS 84 na X/Y UTM
+//==============================================================================
+size_t LatLonToUtmWGS84Trajectory(int* utmXZone, char* utmYZone, double* easting, double* northing, const double* lat, const double* lon, size_t count, unsigned char* status = 0)
+   {
+   return LatLonToUtmTrajectory (WGS84Context (projUTM), utmXZone, utmYZone, easting, northing, lat, lon, count, status);
+   }
+
+//==============================================================================
+// Funkcja do konwersji trasy lat/lon WGS 84 na X/Y 1992 lub 2000
+//==============================================================================
+size_t LatLonToPUWGWGS84Trajectory(double* easting, double* northing, const double* lat, const double* lon, size_t count, int proj, unsigned char* status = 0)
+   {
+   //proj = 1 - dla odwzorowania kartograficznego 1992, kada inna warto dla 2000
+   return LatLonToPUWGTrajectory (WGS84Context (proj == 1 ? projPUWG1992 : projPUWG2000), easting, northing, lat, lon, count, status);
+   }
+
+#endif
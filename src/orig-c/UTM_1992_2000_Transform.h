@@ -0,0 +1,199 @@
+/*
+Przeksztacenia bezporednie X/Y UTM <-> X/Y 1992 lub 2000 (ta sama elipsoida)
+Odpowiednik wywoania UtmToLatLon, a nastpnie LatLonToPUWG (i odwrotnie), bez zamiany
+szerokoci i dugoci geograficznej na stopnie i z powrotem; oba etapy korzystaj z jednego
+kontekstu przeksztacenia.
+
+Dokadno wzgldem wyniku dwuetapowego: rnica wynika wycznie z pominicia zaokrgle
+przy zamianie radiany -> stopnie -> radiany i nie przekracza 1e-8 m (zmierzone dla punktw
+stref 33, 34, 35 i caego obszaru Polski, jdro skalarne i wektorowe). Punkty lece dokadnie
+na granicy pasa 2000 lub zakresu 13.5 - 25.5 stopnia mog zosta przypisane do ssiedniego
+pasa / uznane za bdne inaczej ni w obliczeniu dwuetapowym (rnica rzdu 1e-16 radiana).
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Transform_H
+#define Unit_UTM_1992_2000_Transform_H
+
+#include <stddef.h>
+#include "UTM_1992_2000_Batch.h"
+
+//=======================================================================
+//  Kontekst przeksztacenia: konteksty odwzorowania rdowego i docelowego
+//=======================================================================
+struct TransformContext
+{
+	ProjectionContext src;
+	ProjectionContext dst;
+};
+
+//=======================================================================
+//  Funkcja wyznacza kontekst przeksztacenia midzy odwzorowaniami dla dowolnej elipsoidy
+//=======================================================================
+//       double a: dugo duej posi elipsoidy odniesienia, w metrach (np. dla elipsoidy WGS 84, 6378137.0)
+//       double f: spaszczenie elipsoidalne (np. dla elipsoidy WGS 84, 1 / 298.257223563)
+//       ProjectionType src: odwzorowanie rdowe (projUTM, projPUWG1992, projPUWG2000)
+//       ProjectionType dst: odwzorowanie docelowe (projUTM, projPUWG1992, projPUWG2000)
+//       ProjectionEngine engine: metoda oblicze obu etapw (engineClassic, engineKruger)
+//       ProjectionPrecision precision: poziom dokadnoci obu etapw (precFull, precTruncated, precFloat)
+//=======================================================================
+TransformContext CreateTransformContext (double a, double f, ProjectionType src, ProjectionType dst, ProjectionEngine engine = engineClassic, ProjectionPrecision precision = precFull)
+{
+	TransformContext tc;
+	tc.src = CreateProjectionContext (a, f, src, engine, precision);
+	tc.dst = CreateProjectionContext (a, f, dst, engine, precision);
+	return tc;
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Przeksztacenie X/Y UTM -> X/Y 1992 lub 2000
+//=======================================================================
+//       const TransformContext& tc: kontekst przeksztacenia projUTM -> projPUWG1992 lub projPUWG2000
+//       int utmXZone, char utmYZone: strefa UTM punktu
+//       double easting, double northing: wsprzdne Y, X UTM [metry]
+//       double& dstEasting, double& dstNorthing: wsprzdne Y, X 1992 lub 2000 po przeksztaceniu [metry];
+//                                               dla punktu spoza zakresu 13.5 - 25.5 stopnia 999999999999999
+//=======================================================================
+void UtmToPUWG (const TransformContext& tc, int utmXZone, char utmYZone, double easting, double northing, double& dstEasting, double& dstNorthing)
+{
+	UTM_STATS_CALL (statsUtmToPUWG, 1);
+	double nfn = 0;
+	double latRad, dlam;
+	if((utmYZone <= 'M' && utmYZone >= 'C') || (utmYZone <= 'm' && utmYZone >= 'c')) nfn = tc.src.nfn;
+	TMInverse (tc.src, easting - tc.src.fe, northing - nfn, latRad, dlam);
+	double lonRad = UtmCentralMeridian (utmXZone) + dlam;
+	if(!(lonRad >= 13.5 * deg2rad && lonRad <= 25.5 * deg2rad))
+	  {
+	   //Bdna warto dugoci geograficznej (zwracana warto 99999999999999)
+	   dstEasting = 999999999999999;
+	   dstNorthing = 999999999999999;
+	   return;
+	  }
+	int strip = 0;
+	if(tc.dst.proj == projPUWG2000)
+	  {
+	   if(lonRad >= 16.5 * deg2rad) strip = 1;
+	   if(lonRad >= 19.5 * deg2rad) strip = 2;
+	   if(lonRad >= 22.5 * deg2rad) strip = 3;
+	  }
+	TMForward (tc.dst, latRad, lonRad - tc.dst.olam[strip], tc.dst.nfn, tc.dst.fe + tc.dst.strf[strip], dstEasting, dstNorthing);
+}
+
+//=======================================================================
+//  Przeksztacenie X/Y 1992 lub 2000 -> X/Y UTM
+//=======================================================================
+//       const TransformContext& tc: kontekst przeksztacenia projPUWG1992 lub projPUWG2000 -> projUTM
+//       double easting, double northing: wsprzdne Y, X 1992 lub 2000 [metry]
+//       int& utmXZone, char& utmYZone: strefa UTM punktu po przeksztaceniu (jak w LatLonToUtm)
+//       double& dstEasting, double& dstNorthing: wsprzdne Y, X UTM po przeksztaceniu [metry]
+//=======================================================================
+void PUWGToUtm (const TransformContext& tc, double easting, double northing, int& utmXZone, char& utmYZone, double& dstEasting, double& dstNorthing)
+{
+	UTM_STATS_CALL (statsPUWGToUtm, 1);
+	double latRad, dlam;
+	int strip = 0;
+	if(tc.src.proj == projPUWG2000) strip = PUWGStripFromEasting (easting);
+	TMInverse (tc.src, easting - tc.src.fe - tc.src.strf[strip], northing - tc.src.nfn, latRad, dlam);
+	double lonRad = tc.src.olam[strip] + dlam;
+	// Strefa UTM wyznaczana ze stopni, szereg odwzorowania liczony z radianw
+	UtmZone (latRad * rad2deg, lonRad * rad2deg, utmXZone, utmYZone);
+	TMForward (tc.dst, latRad, lonRad - UtmCentralMeridian (utmXZone), latRad < 0.0 ? tc.dst.nfn : 0.0, tc.dst.fe, dstEasting, dstNorthing);
+	if (dstNorthing >= 9999999.0) dstNorthing = 9999999.0;
+}
+
+//=======================================================================
+//  Wsadowe przeksztacenie X/Y UTM -> X/Y 1992 lub 2000 (odpowiednik UtmToPUWG dla count punktw)
+//=======================================================================
+//       const TransformContext& tc: kontekst przeksztacenia projUTM -> projPUWG1992 lub projPUWG2000
+//       const int* utmXZone, const char* utmYZone: strefy UTM punktw
+//       const double* easting, const double* northing: wsprzdne Y, X UTM [metry]
+//       double* dstEasting, double* dstNorthing: wsprzdne Y, X 1992 lub 2000 po przeksztaceniu [metry]
+//       size_t count: liczba punktw
+//       unsigned char* status: status przeksztacenia kadego punktu (statusOK, statusLonOutOfRange) lub 0
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+void UtmToPUWGBatch (const TransformContext& tc, const int* utmXZone, const char* utmYZone, const double* easting, const double* northing, double* dstEasting, double* dstNorthing, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsUtmToPUWGBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::UtmToPUWGKernel (tc.src, tc.dst, utmXZone, utmYZone, easting, northing, dstEasting, dstNorthing, count, status); break;
+	   case kernelAvx2: SimdAvx2::UtmToPUWGKernel (tc.src, tc.dst, utmXZone, utmYZone, easting, northing, dstEasting, dstNorthing, count, status); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        UtmToPUWG (tc, utmXZone[i], utmYZone[i], easting[i], northing[i], dstEasting[i], dstNorthing[i]);
+	        if(status) status[i] = dstEasting[i] != 999999999999999 ? statusOK : statusLonOutOfRange;
+	       }
+	     break;
+	  }
+}
+
+//=======================================================================
+//  Wsadowe przeksztacenie X/Y 1992 lub 2000 -> X/Y UTM (odpowiednik PUWGToUtm dla count punktw)
+//=======================================================================
+//       const TransformContext& tc: kontekst przeksztacenia projPUWG1992 lub projPUWG2000 -> projUTM
+//       const double* easting, const double* northing: wsprzdne Y, X 1992 lub 2000 [metry]
+//       int* utmXZone, char* utmYZone: strefy UTM po przeksztaceniu
+//       double* dstEasting, double* dstNorthing: wsprzdne Y, X UTM po przeksztaceniu [metry]
+//       size_t count: liczba punktw
+//       unsigned char* status: status przeksztacenia kadego punktu (statusOK, statusLatOutOfRange) lub 0
+//       BatchKernel kernel: wersja jdra obliczeniowego
+//=======================================================================
+void PUWGToUtmBatch (const TransformContext& tc, const double* easting, const double* northing, int* utmXZone, char* utmYZone, double* dstEasting, double* dstNorthing, size_t count, unsigned char* status = 0, BatchKernel kernel = kernelAuto)
+{
+	UTM_STATS_CALL (statsPUWGToUtmBatch, count);
+	switch(ResolveBatchKernel (kernel))
+	  {
+#ifdef UTM_1992_2000_SIMD
+	   case kernelAvx512: SimdAvx512::PUWGToUtmKernel (tc.src, tc.dst, easting, northing, utmXZone, utmYZone, dstEasting, dstNorthing, count, status); break;
+	   case kernelAvx2: SimdAvx2::PUWGToUtmKernel (tc.src, tc.dst, easting, northing, utmXZone, utmYZone, dstEasting, dstNorthing, count, status); break;
+#endif
+	   default:
+	     for(size_t i = 0; i < count; i++)
+	       {
+	        PUWGToUtm (tc, easting[i], northing[i], utmXZone[i], utmYZone[i], dstEasting[i], dstNorthing[i]);
+	        if(status) status[i] = utmYZone[i] != '*' ? statusOK : statusLatOutOfRange;
+	       }
+	     break;
+	  }
+}
+
+//==============================================================================
+// Funkcja zwraca kontekst przeksztacenia UTM <-> 1992 lub 2000 dla elipsoidy WGS 84 (wyznaczany jednorazowo)
+//==============================================================================
+const TransformContext& WGS84TransformContext (ProjectionType src, ProjectionType dst)
+    {
+    static const TransformContext to1992 = CreateTransformContext (6378137.0, 1 / 298.257223563, projUTM, projPUWG1992);
+    static const TransformContext to2000 = CreateTransformContext (6378137.0, 1 / 298.257223563, projUTM, projPUWG2000);
+    static const TransformContext from1992 = CreateTransformContext (6378137.0, 1 / 298.257223563, projPUWG1992, projUTM);
+    static const TransformContext from2000 = CreateTransformContext (6378137.0, 1 / 298.257223563, projPUWG2000, projUTM);
+    if(src == projUTM) return dst == projPUWG1992 ? to1992 : to2000;
+    return src == projPUWG1992 ? from1992 : from2000;
+    }
+
+//==============================================================================
+// Funkcja do przeksztacenia wsprzdnych X/Y UTM (WGS 84) na X/Y 1992 lub 2000
+//==============================================================================
+void UtmToPUWGWGS84(int utmXZone, char utmYZone, double easting, double northing, double& dstEasting, double& dstNorthing, int proj)
+   {
+   //proj = 1 - dla odwzorowania kartograficznego 1992, kada inna warto dla 2000
+   UtmToPUWG (WGS84TransformContext (projUTM, proj == 1 ? projPUWG1992 : projPUWG2000), utmXZone, utmYZone, easting, northing, dstEasting, dstNorthing);
+   }
+
+//==============================================================================
+// Funkcja do przeksztacenia wsprzdnych X/Y 1992 lub 2000 na X/Y UTM (WGS 84)
+//==============================================================================
+void PUWGToUtmWGS84(double easting, double northing, int proj, int& utmXZone, char& utmYZone, double& dstEasting, double& dstNorthing)
+   {
+   PUWGToUtm (WGS84TransformContext (proj == 1 ? projPUWG1992 : projPUWG2000, projUTM), easting, northing, utmXZone, utmYZone, dstEasting, dstNorthing);
+   }
+
+#endif
@@ -0,0 +1,400 @@
+/*
+Mapa przeksztacenia rastra (warp map) midzy lat/lon a X/Y UTM, 1992, 2000
+Dla kadej komrki rastra wynikowego wyznaczane s wsprzdne odpowiadajcego jej punktu rastra
+rdowego, np. lat/lon rodka kadego piksela ortofotomapy w ukadzie 2000.
+
+Raster jest dzielony na kafle (warpTileSize x warpTileSize komrek) wykonywane przez pul wtkw.
+W kaflu dokadne wartoci s liczone funkcjami wsadowymi w wzach rzadkiej siatki kontrolnej
+(czworokty co warpLatticeStep komrek, w kadym 5 x 5 wzw), a czworokt jest wypeniany
+interpolacj dwukwadratow (9 wzw, rnice w przd wzdu wiersza), jeli w pozostaych 16 wzach
+odchylenie od wartoci dokadnych nie przekracza tolerancji; w przeciwnym razie jest dzielony
+na cztery czci.
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_Warp_H
+#define Unit_UTM_1992_2000_Warp_H
+
+#include <stddef.h>
+#include <math.h>
+#include <vector>
+#include "UTM_1992_2000_Bucketed.h"
+#include "UTM_1992_2000_Parallel.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Kierunek przeksztacenia: raster w X/Y, rdo w lat/lon (warpInverse) albo raster w lat/lon, rdo w X/Y (warpForward)
+enum WarpDirection { warpInverse, warpForward };
+
+//Rozmiar kafla i odstp wzw siatki kontrolnej [komrki]
+static const size_t warpTileSize = 256;
+static const size_t warpLatticeStep = 32;
+
+//Domylna tolerancja interpolacji [metry]
+static const double warpTolerance = 0.001;
+
+//Liczba wzw siatki kontrolnej kafla w jednym kierunku (granice czworoktw, wiartki i rodki)
+static const size_t warpLatticeNodes = 4 * ((warpTileSize + warpLatticeStep - 1) / warpLatticeStep) + 1;
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Struktury danych
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Definicja rastra wynikowego
+//=======================================================================
+//      Komrka (col, row) ma rodek w punkcie (x0 + col * dx, y0 + row * dy): easting, northing [metry]
+//      dla warpInverse, dugo, szeroko geograficzna [stopnie] dla warpForward (zwykle dy < 0).
+//      Wszystkie komrki s liczone w jednej strefie UTM (utmXZone, utmYZone) lub jednym pasie 2000
+//      (wyznaczonym dla rodka rastra), bez sprawdzania zakresu dugoci geograficznej.
+//=======================================================================
+struct WarpRaster
+{
+	double x0, y0;
+	double dx, dy;
+	size_t cols, rows;
+	int utmXZone;
+	char utmYZone;
+};
+
+//Dane wsplne kafli: odwzorowanie, strefa lub pas i tablice wynikw
+struct WarpJob
+{
+	const ProjectionContext* ctx;
+	WarpDirection dir;
+	const WarpRaster* r;
+	bool utm;
+	double olam, efe, strf, nfn;
+	double tolerance;
+	double* srcX;
+	double* srcY;
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Dokadne wartoci w n punktach rastra (x, y) -> (sx, sy)
+//=======================================================================
+void WarpExact (const WarpJob& j, BatchKernel kernel, const double* x, const double* y, double* sx, double* sy, size_t n)
+{
+	if(j.dir == warpForward) ForwardUniform (kernel, *j.ctx, j.utm, j.olam, j.efe, y, x, sx, sy, n);
+	else InverseUniform (kernel, *j.ctx, j.olam, j.strf, j.nfn, x, y, sy, sx, n);
+}
+
+//=======================================================================
+//  Wspczynniki wielomianu p(t) = A + B t + C t^2 przez punkty (0, v0), (t1, v1), (t2, v2)
+//  (dla powtrzonych wzw - wielomian liniowy lub stay)
+//=======================================================================
+void WarpQuadratic (double t1, double t2, double v0, double v1, double v2, double* coef)
+{
+	coef[0] = v0;
+	coef[1] = 0.0;
+	coef[2] = 0.0;
+	if(t2 == 0.0) return;
+	if(t1 == 0.0 || t1 == t2)
+	  {
+	   coef[1] = (v2 - v0) / t2;
+	   return;
+	  }
+	double f01 = (v1 - v0) / t1;
+	double f012 = ((v2 - v1) / (t2 - t1) - f01) / t2;
+	coef[1] = f01 - f012 * t1;
+	coef[2] = f012;
+}
+
+//=======================================================================
+//  Interpolacja dwukwadratowa: wspczynniki w kierunku y dla kolumn wzw 0, 2, 4 czworokta
+//=======================================================================
+//       const size_t* ys: wiersze wzw czworokta (5 wartoci)
+//       double v[5][5][2]: wartoci w wzach (v[wiersz][kolumna])
+//       double cy[3][2][3]: wspczynniki wielomianu w y dla kolumny, wsprzdnej
+//=======================================================================
+void WarpColumns (const size_t* ys, double v[5][5][2], double cy[3][2][3])
+{
+	double t1 = (double)(ys[2] - ys[0]);
+	double t2 = (double)(ys[4] - ys[0]);
+	for(int c = 0; c < 3; c++)
+	  {
+	   for(int k = 0; k < 2; k++) WarpQuadratic (t1, t2, v[0][2 * c][k], v[2][2 * c][k], v[4][2 * c][k], cy[c][k]);
+	  }
+}
+
+//Wspczynniki wielomianu w x dla wiersza pooonego o ty od pierwszego wiersza wzw
+void WarpRow (const size_t* xs, double cy[3][2][3], double ty, double cx[2][3])
+{
+	double t1 = (double)(xs[2] - xs[0]);
+	double t2 = (double)(xs[4] - xs[0]);
+	for(int k = 0; k < 2; k++)
+	  {
+	   double r[3];
+	   for(int c = 0; c < 3; c++) r[c] = cy[c][k][0] + ty * (cy[c][k][1] + ty * cy[c][k][2]);
+	   WarpQuadratic (t1, t2, r[0], r[1], r[2], cx[k]);
+	  }
+}
+
+//=======================================================================
+//  Odchylenie wartoci interpolowanej p od dokadnej exact [metry]
+//=======================================================================
+double WarpDeviation (const WarpJob& j, const double* p, const double* exact)
+{
+	double ex = fabs (p[0] - exact[0]);
+	double ey = fabs (p[1] - exact[1]);
+	if(j.dir == warpInverse)
+	  {
+	   // rdo w stopniach: przeliczenie na metry na powierzchni elipsoidy
+	   ex *= deg2rad * j.ctx->a * cos (exact[1] * deg2rad);
+	   ey *= deg2rad * j.ctx->a;
+	  }
+	return ex > ey ? ex : ey;
+}
+
+//=======================================================================
+//  Wypenienie komrek [xs[0], xs[4]) x [ys[0], ys[4]) interpolacj dwukwadratow wzw 0, 2, 4
+//=======================================================================
+//      Wzdu wiersza wielomian drugiego stopnia jest liczony rnicami w przd: dwa dodawania
+//      na komrk i wsprzdn.
+//=======================================================================
+void WarpFill (const WarpJob& j, const size_t* xs, const size_t* ys, double v[5][5][2])
+{
+	size_t cols = j.r->cols;
+	double cy[3][2][3];
+	WarpColumns (ys, v, cy);
+	for(size_t y = ys[0]; y < ys[4]; y++)
+	  {
+	   double cx[2][3];
+	   WarpRow (xs, cy, (double)(y - ys[0]), cx);
+	   double fx = cx[0][0], d1x = cx[0][1] + cx[0][2], d2x = 2.0 * cx[0][2];
+	   double fy = cx[1][0], d1y = cx[1][1] + cx[1][2], d2y = 2.0 * cx[1][2];
+	   double* px = j.srcX + y * cols;
+	   double* py = j.srcY + y * cols;
+	   for(size_t x = xs[0]; x < xs[4]; x++)
+	     {
+	      px[x] = fx;
+	      py[x] = fy;
+	      fx += d1x;
+	      fy += d1y;
+	      d1x += d2x;
+	      d1y += d2y;
+	     }
+	  }
+}
+
+//Wzy czworokta [a, b]: a, 1/4, 1/2, 3/4, b (w liczbach cakowitych)
+void WarpNodes (size_t a, size_t b, size_t* nodes)
+{
+	nodes[0] = a;
+	nodes[4] = b;
+	nodes[2] = (a + b) / 2;
+	nodes[1] = (a + nodes[2]) / 2;
+	nodes[3] = (nodes[2] + b) / 2;
+}
+
+//=======================================================================
+//  Wypenienie czworokta [xs[0], xs[4]) x [ys[0], ys[4]) z podziaem adaptacyjnym
+//=======================================================================
+//       const size_t* xs, const size_t* ys: wzy czworokta (WarpNodes)
+//       double v[5][5][2]: wartoci dokadne w wzach (v[wiersz][kolumna])
+//      Interpolacja uywa wzw parzystych, a 16 pozostaych suy do sprawdzenia odchylenia.
+//      Po podziale wzy parzyste czci pochodz z czworokta, a nowe wzy s liczone wsadowo.
+//=======================================================================
+void WarpQuad (const WarpJob& j, BatchKernel kernel, const size_t* xs, const size_t* ys, double v[5][5][2])
+{
+	double cy[3][2][3];
+	WarpColumns (ys, v, cy);
+	double err = 0.0;
+	for(int b = 0; b < 5 && err <= j.tolerance; b++)
+	  {
+	   double cx[2][3];
+	   WarpRow (xs, cy, (double)(ys[b] - ys[0]), cx);
+	   for(int a = (b % 2 == 0) ? 1 : 0; a < 5; a += (b % 2 == 0) ? 2 : 1)
+	     {
+	      double t = (double)(xs[a] - xs[0]);
+	      double p[2];
+	      for(int k = 0; k < 2; k++) p[k] = cx[k][0] + t * (cx[k][1] + t * cx[k][2]);
+	      double d = WarpDeviation (j, p, v[b][a]);
+	      if(!(d <= err)) err = d;
+	     }
+	  }
+	if(err <= j.tolerance || (xs[4] - xs[0] <= 1 && ys[4] - ys[0] <= 1))
+	  {
+	   WarpFill (j, xs, ys, v);
+	   return;
+	  }
+	// Podzia na cztery czci
+	size_t cxs[2][5], cys[2][5];
+	double c[2][2][5][5][2];
+	double x[64], y[64], sx[64], sy[64];
+	size_t n = 0;
+	for(int h = 0; h < 2; h++)
+	  {
+	   WarpNodes (xs[2 * h], xs[2 * h + 2], cxs[h]);
+	   WarpNodes (ys[2 * h], ys[2 * h + 2], cys[h]);
+	  }
+	for(int qy = 0; qy < 2; qy++)
+	  {
+	   for(int qx = 0; qx < 2; qx++)
+	     {
+	      for(int b = 0; b < 5; b++)
+	        {
+	         for(int a = 0; a < 5; a++)
+	           {
+	            if(a % 2 == 0 && b % 2 == 0)
+	              {
+	               c[qy][qx][b][a][0] = v[2 * qy + b / 2][2 * qx + a / 2][0];
+	               c[qy][qx][b][a][1] = v[2 * qy + b / 2][2 * qx + a / 2][1];
+	               continue;
+	              }
+	            x[n] = j.r->x0 + cxs[qx][a] * j.r->dx;
+	            y[n] = j.r->y0 + cys[qy][b] * j.r->dy;
+	            n++;
+	           }
+	        }
+	     }
+	  }
+	WarpExact (j, kernel, x, y, sx, sy, n);
+	n = 0;
+	for(int qy = 0; qy < 2; qy++)
+	  {
+	   for(int qx = 0; qx < 2; qx++)
+	     {
+	      for(int b = 0; b < 5; b++)
+	        {
+	         for(int a = 0; a < 5; a++)
+	           {
+	            if(a % 2 == 0 && b % 2 == 0) continue;
+	            c[qy][qx][b][a][0] = sx[n];
+	            c[qy][qx][b][a][1] = sy[n];
+	            n++;
+	           }
+	        }
+	      if(cxs[qx][4] > cxs[qx][0] && cys[qy][4] > cys[qy][0]) WarpQuad (j, kernel, cxs[qx], cys[qy], c[qy][qx]);
+	     }
+	  }
+}
+
+//Wzy siatki kontrolnej kafla [t0, t1): wzy WarpNodes czworoktw co warpLatticeStep; wynik: liczba wzw
+size_t WarpLattice (size_t t0, size_t t1, size_t* nodes)
+{
+	size_t n = 0;
+	for(size_t a = t0; a < t1; a += warpLatticeStep)
+	  {
+	   WarpNodes (a, a + warpLatticeStep < t1 ? a + warpLatticeStep : t1, nodes + n);
+	   n += 4;
+	  }
+	nodes[n++] = t1;
+	return n;
+}
+
+//=======================================================================
+//  Wypenienie kafla rastra o naroniku (tx0, ty0)
+//=======================================================================
+void WarpTile (const WarpJob& j, BatchKernel kernel, size_t tx0, size_t ty0)
+{
+	const WarpRaster& r = *j.r;
+	size_t tx1 = tx0 + warpTileSize < r.cols ? tx0 + warpTileSize : r.cols;
+	size_t ty1 = ty0 + warpTileSize < r.rows ? ty0 + warpTileSize : r.rows;
+	size_t xs[warpLatticeNodes], ys[warpLatticeNodes];
+	size_t nx = WarpLattice (tx0, tx1, xs);
+	size_t ny = WarpLattice (ty0, ty1, ys);
+	// Wzy na prawym i dolnym brzegu (tx1, ty1) nale do nastpnego kafla lub le tu za rastrem
+	std::vector<double> buf (4 * nx * ny);
+	double* x = &buf[0];
+	double* y = x + nx * ny;
+	double* sx = y + nx * ny;
+	double* sy = sx + nx * ny;
+	for(size_t b = 0; b < ny; b++)
+	  {
+	   for(size_t a = 0; a < nx; a++)
+	     {
+	      x[b * nx + a] = r.x0 + xs[a] * r.dx;
+	      y[b * nx + a] = r.y0 + ys[b] * r.dy;
+	     }
+	  }
+	WarpExact (j, kernel, x, y, sx, sy, nx * ny);
+	for(size_t qy = 0; qy + 4 < ny; qy += 4)
+	  {
+	   for(size_t qx = 0; qx + 4 < nx; qx += 4)
+	     {
+	      double v[5][5][2];
+	      for(int b = 0; b < 5; b++)
+	        {
+	         for(int a = 0; a < 5; a++)
+	           {
+	            v[b][a][0] = sx[(qy + b) * nx + qx + a];
+	            v[b][a][1] = sy[(qy + b) * nx + qx + a];
+	           }
+	        }
+	      WarpQuad (j, kernel, xs + qx, ys + qy, v);
+	     }
+	  }
+}
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Funkcja wyznacza map przeksztacenia rastra: wsprzdne rdowe kadej komrki
+//=======================================================================
+//       const ProjectionContext& ctx: kontekst odwzorowania UTM, 1992 lub 2000
+//       WarpDirection dir: warpInverse - raster w X/Y, wynik lat/lon; warpForward - raster w lat/lon, wynik X/Y
+//       const WarpRaster& r: definicja rastra wynikowego
+//       double* srcX, double* srcY: wyniki (r.rows * r.cols elementw, wierszami): dugo, szeroko
+//                                   geograficzna [stopnie] dla warpInverse, easting, northing [metry] dla warpForward
+//       double tolerance: najwiksze odchylenie interpolacji od wartoci dokadnych w punktach kontrolnych [metry]
+//       ConversionPool* pool: pula wtkw lub 0 (kafle liczone w wtku wywoujcym)
+//       BatchKernel kernel: wersja jdra obliczeniowego wzw siatki kontrolnej
+//      Wynik: false dla bdnych argumentw (pusty raster, brak strefy UTM).
+//=======================================================================
+bool BuildWarpMap (const ProjectionContext& ctx, WarpDirection dir, const WarpRaster& r, double* srcX, double* srcY, double tolerance = warpTolerance, ConversionPool* pool = 0, BatchKernel kernel = kernelAuto)
+{
+	if(r.cols == 0 || r.rows == 0 || !(tolerance > 0.0)) return false;
+	UTM_STATS_CALL (statsBuildWarpMap, r.rows * r.cols);
+	WarpJob j;
+	j.ctx = &ctx;
+	j.dir = dir;
+	j.r = &r;
+	j.utm = ctx.proj == projUTM;
+	j.tolerance = tolerance;
+	j.srcX = srcX;
+	j.srcY = srcY;
+	j.strf = 0.0;
+	j.nfn = ctx.nfn;
+	if(j.utm)
+	  {
+	   if(r.utmXZone < 1 || r.utmXZone > 60) return false;
+	   j.olam = UtmCentralMeridian (r.utmXZone);
+	   bool south = (r.utmYZone <= 'M' && r.utmYZone >= 'C') || (r.utmYZone <= 'm' && r.utmYZone >= 'c');
+	   if(!south) j.nfn = 0.0;
+	  }
+	  else
+	  {
+	   int strip = 0;
+	   double xc = r.x0 + 0.5 * (r.cols - 1) * r.dx;
+	   if(ctx.proj == projPUWG2000) strip = dir == warpForward ? PUWGStripFromLon (xc) : PUWGStripFromEasting (xc);
+	   j.olam = ctx.olam[strip];
+	   j.strf = ctx.strf[strip];
+	  }
+	j.efe = ctx.fe + j.strf;
+	kernel = ResolveBatchKernel (kernel);
+	size_t tilesX = (r.cols + warpTileSize - 1) / warpTileSize;
+	size_t tilesY = (r.rows + warpTileSize - 1) / warpTileSize;
+	std::function<void (size_t, size_t)> fn = [&] (size_t b, size_t e)
+	  {
+	   for(size_t t = b; t < e; t++) WarpTile (j, kernel, (t % tilesX) * warpTileSize, (t / tilesX) * warpTileSize);
+	  };
+	if(pool) pool->Run (tilesX * tilesY, 1, fn);
+	else fn (0, tilesX * tilesY);
+	return true;
+}
+
+#endif
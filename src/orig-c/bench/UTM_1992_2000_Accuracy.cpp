@@ -0,0 +1,163 @@
+/*
+Badanie dokadnoci konwersji UTM, 1992, 2000 (WGS 84)
+
+Dla kadego odwzorowania, zbioru punktw i wersji oblicze program podaje bd maksymalny i redni
+kwadratowy [metry]:
+  fwd-ref  - odchylenie X/Y od odwzorowania wzorcowego (szereg Krgera rzdu n^6 w long double)
+  inv-ref  - odchylenie lat/lon wyznaczonych z wzorcowych X/Y od punktw wyjciowych
+  round    - bd konwersji tam i z powrotem (lat/lon -> X/Y -> lat/lon)
+
+Kompilacja (z katalogu src/orig-c/bench):
+  g++ -std=c++11 -O2 -pthread UTM_1992_2000_Accuracy.cpp -o utm_accuracy
+
+Uycie:
+  utm_accuracy [liczba punktw] [--limit metry]
+  Z opcj --limit program koczy si kodem 1, jeli ktrykolwiek bd maksymalny (fwd-ref, inv-ref, round)
+  przekracza podan warto - do wykrywania regresji dokadnoci. Dla poziomw precTruncated i precFloat
+  do wartoci dodawany jest dopuszczalny bd poziomu (3 x truncTolerance, floatTolerance).
+*/
+//---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "UTM_1992_2000_BenchPoints.h"
+#include "../UTM_1992_2000_Batch.h"
+
+//Bd maksymalny i redni kwadratowy
+struct ErrorStats
+{
+	double max;
+	double sum2;
+	size_t count;
+	ErrorStats () : max (0.0), sum2 (0.0), count (0) {}
+	void Add (double d)
+	{
+	 if(!(d <= max)) max = d;
+	 sum2 += d * d;
+	 count++;
+	}
+	double Rms () const { return count ? sqrt (sum2 / count) : 0.0; }
+};
+
+//Wersja oblicze: metoda i poziom dokadnoci kontekstu oraz jdro konwersji wsadowej
+struct AccuracyPath
+{
+	const char* name;
+	ProjectionEngine engine;
+	BatchKernel kernel;
+	ProjectionPrecision precision;
+};
+
+//Dopuszczalny bd poziomu dokadnoci ponad bd penego szeregu [metry]
+double PrecisionAllowance (ProjectionType proj, ProjectionPrecision precision)
+{
+	if(precision == precTruncated) return 3.0 * truncTolerance;
+	if(precision == precFloat) return floatTolerance[proj];
+	return 0.0;
+}
+
+//=======================================================================
+//  Pomiar bdw dla jednego odwzorowania, zbioru punktw i wersji oblicze
+//=======================================================================
+void MeasureAccuracy (ProjectionType proj, PointSet set, const AccuracyPath& path, size_t count, ErrorStats& fwd, ErrorStats& inv, ErrorStats& round)
+{
+	const ProjectionContext& ctx = WGS84Context (proj, path.engine, path.precision);
+	std::vector<double> lat, lon;
+	GeneratePoints (set, proj, count, lat, lon);
+	std::vector<double> e (count), n (count), re (count), rn (count), la (count), lo (count);
+	std::vector<int> zone (count);
+	std::vector<char> band (count);
+	if(proj == projUTM)
+	  {
+	   LatLonToUtmBatch (ctx, &zone[0], &band[0], &e[0], &n[0], &lat[0], &lon[0], count, 0, path.kernel);
+	  }
+	  else
+	  {
+	   LatLonToPUWGBatch (ctx, &e[0], &n[0], &lat[0], &lon[0], count, 0, path.kernel);
+	  }
+	// Wartoci wzorcowe
+	for(size_t i = 0; i < count; i++)
+	  {
+	   double x, y, cm, efe, nfn;
+	   if(proj == projUTM)
+	     {
+	      cm = zone[i] * 6.0 - 183.0;
+	      efe = ctx.fe;
+	      nfn = lat[i] < 0.0 ? ctx.nfn : 0.0;
+	     }
+	     else
+	     {
+	      int strip = proj == projPUWG2000 ? PUWGStripFromLon (lon[i]) : 0;
+	      cm = ctx.olam[strip] * rad2deg;
+	      efe = ctx.fe + ctx.strf[strip];
+	      nfn = ctx.nfn;
+	     }
+	   ReferenceForward (ctx.a, ctx.f, ctx.ok, lat[i], lon[i] - cm, x, y);
+	   re[i] = efe + x;
+	   rn[i] = nfn + y;
+	   fwd.Add (sqrt ((e[i] - re[i]) * (e[i] - re[i]) + (n[i] - rn[i]) * (n[i] - rn[i])));
+	  }
+	// Konwersja odwrotna wartoci wzorcowych
+	if(proj == projUTM) UtmToLatLonBatch (ctx, &zone[0], &band[0], &re[0], &rn[0], &la[0], &lo[0], count, path.kernel);
+	else PUWGToLatLonBatch (ctx, &re[0], &rn[0], &la[0], &lo[0], count, path.kernel);
+	for(size_t i = 0; i < count; i++) inv.Add (GroundDistance (lat[i], lon[i], la[i], lo[i]));
+	// Tam i z powrotem
+	if(proj == projUTM) UtmToLatLonBatch (ctx, &zone[0], &band[0], &e[0], &n[0], &la[0], &lo[0], count, path.kernel);
+	else PUWGToLatLonBatch (ctx, &e[0], &n[0], &la[0], &lo[0], count, path.kernel);
+	for(size_t i = 0; i < count; i++) round.Add (GroundDistance (lat[i], lon[i], la[i], lo[i]));
+}
+
+int main (int argc, char** argv)
+{
+	size_t count = 200000;
+	double limit = -1.0;
+	for(int i = 1; i < argc; i++)
+	  {
+	   if(!strcmp (argv[i], "--limit") && i + 1 < argc) limit = atof (argv[++i]);
+	   else count = (size_t)atol (argv[i]);
+	  }
+	if(count == 0) count = 1;
+	BatchKernel best = ResolveBatchKernel (kernelAuto);
+	const char* bestName = best == kernelAvx512 ? "avx512" : best == kernelAvx2 ? "avx2" : "scalar";
+	AccuracyPath paths[] =
+	  {
+	   { "classic/scalar", engineClassic, kernelScalar, precFull },
+	   { "classic/batch", engineClassic, best, precFull },
+	   { "kruger/scalar", engineKruger, kernelScalar, precFull },
+	   { "kruger/batch", engineKruger, best, precFull },
+	   { "truncated/scalar", engineKruger, kernelScalar, precTruncated },
+	   { "truncated/batch", engineKruger, best, precTruncated },
+	   { "float/scalar", engineKruger, kernelScalar, precFloat },
+	   { "float/batch", engineKruger, best, precFloat }
+	  };
+	static const int pathCount = sizeof (paths) / sizeof (paths[0]);
+	static const ProjectionType projs[] = { projUTM, projPUWG1992, projPUWG2000 };
+	static const char* projNames[] = { "utm", "1992", "2000" };
+	static const PointSet sets[] = { setPoland, setGlobal, setZoneEdge };
+	printf ("points per set: %lu, batch kernel: %s\n", (unsigned long)count, bestName);
+	printf ("%-5s %-10s %-16s %11s %11s %11s %11s %11s %11s\n", "proj", "set", "path",
+		"fwd-ref max", "fwd-ref rms", "inv-ref max", "inv-ref rms", "round max", "round rms");
+	bool failed = false;
+	for(int p = 0; p < 3; p++)
+	  {
+	   for(int s = 0; s < 3; s++)
+	     {
+	      for(int k = 0; k < pathCount; k++)
+	        {
+	         ErrorStats fwd, inv, round;
+	         MeasureAccuracy (projs[p], sets[s], paths[k], count, fwd, inv, round);
+	         printf ("%-5s %-10s %-16s %11.3e %11.3e %11.3e %11.3e %11.3e %11.3e\n", projNames[p], PointSetName (sets[s]), paths[k].name,
+	                 fwd.max, fwd.Rms (), inv.max, inv.Rms (), round.max, round.Rms ());
+	         double allowed = limit + PrecisionAllowance (projs[p], paths[k].precision);
+	         if(limit >= 0.0 && !(fwd.max <= allowed && inv.max <= allowed && round.max <= allowed)) failed = true;
+	        }
+	     }
+	  }
+	if(failed)
+	  {
+	   printf ("accuracy limit %g m exceeded\n", limit);
+	   return 1;
+	  }
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*
+Pomiar wydajnoci konwersji UTM, 1992, 2000 (WGS 84)
+
+Dla kadego odwzorowania i zbioru punktw program mierzy czas konwersji lat/lon -> X/Y (fwd)
+i X/Y -> lat/lon (inv) w wersjach:
+  wgs84          - funkcje LatLonToUtmWGS84, LatLonToPUWGWGS84, UtmToLatLonWGS84, PUWGToLatLonWGS84
+  static         - funkcje wyspecjalizowane w czasie kompilacji (UTM_1992_2000_Static.h)
+  kruger         - funkcje z kontekstem engineKruger
+  batch-<jdro>  - konwersje wsadowe dla kadego dostpnego jdra (scalar, avx2, avx512)
+  batch-kruger   - konwersje wsadowe engineKruger, najszybsze jdro
+  batch-trunc    - jak batch-kruger, poziom dokadnoci precTruncated
+  batch-float    - jak batch-kruger, poziom dokadnoci precFloat
+  parallel       - konwersje wielowtkowe engineKruger, najszybsze jdro, wszystkie rdzenie
+Wynik: ns na punkt i miliony punktw na sekund (najlepszy z kilku przebiegw).
+
+Kompilacja (z katalogu src/orig-c/bench):
+  g++ -std=c++11 -O2 -pthread UTM_1992_2000_Bench.cpp -o utm_bench
+
+Uycie:
+  utm_bench [liczba punktw] [liczba przebiegw]
+*/
+//---------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <functional>
+#include "UTM_1992_2000_BenchPoints.h"
+#include "../UTM_1992_2000_Batch.h"
+#include "../UTM_1992_2000_Parallel.h"
+#include "../UTM_1992_2000_Static.h"
+
+//Dane jednego pomiaru: punkty wejciowe i bufory wynikw
+struct BenchData
+{
+	ProjectionType proj;
+	size_t count;
+	std::vector<double> lat, lon, e, n, la, lo;
+	std::vector<int> zone;
+	std::vector<char> band;
+};
+
+//Najkrtszy czas [ns na punkt] z runs przebiegw funkcji fn
+double TimeRuns (size_t count, int runs, const std::function<void ()>& fn)
+{
+	double best = 1e300;
+	for(int r = 0; r < runs; r++)
+	  {
+	   std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now ();
+	   fn ();
+	   std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now ();
+	   double ns = std::chrono::duration<double, std::nano> (t1 - t0).count () / count;
+	   if(ns < best) best = ns;
+	  }
+	return best;
+}
+
+void Report (const char* proj, PointSet set, const char* dir, const char* path, double ns)
+{
+	printf ("%-5s %-10s %-4s %-15s %9.2f %9.2f\n", proj, PointSetName (set), dir, path, ns, 1000.0 / ns);
+}
+
+//=======================================================================
+//  Konwersja lat/lon -> X/Y dla danych d wybran wersj oblicze
+//=======================================================================
+void Forward (BenchData& d, const ProjectionContext& ctx, BatchKernel kernel)
+{
+	if(d.proj == projUTM) LatLonToUtmBatch (ctx, &d.zone[0], &d.band[0], &d.e[0], &d.n[0], &d.lat[0], &d.lon[0], d.count, 0, kernel);
+	else LatLonToPUWGBatch (ctx, &d.e[0], &d.n[0], &d.lat[0], &d.lon[0], d.count, 0, kernel);
+}
+
+void Inverse (BenchData& d, const ProjectionContext& ctx, BatchKernel kernel)
+{
+	if(d.proj == projUTM) UtmToLatLonBatch (ctx, &d.zone[0], &d.band[0], &d.e[0], &d.n[0], &d.la[0], &d.lo[0], d.count, kernel);
+	else PUWGToLatLonBatch (ctx, &d.e[0], &d.n[0], &d.la[0], &d.lo[0], d.count, kernel);
+}
+
+//Wersje wyspecjalizowane w czasie kompilacji
+template <class Projection>
+void ForwardStatic (BenchData& d)
+{
+	for(size_t i = 0; i < d.count; i++) LatLonToPUWG<EllipsoidWGS84, Projection> (d.e[i], d.n[i], d.lat[i], d.lon[i]);
+}
+
+template <class Projection>
+void InverseStatic (BenchData& d)
+{
+	for(size_t i = 0; i < d.count; i++) PUWGToLatLon<EllipsoidWGS84, Projection> (d.e[i], d.n[i], d.la[i], d.lo[i]);
+}
+
+int main (int argc, char** argv)
+{
+	size_t count = argc > 1 ? (size_t)atol (argv[1]) : 1000000;
+	int runs = argc > 2 ? atoi (argv[2]) : 3;
+	if(count == 0) count = 1;
+	if(runs < 1) runs = 1;
+	ConversionPool pool;
+	BatchKernel best = ResolveBatchKernel (kernelAuto);
+	static const BatchKernel kernels[] = { kernelScalar, kernelAvx2, kernelAvx512 };
+	static const char* kernelNames[] = { "batch-scalar", "batch-avx2", "batch-avx512" };
+	static const ProjectionType projs[] = { projUTM, projPUWG1992, projPUWG2000 };
+	static const char* projNames[] = { "utm", "1992", "2000" };
+	static const PointSet sets[] = { setPoland, setGlobal, setZoneEdge };
+	printf ("points: %lu, runs: %d, threads: %u\n", (unsigned long)count, runs, pool.Threads ());
+	printf ("%-5s %-10s %-4s %-15s %9s %9s\n", "proj", "set", "dir", "path", "ns/pt", "Mpts/s");
+	for(int p = 0; p < 3; p++)
+	  {
+	   for(int s = 0; s < 3; s++)
+	     {
+	      BenchData d;
+	      d.proj = projs[p];
+	      d.count = count;
+	      GeneratePoints (sets[s], d.proj, count, d.lat, d.lon);
+	      d.e.resize (count);
+	      d.n.resize (count);
+	      d.la.resize (count);
+	      d.lo.resize (count);
+	      d.zone.resize (count);
+	      d.band.resize (count);
+	      const ProjectionContext& classic = WGS84Context (d.proj);
+	      const ProjectionContext& kruger = WGS84Context (d.proj, engineKruger);
+	      const ProjectionContext& truncated = WGS84Context (d.proj, engineKruger, precTruncated);
+	      const ProjectionContext& single = WGS84Context (d.proj, engineKruger, precFloat);
+	      int puwg = d.proj == projPUWG1992 ? 1 : 2;
+	      double ns;
+	      // Funkcje WGS 84 - punkt po punkcie
+	      ns = TimeRuns (count, runs, [&] ()
+	        {
+	         if(d.proj == projUTM) for(size_t i = 0; i < count; i++) LatLonToUtmWGS84 (d.zone[i], d.band[i], d.e[i], d.n[i], d.lat[i], d.lon[i]);
+	         else for(size_t i = 0; i < count; i++) LatLonToPUWGWGS84 (d.e[i], d.n[i], d.lat[i], d.lon[i], puwg);
+	        });
+	      Report (projNames[p], sets[s], "fwd", "wgs84", ns);
+	      ns = TimeRuns (count, runs, [&] ()
+	        {
+	         if(d.proj == projUTM) for(size_t i = 0; i < count; i++) UtmToLatLonWGS84 (d.zone[i], d.band[i], d.e[i], d.n[i], d.la[i], d.lo[i]);
+	         else for(size_t i = 0; i < count; i++) PUWGToLatLonWGS84 (d.e[i], d.n[i], puwg, d.la[i], d.lo[i]);
+	        });
+	      Report (projNames[p], sets[s], "inv", "wgs84", ns);
+	      // Funkcje wyspecjalizowane w czasie kompilacji
+	      ns = TimeRuns (count, runs, [&] ()
+	        {
+	         if(d.proj == projUTM) for(size_t i = 0; i < count; i++) LatLonToUtm<EllipsoidWGS84> (d.zone[i], d.band[i], d.e[i], d.n[i], d.lat[i], d.lon[i]);
+	         else if(d.proj == projPUWG1992) ForwardStatic<ProjPUWG1992> (d);
+	         else ForwardStatic<ProjPUWG2000> (d);
+	        });
+	      Report (projNames[p], sets[s], "fwd", "static", ns);
+	      ns = TimeRuns (count, runs, [&] ()
+	        {
+	         if(d.proj == projUTM) for(size_t i = 0; i < count; i++) UtmToLatLon<EllipsoidWGS84> (d.zone[i], d.band[i], d.e[i], d.n[i], d.la[i], d.lo[i]);
+	         else if(d.proj == projPUWG1992) InverseStatic<ProjPUWG1992> (d);
+	         else InverseStatic<ProjPUWG2000> (d);
+	        });
+	      Report (projNames[p], sets[s], "inv", "static", ns);
+	      // Metoda Krgera - punkt po punkcie
+	      ns = TimeRuns (count, runs, [&] () { Forward (d, kruger, kernelScalar); });
+	      Report (projNames[p], sets[s], "fwd", "kruger", ns);
+	      ns = TimeRuns (count, runs, [&] () { Inverse (d, kruger, kernelScalar); });
+	      Report (projNames[p], sets[s], "inv", "kruger", ns);
+	      // Konwersje wsadowe - kade dostpne jdro
+	      for(int k = 0; k < 3; k++)
+	        {
+	         if(ResolveBatchKernel (kernels[k]) != kernels[k]) continue;
+	         ns = TimeRuns (count, runs, [&] () { Forward (d, classic, kernels[k]); });
+	         Report (projNames[p], sets[s], "fwd", kernelNames[k], ns);
+	         ns = TimeRuns (count, runs, [&] () { Inverse (d, classic, kernels[k]); });
+	         Report (projNames[p], sets[s], "inv", kernelNames[k], ns);
+	        }
+	      ns = TimeRuns (count, runs, [&] () { Forward (d, kruger, best); });
+	      Report (projNames[p], sets[s], "fwd", "batch-kruger", ns);
+	      ns = TimeRuns (count, runs, [&] () { Inverse (d, kruger, best); });
+	      Report (projNames[p], sets[s], "inv", "batch-kruger", ns);
+	      // Poziomy dokadnoci
+	      ns = TimeRuns (count, runs, [&] () { Forward (d, truncated, best); });
+	      Report (projNames[p], sets[s], "fwd", "batch-trunc", ns);
+	      ns = TimeRuns (count, runs, [&] () { Inverse (d, truncated, best); });
+	      Report (projNames[p], sets[s], "inv", "batch-trunc", ns);
+	      ns = TimeRuns (count, runs, [&] () { Forward (d, single, best); });
+	      Report (projNames[p], sets[s], "fwd", "batch-float", ns);
+	      ns = TimeRuns (count, runs, [&] () { Inverse (d, single, best); });
+	      Report (projNames[p], sets[s], "inv", "batch-float", ns);
+	      // Konwersje wielowtkowe
+	      ns = TimeRuns (count, runs, [&] ()
+	        {
+	         if(d.proj == projUTM) LatLonToUtmParallel (pool, kruger, &d.zone[0], &d.band[0], &d.e[0], &d.n[0], &d.lat[0], &d.lon[0], count, 0, 0, best);
+	         else LatLonToPUWGParallel (pool, kruger, &d.e[0], &d.n[0], &d.lat[0], &d.lon[0], count, 0, 0, best);
+	        });
+	      Report (projNames[p], sets[s], "fwd", "parallel", ns);
+	      ns = TimeRuns (count, runs, [&] ()
+	        {
+	         if(d.proj == projUTM) UtmToLatLonParallel (pool, kruger, &d.zone[0], &d.band[0], &d.e[0], &d.n[0], &d.la[0], &d.lo[0], count, 0, best);
+	         else PUWGToLatLonParallel (pool, kruger, &d.e[0], &d.n[0], &d.la[0], &d.lo[0], count, 0, best);
+	        });
+	      Report (projNames[p], sets[s], "inv", "parallel", ns);
+	     }
+	  }
+	return 0;
+}
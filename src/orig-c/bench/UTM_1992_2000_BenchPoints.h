@@ -0,0 +1,173 @@
+/*
+Wsplne elementy programw pomiarowych: zbiory punktw testowych i odwzorowanie wzorcowe
+*/
+//---------------------------------------------------------------------------
+#ifndef Unit_UTM_1992_2000_BenchPoints_H
+#define Unit_UTM_1992_2000_BenchPoints_H
+
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const double deg2rad = M_PI / 180.0;
+static const double rad2deg = 180.0 / M_PI;
+
+#include "../UTM_1992_2000.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Zbiory punktw testowych
+////////////////////////////////////////////////////////////////////////////////
+//  setPoland   - obszar Polski (lat 49.0 - 54.9, lon 14.1 - 24.2)
+//  setGlobal   - cay obszar UTM (lat -80 - 84, lon -180 - 180); dla 1992 i 2000 pas lon 13.5 - 25.5, lat 49 - 55
+//  setZoneEdge - punkty w odlegoci do 0.05 stopnia od granic stref UTM / pasw 2000, a dla 1992
+//                skraje obszaru odwzorowania (najdalej od poudnika osiowego)
+////////////////////////////////////////////////////////////////////////////////
+enum PointSet { setPoland, setGlobal, setZoneEdge };
+
+static const char* PointSetName (PointSet set)
+{
+	if(set == setPoland) return "poland";
+	if(set == setGlobal) return "global";
+	return "zone-edge";
+}
+
+//Generator liczb pseudolosowych (xorshift64*) - zbiory punktw s powtarzalne na kadej platformie
+struct PointRng
+{
+	uint64_t s;
+	explicit PointRng (uint64_t seed) : s (seed ? seed : 1) {}
+	double Next ()
+	{
+	 s ^= s >> 12;
+	 s ^= s << 25;
+	 s ^= s >> 27;
+	 return (double)((s * 2685821657736338717ULL) >> 11) / 9007199254740992.0;
+	}
+	double Range (double lo, double hi) { return lo + (hi - lo) * Next (); }
+};
+
+//=======================================================================
+//  Funkcja generuje count punktw lat/lon [stopnie] ze zbioru set dla odwzorowania proj
+//=======================================================================
+void GeneratePoints (PointSet set, ProjectionType proj, size_t count, std::vector<double>& lat, std::vector<double>& lon, uint64_t seed = 2014)
+{
+	PointRng rng (seed);
+	lat.resize (count);
+	lon.resize (count);
+	for(size_t i = 0; i < count; i++)
+	  {
+	   if(set == setPoland)
+	     {
+	      lat[i] = rng.Range (49.0, 54.9);
+	      lon[i] = rng.Range (14.1, 24.2);
+	     }
+	     else if(set == setGlobal)
+	     {
+	      if(proj == projUTM)
+	        {
+	         lat[i] = rng.Range (-80.0, 84.0);
+	         lon[i] = rng.Range (-180.0, 180.0);
+	        }
+	        else
+	        {
+	         lat[i] = rng.Range (49.0, 55.0);
+	         lon[i] = rng.Range (13.5, 25.5);
+	        }
+	     }
+	     else
+	     {
+	      double d = rng.Range (0.0, 0.05);
+	      bool east = rng.Next () < 0.5;
+	      if(proj == projUTM)
+	        {
+	         // Granica stref: -180 + 6k, punkt po wschodniej lub zachodniej stronie
+	         double edge = -180.0 + 6.0 * (int)rng.Range (0.0, 60.0);
+	         lat[i] = rng.Range (-80.0, 84.0);
+	         lon[i] = east ? edge + d : edge + 6.0 - d;
+	        }
+	        else if(proj == projPUWG2000)
+	        {
+	         static const double edges[] = { 13.5, 16.5, 19.5, 22.5, 25.5 };
+	         int k = (int)rng.Range (0.0, 5.0);
+	         lat[i] = rng.Range (49.0, 55.0);
+	         lon[i] = edges[k] + (east ? d : -d);
+	         if(lon[i] < 13.5) lon[i] = 13.5 + d;
+	         if(lon[i] > 25.5) lon[i] = 25.5 - d;
+	        }
+	        else
+	        {
+	         lat[i] = rng.Range (49.0, 55.0);
+	         lon[i] = east ? 24.2 - d : 14.1 + d;
+	        }
+	     }
+	  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//Odwzorowanie wzorcowe
+////////////////////////////////////////////////////////////////////////////////
+
+//=======================================================================
+//  Odwzorowanie Gaussa-Krgera wg. szeregu Krgera rzdu n^6 (C. F. F. Karney, Transverse Mercator
+//  with an accuracy of a few nanometers, J. Geodesy 85, 2011), liczone w long double.
+//  Bd szeregu jest rzdu nanometrw do 4000 km od poudnika osiowego, wic wynik
+//  suy jako warto wzorcowa dla badanych funkcji.
+//=======================================================================
+//       double a, double f: elipsoida
+//       double ok: wspczynnik skali w poudniku osiowym
+//       double lat, double dlon: szeroko i rnica dugoci wzgldem poudnika osiowego [stopnie]
+//       double& x: odlego od poudnika osiowego (bez faszywego wschodu) [metry]
+//       double& y: odlego od rwnika (bez faszywej pnocy) [metry]
+//=======================================================================
+void ReferenceForward (double a, double f, double ok, double lat, double dlon, double& x, double& y)
+{
+	typedef long double ld;
+	const ld pi = 3.141592653589793238462643383279502884L;
+	ld n = (ld)f / (2.0L - (ld)f);
+	ld e = sqrtl ((ld)f * (2.0L - (ld)f));
+	ld n2 = n * n, n3 = n2 * n, n4 = n3 * n, n5 = n4 * n, n6 = n5 * n;
+	ld A = (ld)a / (1.0L + n) * (1.0L + n2 / 4.0L + n4 / 64.0L + n6 / 256.0L);
+	ld alpha[6] =
+	  {
+	   n / 2.0L - 2.0L * n2 / 3.0L + 5.0L * n3 / 16.0L + 41.0L * n4 / 180.0L - 127.0L * n5 / 288.0L + 7891.0L * n6 / 37800.0L,
+	   13.0L * n2 / 48.0L - 3.0L * n3 / 5.0L + 557.0L * n4 / 1440.0L + 281.0L * n5 / 630.0L - 1983433.0L * n6 / 1935360.0L,
+	   61.0L * n3 / 240.0L - 103.0L * n4 / 140.0L + 15061.0L * n5 / 26880.0L + 167603.0L * n6 / 181440.0L,
+	   49561.0L * n4 / 161280.0L - 179.0L * n5 / 168.0L + 6601661.0L * n6 / 7257600.0L,
+	   34729.0L * n5 / 80640.0L - 3418889.0L * n6 / 1995840.0L,
+	   212378941.0L * n6 / 319334400.0L
+	  };
+	ld phi = (ld)lat * pi / 180.0L;
+	ld lam = (ld)dlon * pi / 180.0L;
+	// Szeroko konforemna: tan chi = tau'
+	ld tau = tanl (phi);
+	ld sigma = sinhl (e * atanhl (e * tau / sqrtl (1.0L + tau * tau)));
+	ld taup = tau * sqrtl (1.0L + sigma * sigma) - sigma * sqrtl (1.0L + tau * tau);
+	ld xip = atan2l (taup, cosl (lam));
+	ld etap = asinhl (sinl (lam) / sqrtl (taup * taup + cosl (lam) * cosl (lam)));
+	ld xi = xip;
+	ld eta = etap;
+	for(int j = 1; j <= 6; j++)
+	  {
+	   xi += alpha[j - 1] * sinl (2.0L * j * xip) * coshl (2.0L * j * etap);
+	   eta += alpha[j - 1] * cosl (2.0L * j * xip) * sinhl (2.0L * j * etap);
+	  }
+	x = (double)((ld)ok * A * eta);
+	y = (double)((ld)ok * A * xi);
+}
+
+//Odlego [metry] midzy dwoma punktami lat/lon [stopnie] - przyblienie lokalne, wystarczajce dla maych rnic
+double GroundDistance (double lat1, double lon1, double lat2, double lon2)
+{
+	double dy = (lat2 - lat1) * deg2rad * 6367449.0;
+	double dl = lon2 - lon1;
+	if(dl > 180.0) dl -= 360.0;
+	if(dl < -180.0) dl += 360.0;
+	double dx = dl * deg2rad * 6378137.0 * cos (lat1 * deg2rad);
+	return sqrt (dx * dx + dy * dy);
+}
+
+#endif
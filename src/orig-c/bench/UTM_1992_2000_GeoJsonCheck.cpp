@@ -0,0 +1,92 @@
+/*
+Sprawdzenie zapisu wsprzdnych GeoJSON dla wartoci skrajnych
+
+Program przelicza krtkie dokumenty GeoJSON z liczbami bardzo duymi, nieskoczonymi (1e400 - JSON
+nie ma zapisu NaN ani nieskoczonoci, strtod zwraca inf) i dajcymi NaN po przeliczeniu, i porwnuje
+wynik z oczekiwanym tekstem. Liczby poza zakresem zapisu staoprzecinkowego musz mieci si
+w geoJsonNumberSize znakach, NaN i nieskoczono s zapisywane jako null.
+
+Kompilacja (z katalogu src/orig-c/bench; sprawdzenie dostpu do pamici - z -fsanitize=address):
+  g++ -std=c++11 -O2 UTM_1992_2000_GeoJsonCheck.cpp -o utm_geojson_check
+
+Uycie:
+  utm_geojson_check
+  Program koczy si kodem 1, jeli ktrykolwiek wynik rni si od oczekiwanego.
+*/
+//---------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const double deg2rad = M_PI / 180.0;
+static const double rad2deg = 180.0 / M_PI;
+
+#include "../UTM_1992_2000_Geometry.h"
+
+//Przypadek: ukad docelowy (z WGS 84), dokument i oczekiwany wynik (0 - sprawdzany tylko kod wyniku)
+struct GeoJsonCase
+{
+	CoordinateSystem dst;
+	const char* input;
+	const char* expected;
+	size_t outOfRange;
+};
+
+//=======================================================================
+//  Przeliczenie dokumentu przez pliki tymczasowe (ReprojectGeoJson)
+//=======================================================================
+bool ReprojectText (const CoordinateTransform& ct, const char* input, std::string& output, size_t& outOfRange)
+{
+	FILE* in = tmpfile ();
+	FILE* out = tmpfile ();
+	bool ok = in && out && fputs (input, in) >= 0;
+	if(ok)
+	  {
+	   rewind (in);
+	   ok = ReprojectGeoJson (ct, in, out, -1, &outOfRange);
+	   rewind (out);
+	   char buf[256];
+	   size_t n;
+	   while((n = fread (buf, 1, sizeof (buf), out)) > 0) output.append (buf, n);
+	  }
+	if(in) fclose (in);
+	if(out) fclose (out);
+	return ok;
+}
+
+int main ()
+{
+	static const GeoJsonCase cases[] =
+	  {
+	   { crsWGS84, "{\"type\":\"Point\",\"coordinates\":[1e300,0]}", "{\"type\":\"Point\",\"coordinates\":[1e+300,0]}", 0 },
+	   { crsWGS84, "{\"type\":\"Point\",\"coordinates\":[-1.7976931348623157e308,52]}", "{\"type\":\"Point\",\"coordinates\":[-1.7976931348623157e+308,52]}", 0 },
+	   { crsWGS84, "{\"type\":\"Point\",\"coordinates\":[1e400,-1e400]}", "{\"type\":\"Point\",\"coordinates\":[null,null]}", 0 },
+	   { crsUTM, "{\"type\":\"Point\",\"coordinates\":[1e400,-1e400]}", "{\"type\":\"Point\",\"coordinates\":[null,null]}", 0 },
+	   { crsUTM, "{\"type\":\"Point\",\"coordinates\":[21,1e300]}", "{\"type\":\"Point\",\"coordinates\":[null,null]}", 0 },
+	   { crsUTM, "{\"type\":\"Point\",\"coordinates\":[1e20,52]}", 0, 0 },
+	   { crsUTM, "{\"type\":\"LineString\",\"coordinates\":[[1e300,0],[-1e308,1e308],[21,52]]}", 0, 0 },
+	   { crsPUWG1992, "{\"type\":\"Point\",\"coordinates\":[1e20,52]}", "{\"type\":\"Point\",\"coordinates\":[999999999999999,999999999999999]}", 1 },
+	   { crsPUWG1992, "{\"type\":\"Point\",\"coordinates\":[21,1e300]}", "{\"type\":\"Point\",\"coordinates\":[null,null]}", 0 },
+	   { crsPUWG2000, "{\"type\":\"MultiPoint\",\"coordinates\":[[1e400,52],[-1e400,52]]}", "{\"type\":\"MultiPoint\",\"coordinates\":[[999999999999999,999999999999999],[999999999999999,999999999999999]]}", 2 }
+	  };
+	static const int caseCount = sizeof (cases) / sizeof (cases[0]);
+	bool failed = false;
+	for(int i = 0; i < caseCount; i++)
+	  {
+	   const GeoJsonCase& c = cases[i];
+	   CoordinateTransform ct = CreateCoordinateTransformWGS84 (MakeCoordinateReference (crsWGS84), MakeCoordinateReference (c.dst, 34, 'N'));
+	   std::string output;
+	   size_t outOfRange = 0;
+	   bool ok = ReprojectText (ct, c.input, output, outOfRange);
+	   if(ok && c.expected) ok = output == c.expected && outOfRange == c.outOfRange;
+	   printf ("%-4s %s -> %s\n", ok ? "ok" : "FAIL", c.input, output.c_str ());
+	   if(!ok) failed = true;
+	  }
+	return failed ? 1 : 0;
+}
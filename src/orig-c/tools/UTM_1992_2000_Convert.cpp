@@ -0,0 +1,583 @@
+/*
+Przeliczanie duych plikw tekstowych (CSV, XYZ) midzy WGS 84, UTM, 1992 i 2000
+
+Plik wejciowy jest odwzorowany w pamici (mmap / MapViewOfFile; potok, FIFO i inne pliki, ktrych nie
+mona odwzorowa, s odczytywane w caoci do bufora) i dzielony na porcje na granicach linii. Porcje
+przeliczane s rwnolegle (ConversionPool, wszystkie rdzenie): liczby x, y z wybranych kolumn
+odczytywane s bez alokacji pamici (ParseJsonNumber), przeliczane funkcjami wsadowymi
+(TransformCoordinatesBatch, bloki po geometryBlockSize punktw) i zapisywane najkrtszym zapisem
+odtwarzajcym liczb (std::to_chars) lub ze sta liczb miejsc po przecinku. Pozostae pola linii
+(wysoko, atrybuty, cudzysowy, koce linii) s przepisywane bez zmian; linie bez liczb w kolumnach
+x, y (nagwek, komentarze, puste) - w caoci. Kolejno linii jest zachowana: przeliczone porcje
+zapisuje osobny wtek, w czasie przeliczania nastpnej rundy porcji.
+
+Wsprzdne x, y to lon, lat (WGS 84) lub easting, northing (Y, X w metrach). Dla UTM strefa jest
+staa dla caego pliku (jak w UTM_1992_2000_Geometry.h), dla 2000 pas rozpoznawany jest dla kadego
+punktu. Liczby z przecinkiem dziesitnym nie s rozpoznawane.
+
+Na kocu program wypisuje (na stderr) liczb linii i punktw oraz przepustowo.
+
+Kompilacja (z katalogu src/orig-c/tools; std::to_chars dla double wymaga C++17, np. GCC 11):
+  g++ -std=c++17 -O2 -pthread UTM_1992_2000_Convert.cpp -o utm_convert
+
+Uycie:
+  utm_convert --from <ukad> --to <ukad> [opcje] wejcie [wyjcie]
+    ukad: wgs84, 1992, 2000, utm<strefa><N|S> (np. utm34N)
+    --columns x,y    numery kolumn x i y (od 1, domylnie 1,2); dla pliku lat, lon: --columns 2,1
+    --delimiter c    separator pl: znak, tab lub space (cig spacji i tabulatorw); domylnie
+                     wykrywany z pierwszej linii danych (rednik, przecinek, tabulator, spacje)
+    --decimals n     staa liczba miejsc po przecinku (0 - 12) zamiast najkrtszego zapisu
+    --threads n      liczba wtkw, 1 - 1024 (domylnie wszystkie rdzenie)
+    --engine e       classic lub kruger (domylnie kruger)
+  Bez pliku wyjciowego lub dla "-" wynik zapisywany jest na standardowe wyjcie.
+*/
+//---------------------------------------------------------------------------
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <charconv>
+#include <chrono>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const double deg2rad = M_PI / 180.0;
+static const double rad2deg = 180.0 / M_PI;
+
+#include "../UTM_1992_2000_Geometry.h"
+#include "../UTM_1992_2000_Parallel.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//Deklaracja staych
+////////////////////////////////////////////////////////////////////////////////
+
+//Rozmiar porcji pliku przeliczanej przez jeden wtek (przesuwany do koca linii)
+static const size_t convertChunkBytes = 1 << 20;
+
+//Liczba porcji rundy na wtek (wyrwnanie obcienia przy porcjach o rnym koszcie)
+static const size_t convertChunksPerThread = 4;
+
+//Ilo tekstu z pocztku pliku, na podstawie ktrej wykrywany jest separator pl
+static const size_t convertDetectBytes = 65536;
+
+//Opcje przeliczenia
+struct ConvertOptions
+{
+	CoordinateReference src;
+	CoordinateReference dst;
+	int xColumn;            // numery kolumn od 0
+	int yColumn;
+	char delimiter;         // 0 - cig spacji i tabulatorw
+	int decimals;           // -1 - najkrtszy zapis odtwarzajcy liczb
+	unsigned threads;
+	ProjectionEngine engine;
+};
+
+//Wynik przeliczenia porcji: tekst wyjciowy i liczniki
+struct ConvertChunk
+{
+	const char* begin;
+	const char* end;
+	std::vector<char> text;
+	size_t lines;
+	size_t points;
+	size_t outOfRange;
+};
+
+//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+//Funkcje pomocnicze
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+
+//=======================================================================
+//  Odczyt ukadu wsprzdnych z argumentu: wgs84, 1992, 2000, utm<strefa><N|S>
+//=======================================================================
+bool ParseCoordinateReference (const char* s, CoordinateReference& ref)
+{
+	if(strcmp (s, "wgs84") == 0) ref = MakeCoordinateReference (crsWGS84);
+	else if(strcmp (s, "1992") == 0) ref = MakeCoordinateReference (crsPUWG1992);
+	else if(strcmp (s, "2000") == 0) ref = MakeCoordinateReference (crsPUWG2000);
+	else if(strncmp (s, "utm", 3) == 0)
+	  {
+	   char* end;
+	   long zone = strtol (s + 3, &end, 10);
+	   if(end == s + 3 || zone < 1 || zone > 60) return false;
+	   char hemisphere = *end;
+	   if(hemisphere == 'n' || hemisphere == 'N') ref = MakeCoordinateReference (crsUTM, (int)zone, 'N');
+	   else if(hemisphere == 's' || hemisphere == 'S') ref = MakeCoordinateReference (crsUTM, (int)zone, 'C');
+	   else return false;
+	   if(end[1]) return false;
+	  }
+	else return false;
+	return true;
+}
+
+//=======================================================================
+//  Separator pl wykryty z pierwszej linii danych (zaczynajcej si od liczby) z pocztku tekstu
+//=======================================================================
+//      rednik, przecinek, tabulator (gdy w linii nie ma spacji) lub cig spacji i tabulatorw (0)
+//=======================================================================
+char DetectDelimiter (const char* text, size_t size)
+{
+	if(size > convertDetectBytes) size = convertDetectBytes;
+	const char* end = text + size;
+	for(const char* p = text; p < end; )
+	  {
+	   const char* eol = (const char*)memchr (p, '\n', end - p);
+	   if(!eol) eol = end;
+	   const char* q = p;
+	   while(q < eol && (*q == ' ' || *q == '\t' || *q == '"')) q++;
+	   if(q < eol && ((*q >= '0' && *q <= '9') || *q == '-' || *q == '+' || *q == '.'))
+	     {
+	      if(memchr (p, ';', eol - p)) return ';';
+	      if(memchr (p, ',', eol - p)) return ',';
+	      if(memchr (p, '\t', eol - p) && !memchr (p, ' ', eol - p)) return '\t';
+	      return 0;
+	     }
+	   p = eol + 1;
+	  }
+	return 0;
+}
+
+//=======================================================================
+//  Pooenie pl x, y w linii [p, end) (bez znaku koca linii)
+//=======================================================================
+//      Wynik: false, gdy linia ma mniej pl ni wymagaj kolumny x, y;
+//      field[0], field[1] - pocztek i koniec pola x, field[2], field[3] - pola y
+//=======================================================================
+bool FindFields (const char* p, const char* end, const ConvertOptions& o, const char** field)
+{
+	int last = o.xColumn > o.yColumn ? o.xColumn : o.yColumn;
+	for(int column = 0; column <= last; column++)
+	  {
+	   const char* b;
+	   if(o.delimiter)
+	     {
+	      b = p;
+	      const char* q = (const char*)memchr (p, o.delimiter, end - p);
+	      p = q ? q : end;
+	     }
+	     else
+	     {
+	      while(p < end && (*p == ' ' || *p == '\t')) p++;
+	      b = p;
+	      while(p < end && *p != ' ' && *p != '\t') p++;
+	     }
+	   if(column == o.xColumn)
+	     {
+	      field[0] = b;
+	      field[1] = p;
+	     }
+	   if(column == o.yColumn)
+	     {
+	      field[2] = b;
+	      field[3] = p;
+	     }
+	   if(p == end && column < last) return false;
+	   if(o.delimiter && p < end) p++;
+	  }
+	return true;
+}
+
+//Odczyt liczby z pola [b, e) (spacje, cudzysowy i znak '\r' wok liczby s pomijane i pozostaj w wyniku)
+inline bool ParseField (const char*& b, const char*& e, double& v)
+{
+	while(b < e && (*b == ' ' || *b == '\t' || *b == '"')) b++;
+	while(e > b && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r' || e[-1] == '"')) e--;
+	const char* s = b < e && *b == '+' ? b + 1 : b;
+	return s < e && ParseJsonNumber (s, e - s, v);
+}
+
+inline void AppendText (std::vector<char>& text, const char* b, const char* e)
+{
+	text.insert (text.end (), b, e);
+}
+
+//Zapis liczby: najkrtszy zapis staoprzecinkowy odtwarzajcy liczb (bardzo mae i bardzo due wartoci
+//w zapisie wykadniczym) lub decimals miejsc po przecinku
+inline void AppendNumber (std::vector<char>& text, double v, int decimals)
+{
+	char buf[64];
+	std::to_chars_result r = decimals < 0 ? std::to_chars (buf, buf + sizeof (buf), v, std::chars_format::fixed)
+	                                      : std::to_chars (buf, buf + sizeof (buf), v, std::chars_format::fixed, decimals);
+	if(r.ec != std::errc ()) r = std::to_chars (buf, buf + sizeof (buf), v);
+	text.insert (text.end (), buf, r.ptr);
+}
+
+//=======================================================================
+//  Przeliczenie porcji tekstu [c.begin, c.end) (pene linie)
+//=======================================================================
+//      Linie z liczbami x, y zbierane s w bloki po geometryBlockSize punktw; tekst midzy
+//      przeliczanymi polami (take linie pominite) przepisywany jest przy zapisie bloku.
+//=======================================================================
+void ConvertText (const ConvertOptions& o, const CoordinateTransform& ct, ConvertChunk& c)
+{
+	double x[geometryBlockSize];
+	double y[geometryBlockSize];
+	unsigned char status[geometryBlockSize];
+	const char* field[geometryBlockSize][4];
+	c.text.clear ();
+	c.text.reserve ((size_t)(c.end - c.begin) + (size_t)(c.end - c.begin) / 4 + 64);
+	c.lines = c.points = c.outOfRange = 0;
+	const char* pending = c.begin;
+	const char* p = c.begin;
+	size_t n = 0;
+	while(p < c.end || n)
+	  {
+	   if(p < c.end)
+	     {
+	      const char* eol = (const char*)memchr (p, '\n', c.end - p);
+	      const char* next = eol ? eol + 1 : c.end;
+	      if(!eol) eol = c.end;
+	      c.lines++;
+	      const char** f = field[n];
+	      if(FindFields (p, eol, o, f) && ParseField (f[0], f[1], x[n]) && ParseField (f[2], f[3], y[n])) n++;
+	      p = next;
+	      if(n < geometryBlockSize && p < c.end) continue;
+	     }
+	   // Przeliczenie bloku i zapis tekstu do koca ostatniego pola bloku
+	   TransformCoordinatesBatch (ct, x, y, n, status);
+	   for(size_t i = 0; i < n; i++)
+	     {
+	      const char** f = field[i];
+	      bool xFirst = f[0] < f[2];
+	      AppendText (c.text, pending, xFirst ? f[0] : f[2]);
+	      AppendNumber (c.text, xFirst ? x[i] : y[i], o.decimals);
+	      AppendText (c.text, xFirst ? f[1] : f[3], xFirst ? f[2] : f[0]);
+	      AppendNumber (c.text, xFirst ? y[i] : x[i], o.decimals);
+	      pending = xFirst ? f[3] : f[1];
+	      if(status[i] != statusOK) c.outOfRange++;
+	     }
+	   c.points += n;
+	   n = 0;
+	  }
+	AppendText (c.text, pending, c.end);
+}
+
+//Odczyt pliku do koca do bufora (malloc); fn (buf, n) zwraca liczb odczytanych bajtw, 0 - koniec, < 0 - bd
+template <class Read>
+bool ReadInput (Read fn, const char*& view, size_t& size)
+{
+	size_t capacity = 0;
+	char* buf = 0;
+	for(;;)
+	  {
+	   if(size == capacity)
+	     {
+	      capacity = capacity ? 2 * capacity : convertChunkBytes;
+	      char* p = (char*)realloc (buf, capacity);
+	      if(!p) break;
+	      buf = p;
+	     }
+	   long n = fn (buf + size, capacity - size);
+	   if(n == 0)
+	     {
+	      view = buf;
+	      return true;
+	     }
+	   if(n < 0) break;
+	   size += (size_t)n;
+	  }
+	free (buf);
+	size = 0;
+	return false;
+}
+
+//Odwzorowanie pliku w pamici tylko do odczytu (false, gdy pliku nie mona otworzy lub odczyta; pusty plik - view = 0);
+//plik inny ni zwyky (potok, FIFO, urzdzenie) odczytywany do bufora (mapped = false)
+bool MapInput (const char* path, const char*& view, size_t& size, bool& mapped)
+{
+	view = 0;
+	size = 0;
+	mapped = true;
+#ifdef _WIN32
+	HANDLE file = CreateFileA (path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	if(file == INVALID_HANDLE_VALUE) return false;
+	if(GetFileType (file) != FILE_TYPE_DISK)
+	  {
+	   mapped = false;
+	   bool ok = ReadInput ([file] (char* buf, size_t n) -> long
+	     {
+	      DWORD got = 0;
+	      if(n > (1u << 30)) n = 1u << 30;
+	      if(ReadFile (file, buf, (DWORD)n, &got, 0)) return (long)got;
+	      return GetLastError () == ERROR_BROKEN_PIPE ? 0 : -1;
+	     }, view, size);
+	   CloseHandle (file);
+	   return ok;
+	  }
+	LARGE_INTEGER length;
+	bool ok = GetFileSizeEx (file, &length) != 0;
+	if(ok && length.QuadPart > 0)
+	  {
+	   HANDLE mapping = CreateFileMappingA (file, 0, PAGE_READONLY, 0, 0, 0);
+	   if(mapping)
+	     {
+	      view = (const char*)MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+	      size = (size_t)length.QuadPart;
+	      CloseHandle (mapping);
+	     }
+	   ok = view != 0;
+	  }
+	CloseHandle (file);
+	return ok;
+#else
+	int file = open (path, O_RDONLY);
+	if(file < 0) return false;
+	struct stat st;
+	bool ok = fstat (file, &st) == 0;
+	if(ok && !S_ISREG (st.st_mode))
+	  {
+	   mapped = false;
+	   ok = ReadInput ([file] (char* buf, size_t n) -> long
+	     {
+	      ssize_t got;
+	      do got = read (file, buf, n); while(got < 0 && errno == EINTR);
+	      return (long)got;
+	     }, view, size);
+	  }
+	else if(ok && st.st_size > 0)
+	  {
+	   void* p = mmap (0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	   if(p != MAP_FAILED)
+	     {
+	      // Odczyt sekwencyjny: jdro czyta z wyprzedzeniem i zwalnia przeczytane strony
+	      madvise (p, (size_t)st.st_size, MADV_SEQUENTIAL);
+	      view = (const char*)p;
+	      size = (size_t)st.st_size;
+	     }
+	   ok = view != 0;
+	  }
+	close (file);
+	return ok;
+#endif
+}
+
+void UnmapInput (const char* view, size_t size, bool mapped)
+{
+	if(!view) return;
+	if(!mapped)
+	  {
+	   free ((void*)view);
+	   return;
+	  }
+#ifdef _WIN32
+	UnmapViewOfFile (view);
+#else
+	munmap ((void*)view, size);
+#endif
+}
+
+void Usage ()
+{
+	fprintf (stderr, "usage: utm_convert --from <crs> --to <crs> [--columns x,y] [--delimiter c|tab|space]\n"
+	                 "                   [--decimals n] [--threads n] [--engine classic|kruger] input [output]\n"
+	                 "  crs: wgs84, 1992, 2000, utm<zone><N|S> (e.g. utm34N); wgs84 columns are lon, lat\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Funkcje zasadnicze
+////////////////////////////////////////////////////////////////////////////////
+
+int main (int argc, char** argv)
+{
+	ConvertOptions o;
+	o.xColumn = 0;
+	o.yColumn = 1;
+	o.delimiter = 0;
+	o.decimals = -1;
+	o.threads = 0;
+	o.engine = engineKruger;
+	bool haveSrc = false, haveDst = false, detect = true;
+	const char* inPath = 0;
+	const char* outPath = 0;
+	for(int i = 1; i < argc; i++)
+	  {
+	   const char* a = argv[i];
+	   const char* v = i + 1 < argc ? argv[i + 1] : 0;
+	   bool option = a[0] == '-' && a[1] == '-';
+	   if(option && !v)
+	     {
+	      Usage ();
+	      return 2;
+	     }
+	   if(strcmp (a, "--from") == 0) haveSrc = ParseCoordinateReference (v, o.src);
+	   else if(strcmp (a, "--to") == 0) haveDst = ParseCoordinateReference (v, o.dst);
+	   else if(strcmp (a, "--columns") == 0)
+	     {
+	      if(sscanf (v, "%d,%d", &o.xColumn, &o.yColumn) != 2 || o.xColumn < 1 || o.yColumn < 1 || o.xColumn == o.yColumn)
+	        {
+	         Usage ();
+	         return 2;
+	        }
+	      o.xColumn--;
+	      o.yColumn--;
+	     }
+	   else if(strcmp (a, "--delimiter") == 0)
+	     {
+	      detect = false;
+	      if(strcmp (v, "tab") == 0) o.delimiter = '\t';
+	      else if(strcmp (v, "space") == 0) o.delimiter = 0;
+	      else if(strlen (v) == 1 && v[0] != '\n' && v[0] != '"') o.delimiter = v[0];
+	      else
+	        {
+	         Usage ();
+	         return 2;
+	        }
+	     }
+	   else if(strcmp (a, "--decimals") == 0)
+	     {
+	      o.decimals = atoi (v);
+	      if(o.decimals < 0) o.decimals = 0;
+	      if(o.decimals > 12) o.decimals = 12;
+	     }
+	   else if(strcmp (a, "--threads") == 0)
+	     {
+	      char* end;
+	      long threads = strtol (v, &end, 10);
+	      if(end == v || *end || threads < 1 || threads > 1024)
+	        {
+	         Usage ();
+	         return 2;
+	        }
+	      o.threads = (unsigned)threads;
+	     }
+	   else if(strcmp (a, "--engine") == 0)
+	     {
+	      if(strcmp (v, "classic") == 0) o.engine = engineClassic;
+	      else if(strcmp (v, "kruger") == 0) o.engine = engineKruger;
+	      else
+	        {
+	         Usage ();
+	         return 2;
+	        }
+	     }
+	   else if(option)
+	     {
+	      Usage ();
+	      return 2;
+	     }
+	   else
+	     {
+	      if(!inPath) inPath = a;
+	      else if(!outPath) outPath = a;
+	      else
+	        {
+	         Usage ();
+	         return 2;
+	        }
+	      continue;
+	     }
+	   i++;
+	  }
+	if(!haveSrc || !haveDst || !inPath)
+	  {
+	   Usage ();
+	   return 2;
+	  }
+	const char* view;
+	size_t size;
+	bool mapped;
+	if(!MapInput (inPath, view, size, mapped))
+	  {
+	   fprintf (stderr, "utm_convert: cannot read %s\n", inPath);
+	   return 1;
+	  }
+	FILE* out = stdout;
+	if(outPath && strcmp (outPath, "-") != 0)
+	  {
+	   out = fopen (outPath, "wb");
+	   if(!out)
+	     {
+	      fprintf (stderr, "utm_convert: cannot create %s\n", outPath);
+	      UnmapInput (view, size, mapped);
+	      return 1;
+	     }
+	  }
+#ifdef _WIN32
+	else _setmode (_fileno (stdout), _O_BINARY);
+#endif
+	if(detect && view) o.delimiter = DetectDelimiter (view, size);
+	CoordinateTransform ct = CreateCoordinateTransformWGS84 (o.src, o.dst, o.engine);
+	ConversionPool pool (o.threads);
+	size_t chunks = pool.Threads () * convertChunksPerThread;
+
+	// Runda: porcje przeliczane w puli do jednego z dwch zestaww buforw, zapisywane przez wtek
+	// zapisu w czasie przeliczania nastpnej rundy do drugiego zestawu
+	std::vector<ConvertChunk> round[2];
+	round[0].resize (chunks);
+	round[1].resize (chunks);
+	size_t used[2] = { 0, 0 };
+	std::thread writer;
+	bool writeError = false;
+	size_t lines = 0, points = 0, outOfRange = 0, written = 0;
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now ();
+	size_t pos = 0;
+	int set = 0;
+	while(pos < size)
+	  {
+	   std::vector<ConvertChunk>& r = round[set];
+	   size_t k = 0;
+	   for(; k < chunks && pos < size; k++)
+	     {
+	      size_t end = size - pos > convertChunkBytes ? pos + convertChunkBytes : size;
+	      if(end < size)
+	        {
+	         const char* eol = (const char*)memchr (view + end, '\n', size - end);
+	         end = eol ? (size_t)(eol - view) + 1 : size;
+	        }
+	      r[k].begin = view + pos;
+	      r[k].end = view + end;
+	      pos = end;
+	     }
+	   used[set] = k;
+	   pool.Run (k, 1, [&] (size_t begin, size_t end)
+	     {
+	      for(size_t i = begin; i < end; i++) ConvertText (o, ct, r[i]);
+	     });
+	   for(size_t i = 0; i < k; i++)
+	     {
+	      lines += r[i].lines;
+	      points += r[i].points;
+	      outOfRange += r[i].outOfRange;
+	      written += r[i].text.size ();
+	     }
+	   if(writer.joinable ()) writer.join ();
+	   if(writeError) break;
+	   writer = std::thread ([&, set] ()
+	     {
+	      for(size_t i = 0; i < used[set] && !writeError; i++)
+	        {
+	         const std::vector<char>& t = round[set][i].text;
+	         if(!t.empty () && fwrite (&t[0], 1, t.size (), out) != t.size ()) writeError = true;
+	        }
+	     });
+	   set ^= 1;
+	  }
+	if(writer.joinable ()) writer.join ();
+	if(fflush (out) != 0) writeError = true;
+	double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - t0).count ();
+	if(out != stdout && fclose (out) != 0) writeError = true;
+	UnmapInput (view, size, mapped);
+	if(writeError)
+	  {
+	   fprintf (stderr, "utm_convert: write error\n");
+	   return 1;
+	  }
+	if(seconds <= 0.0) seconds = 1e-9;
+	fprintf (stderr, "lines: %lu, points: %lu, skipped lines: %lu, out of range: %lu, threads: %u\n",
+	         (unsigned long)lines, (unsigned long)points, (unsigned long)(lines - points), (unsigned long)outOfRange, pool.Threads ());
+	fprintf (stderr, "time: %.3f s, input: %.1f MB/s, output: %.1f MB/s, %.2f Mpts/s\n",
+	         seconds, size / seconds / 1e6, written / seconds / 1e6, points / seconds / 1e6);
+	return 0;
+}